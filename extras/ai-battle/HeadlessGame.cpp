@@ -7,13 +7,16 @@
 #include "GlobalGameSettings.h"
 #include "PlayerInfo.h"
 #include "Savegame.h"
+#include "StatisticsHistory.h"
 #include "factories/AIFactory.h"
 #include "network/PlayerGameCommands.h"
 #include "world/GameWorld.h"
 #include "world/MapLoader.h"
 #include "gameTypes/MapInfo.h"
 #include "gameData/GameConsts.h"
+#include <boost/nowide/fstream.hpp>
 #include <boost/nowide/iostream.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <sstream>
@@ -111,6 +114,7 @@ void HeadlessGame::Run(unsigned maxGF)
         }
     }
     PrintState();
+    PrintPhaseTimings();
 }
 
 void HeadlessGame::Close()
@@ -124,6 +128,8 @@ void HeadlessGame::Close()
     }
 
     replay_.Close();
+    // Write the remaining statistics
+    game_.SetStatisticsRecorder(nullptr);
 }
 
 void HeadlessGame::RecordReplay(const bfs::path& path, unsigned random_init)
@@ -162,6 +168,24 @@ void HeadlessGame::SaveGame(const bfs::path& path) const
     bnw::cout << "Savegame written to " << canonical(path) << '\n';
 }
 
+void HeadlessGame::RecordStatistics(const bfs::path& path, unsigned interval)
+{
+    std::vector<std::string> playerNames;
+    for(unsigned playerId = 0; playerId < world_.GetNumPlayers(); ++playerId)
+        playerNames.push_back(world_.GetPlayer(playerId).name);
+    game_.SetStatisticsRecorder(std::make_unique<StatisticsRecorder>(path, playerNames, interval));
+}
+
+void HeadlessGame::ExportStatistics(const bfs::path& path, const bfs::path& csvPath)
+{
+    const StatisticsReader reader(path);
+    bnw::ofstream file(csvPath);
+    if(!file)
+        throw std::runtime_error("Could not open " + csvPath.string());
+    reader.exportCsv(file);
+    bnw::cout << "Statistics exported to " << canonical(csvPath) << '\n';
+}
+
 std::string ToString(const std::chrono::milliseconds& time)
 {
     char buffer[90];
@@ -216,6 +240,19 @@ void HeadlessGame::PrintState()
     lastReportGf_ = em_.GetCurrentGF();
 }
 
+void HeadlessGame::PrintPhaseTimings()
+{
+    const Game::PhaseTimings& timings = game_.GetPhaseTimings();
+    const auto toMs = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(time).count();
+    };
+    const unsigned numGFs = std::max(1u, em_.GetCurrentGF());
+    printConsole("Per-player phases:\n");
+    printConsole("  Player update: %10.1f ms (%.2f us/GF)\n", toMs(timings.playerUpdate),
+                 toMs(timings.playerUpdate) * 1000 / numGFs);
+    printConsole("  Statistics:    %10.1f ms (%u threads)\n", toMs(timings.statistics), game_.GetNumWorkerThreads());
+}
+
 std::vector<PlayerInfo> GeneratePlayerInfo(const std::vector<AI::Info>& ais)
 {
     std::vector<PlayerInfo> ret;
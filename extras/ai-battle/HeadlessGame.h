@@ -26,12 +26,18 @@ public:
 
     void Run(unsigned maxGF = std::numeric_limits<unsigned>::max());
     void Close();
+    void SetNumWorkerThreads(unsigned numThreads) { game_.SetNumWorkerThreads(numThreads); }
 
     void RecordReplay(const boost::filesystem::path& path, unsigned random_init);
     void SaveGame(const boost::filesystem::path& path) const;
+    void RecordStatistics(const boost::filesystem::path& path, unsigned interval);
+    /// Write the statistics recorded to the file as CSV
+    static void ExportStatistics(const boost::filesystem::path& path, const boost::filesystem::path& csvPath);
 
 private:
     void PrintState();
+    /// Print the time spent in the per-player phases of the GFs
+    void PrintPhaseTimings();
 
     boost::filesystem::path map_;
     Game game_;
@@ -29,6 +29,8 @@ int main(int argc, char** argv)
 
     boost::optional<std::string> replay_path;
     boost::optional<std::string> savegame_path;
+    boost::optional<std::string> stats_path;
+    boost::optional<std::string> stats_csv_path;
     unsigned random_init = static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 
     po::options_description desc("Allowed options");
@@ -42,6 +44,10 @@ int main(int argc, char** argv)
         ("save", po::value(&savegame_path),"Filename to write savegame to (optional)")
         ("random_init", po::value(&random_init),"Seed value for the random number generator (optional)")
         ("maxGF", po::value<unsigned>()->default_value(std::numeric_limits<unsigned>::max()),"Maximum number of game frames to run (optional)")
+        ("threads", po::value<unsigned>()->default_value(0),"Threads for the player statistics, 0 = one per CPU (optional)")
+        ("stats", po::value(&stats_path),"Filename to record the statistics of all players to (optional)")
+        ("statsInterval", po::value<unsigned>()->default_value(100),"Number of GFs between recorded statistics (optional)")
+        ("statsCsv", po::value(&stats_csv_path),"Filename to export the recorded statistics as CSV to (optional)")
         ("version", "Show version information and exit")
         ;
     // clang-format on
@@ -107,13 +113,18 @@ int main(int argc, char** argv)
 
         ggs.objective = GameObjective::TotalDomination;
         HeadlessGame game(ggs, mapPath, ais);
+        game.SetNumWorkerThreads(options["threads"].as<unsigned>());
         if(replay_path)
             game.RecordReplay(*replay_path, random_init);
+        if(stats_path)
+            game.RecordStatistics(*stats_path, options["statsInterval"].as<unsigned>());
 
         game.Run(options["maxGF"].as<unsigned>());
         game.Close();
         if(savegame_path)
             game.SaveGame(*savegame_path);
+        if(stats_path && stats_csv_path)
+            game.ExportStatistics(*stats_path, *stats_csv_path);
     } catch(const std::exception& e)
     {
         bnw::cerr << e.what() << std::endl;
@@ -0,0 +1,361 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BasePlayerInfo.h"
+#include "GameCommand.h"
+#include "GameDataIndex.h"
+#include "RTTR_Version.h"
+#include "Replay.h"
+#include "Savegame.h"
+#include "enum_cast.hpp"
+#include "helpers/EnumArray.h"
+#include "helpers/EnumRange.h"
+#include "variant.h"
+#include "gameTypes/MapInfo.h"
+#include "gameData/GoodConsts.h"
+#include "gameData/JobConsts.h"
+#include "s25util/System.h"
+
+#include <boost/nowide/args.hpp>
+#include <boost/nowide/filesystem.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bnw = boost::nowide;
+namespace po = boost::program_options;
+
+namespace {
+// Insert new values at the end, matching the enums
+constexpr std::array<const char*, helpers::NumEnumValues_v<GO_Type>> objectTypeNames = {
+  "",
+  "Nothing",
+  "NobHq",
+  "NobMilitary",
+  "NobStorehouse",
+  "NobUsual",
+  "NobShipyard",
+  "NobHarborbuilding",
+  "Buildingsite",
+  "NofAggressivedefender",
+  "NofAttacker",
+  "NofDefender",
+  "NofPassivesoldier",
+  "NofWellguy",
+  "NofCarrier",
+  "NofWoodcutter",
+  "NofFisher",
+  "NofForester",
+  "NofCarpenter",
+  "NofStonemason",
+  "NofHunter",
+  "NofFarmer",
+  "NofMiller",
+  "NofBaker",
+  "NofButcher",
+  "NofMiner",
+  "NofBrewer",
+  "NofPigbreeder",
+  "NofDonkeybreeder",
+  "NofIronfounder",
+  "NofMinter",
+  "NofMetalworker",
+  "NofArmorer",
+  "NofBuilder",
+  "NofPlaner",
+  "NofGeologist",
+  "NofShipwright",
+  "NofScoutFree",
+  "NofScoutLookouttower",
+  "NofWarehouseworker",
+  "NofCatapultman",
+  "NofPassiveworker",
+  "NofCharburner",
+  "Extension",
+  "Envobject",
+  "Fire",
+  "Flag",
+  "Grainfield",
+  "Granite",
+  "Sign",
+  "Skeleton",
+  "Staticobject",
+  "Disappearingmapenvobject",
+  "Tree",
+  "Animal",
+  "Fighting",
+  "Roadsegment",
+  "Ware",
+  "Catapultstone",
+  "Burnedwarehouse",
+  "Shipbuildingsite",
+  "Ship",
+  "Charburnerpile",
+  "NofTradeleader",
+  "NofTradedonkey",
+  "Economymodehandler",
+  "NofWinegrower",
+  "NofVintner",
+  "NofTempleservant",
+  "Grapefield",
+  "NobTemple",
+};
+static_assert(objectTypeNames.back() != nullptr, "Missing object type name");
+
+constexpr std::array<const char*, helpers::NumEnumValues_v<gc::GCType>> commandNames = {
+  "SetFlag",
+  "DestroyFlag",
+  "BuildRoad",
+  "DestroyRoad",
+  "ChangeDistribution",
+  "ChangeBuildOrder",
+  "SetBuildingsite",
+  "DestroyBuilding",
+  "ChangeTransport",
+  "ChangeMilitary",
+  "ChangeTools",
+  "CallSpecialist",
+  "CallScout",
+  "Attack",
+  "SetCoinsAllowed",
+  "SetProductionEnabled",
+  "SetInventorySetting",
+  "SetAllInventorySettings",
+  "ChangeReserve",
+  "SuggestPact",
+  "AcceptPact",
+  "CancelPact",
+  "SetShipyardMode",
+  "StartStopExpedition",
+  "ExpeditionCommand",
+  "SeaAttack",
+  "StartStopExplorationExpedition",
+  "Trade",
+  "Surrender",
+  "CheatArmageddon",
+  "DestroyAll",
+  "UpgradeRoad",
+  "SetTroopLimit",
+  "NotifyAlliesOfLocation",
+  "SetTempleProductionMode",
+};
+static_assert(commandNames.back() != nullptr, "Missing command name");
+
+const char* getName(const GO_Type type)
+{
+    return objectTypeNames[rttr::enum_cast(type)];
+}
+
+const char* getName(const gc::GCType type)
+{
+    return commandNames[rttr::enum_cast(type)];
+}
+
+void printHeader(SavedFile& file)
+{
+    bnw::cout << "Map: " << file.GetMapName() << std::endl;
+    for(unsigned i = 0; i < file.GetNumPlayers(); i++)
+    {
+        const BasePlayerInfo& player = file.GetPlayer(i);
+        if(player.isUsed())
+            bnw::cout << "Player " << i << ": " << player.name << std::endl;
+    }
+}
+
+void printSections(const GameDataIndex& index)
+{
+    bnw::cout << std::endl << "Sections (offset, size in bytes):" << std::endl;
+    for(const GameDataIndex::Section& section : index.sections)
+    {
+        std::string name = GameDataIndex::getName(section.type);
+        if(section.type == GameDataIndex::SectionType::Player)
+            name += " " + std::to_string(section.player);
+        bnw::cout << std::setw(14) << std::left << name << std::right << std::setw(12) << section.offset
+                  << std::setw(12) << section.size << std::endl;
+    }
+
+    // Largest types first
+    std::vector<GO_Type> types;
+    for(const auto type : helpers::enumRange<GO_Type>())
+    {
+        if(index.objects[type].count > 0)
+            types.push_back(type);
+    }
+    std::sort(types.begin(), types.end(),
+              [&index](GO_Type lhs, GO_Type rhs) { return index.objects[lhs].size > index.objects[rhs].size; });
+    bnw::cout << std::endl << "Objects (count, size in bytes):" << std::endl;
+    for(const GO_Type type : types)
+    {
+        bnw::cout << std::setw(26) << std::left << getName(type) << std::right << std::setw(10)
+                  << index.objects[type].count << std::setw(12) << index.objects[type].size << std::endl;
+    }
+}
+
+void printInventory(const GameDataIndex& index, const unsigned player)
+{
+    if(player >= index.inventories.size())
+        throw std::runtime_error("Invalid player " + std::to_string(player));
+    const Inventory& inventory = index.inventories[player];
+    bnw::cout << std::endl << "Inventory of player " << player << ":" << std::endl;
+    for(const auto good : helpers::enumRange<GoodType>())
+    {
+        if(inventory[good])
+            bnw::cout << std::setw(20) << std::left << WARE_NAMES[good] << std::right << inventory[good] << std::endl;
+    }
+    for(const auto job : helpers::enumRange<Job>())
+    {
+        if(inventory[job])
+            bnw::cout << std::setw(20) << std::left << JOB_NAMES[job] << std::right << inventory[job] << std::endl;
+    }
+}
+
+void printEvents(const GameDataIndex& index)
+{
+    bnw::cout << std::endl << "Events (target GF, start GF, id, object):" << std::endl;
+    for(const GameDataIndex::Event& event : index.events)
+    {
+        bnw::cout << std::setw(10) << event.GetTargetGF() << std::setw(10) << event.startGF << std::setw(6) << event.id
+                  << "  " << getName(event.objType) << " #" << event.objId << std::endl;
+    }
+}
+
+int inspectSavegame(const std::string& path, const po::variables_map& options)
+{
+    Savegame save;
+    // The game data itself is never read, only the index stored in front of it
+    if(!save.Load(path, SaveGameDataToLoad::HeaderSettingsAndIndex))
+    {
+        bnw::cerr << "Could not load savegame: " << save.GetLastErrorMsg() << std::endl;
+        return 1;
+    }
+    printHeader(save);
+    bnw::cout << "GF: " << save.start_gf << std::endl;
+    const GameDataIndex& index = save.sgd.GetIndex();
+    if(index.empty())
+    {
+        bnw::cerr << "The savegame has no index, it was saved by an older version" << std::endl;
+        return 1;
+    }
+    if(options.count("player"))
+        printInventory(index, options["player"].as<unsigned>());
+    else if(options.count("events"))
+        printEvents(index);
+    else
+        printSections(index);
+    return 0;
+}
+
+int inspectReplay(const std::string& path, const boost::optional<std::string>& commandFilter)
+{
+    Replay replay;
+    MapInfo mapInfo;
+    // Skip the game data of savegames, the commands are read one by one
+    if(!replay.LoadHeader(path) || !replay.LoadGameData(mapInfo, SaveGameDataToLoad::HeaderSettingsAndIndex))
+    {
+        bnw::cerr << "Could not load replay: " << replay.GetLastErrorMsg() << std::endl;
+        return 1;
+    }
+    printHeader(replay);
+    bnw::cout << "Last GF: " << replay.GetLastGF() << std::endl << std::endl;
+
+    const auto matches = [&commandFilter](const char* name) { return commandFilter && *commandFilter == name; };
+    unsigned numChatCommands = 0;
+    helpers::EnumArray<unsigned, gc::GCType> numCommands{};
+    while(const auto gf = replay.ReadGF())
+    {
+        visit(composeVisitor(
+                [&](const Replay::ChatCommand& cmd) {
+                    numChatCommands++;
+                    if(matches("Chat"))
+                        bnw::cout << *gf << ": Player " << unsigned(cmd.player) << ": " << cmd.msg << std::endl;
+                },
+                [&](const Replay::GameCommand& cmd) {
+                    for(const gc::GameCommandPtr& gc : cmd.cmds.gcs)
+                    {
+                        numCommands[gc->GetType()]++;
+                        if(matches(getName(gc->GetType())))
+                            bnw::cout << *gf << ": Player " << unsigned(cmd.player) << std::endl;
+                    }
+                }),
+              replay.ReadCommand());
+    }
+    if(commandFilter)
+        return 0;
+    bnw::cout << std::setw(32) << std::left << "Chat" << std::right << numChatCommands << std::endl;
+    for(const auto type : helpers::enumRange<gc::GCType>())
+    {
+        if(numCommands[type])
+            bnw::cout << std::setw(32) << std::left << getName(type) << std::right << numCommands[type] << std::endl;
+    }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bnw::nowide_filesystem();
+    bnw::args _(argc, argv);
+
+    boost::optional<std::string> savegame_path;
+    boost::optional<std::string> replay_path;
+    boost::optional<std::string> command;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show help")
+        ("savegame,s", po::value(&savegame_path),"Savegame to inspect. Lists the sections and objects by default")
+        ("player,p", po::value<unsigned>(),"Show the inventory of the player in the savegame")
+        ("events,e", "Show the event queue of the savegame")
+        ("replay,r", po::value(&replay_path),"Replay to inspect. Counts the commands by type by default")
+        ("command,c", po::value(&command),"Show all commands of this type (e.g. Attack, Chat) in the replay")
+        ("version", "Show version information and exit")
+        ;
+    // clang-format on
+
+    po::variables_map options;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(desc).run(), options);
+
+        if(options.count("help") || argc == 1)
+        {
+            bnw::cout << desc << std::endl;
+            return 0;
+        }
+        if(options.count("version"))
+        {
+            bnw::cout << rttr::version::GetTitle() << " v" << rttr::version::GetVersion() << "-"
+                      << rttr::version::GetRevision() << std::endl
+                      << "Compiled with " << System::getCompilerName() << " for " << System::getOSName() << std::endl;
+            return 0;
+        }
+
+        po::notify(options);
+        if(!savegame_path == !replay_path)
+            throw std::runtime_error("Exactly one of --savegame and --replay is required");
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << std::endl;
+        bnw::cerr << desc << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        if(savegame_path)
+            return inspectSavegame(*savegame_path, options);
+        return inspectReplay(*replay_path, command);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
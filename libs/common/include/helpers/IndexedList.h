@@ -0,0 +1,71 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <unordered_map>
+
+namespace helpers {
+
+/// List of unique pointers in insertion order with constant time lookup and removal of an element.
+/// Can be used instead of a std::list of pointers where elements are often removed or searched by value.
+/// Iteration is in insertion order (as for the list), so it is deterministic and stays compatible with serialization.
+template<typename T>
+class IndexedList
+{
+    static_assert(std::is_pointer_v<T>, "Only pointers are supported");
+    using List = std::list<T>;
+    using Key = std::add_pointer_t<std::add_const_t<std::remove_pointer_t<T>>>;
+
+public:
+    using value_type = T;
+    /// Elements can't be changed via the iterators as that would invalidate the index
+    using iterator = typename List::const_iterator;
+    using const_iterator = typename List::const_iterator;
+
+    iterator begin() const { return elements_.begin(); }
+    iterator end() const { return elements_.end(); }
+    size_t size() const { return elements_.size(); }
+    bool empty() const { return elements_.empty(); }
+    const T& front() const { return elements_.front(); }
+
+    void clear()
+    {
+        elements_.clear();
+        index_.clear();
+    }
+    /// Add an element which must not be in the list yet
+    void push_back(const T& value)
+    {
+        RTTR_Assert(!contains(value));
+        elements_.push_back(value);
+        index_.emplace(value, std::prev(elements_.end()));
+    }
+    /// Remove the element at the iterator and return the iterator to the next element
+    iterator erase(iterator it)
+    {
+        index_.erase(*it);
+        return elements_.erase(it);
+    }
+    /// Remove the element if it is contained
+    void remove(Key value)
+    {
+        const auto it = index_.find(value);
+        if(it == index_.end())
+            return;
+        elements_.erase(it->second);
+        index_.erase(it);
+    }
+    bool contains(Key value) const { return index_.find(value) != index_.end(); }
+
+private:
+    List elements_;
+    std::unordered_map<Key, typename List::iterator> index_;
+};
+
+} // namespace helpers
@@ -6,16 +6,21 @@
 #include "EventManager.h"
 #include "FileChecksum.h"
 #include "Game.h"
+#include "GameCommand.h"
 #include "GameObject.h"
 #include "random/Random.h"
+#include "world/WorldStateHash.h"
 #include "s25util/Serializer.h"
 #include <ostream>
 
-AsyncChecksum::AsyncChecksum() : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0) {}
+AsyncChecksum::AsyncChecksum()
+    : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0), hasStateHashes(false), stateHashes()
+{}
 
 AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt,
                              unsigned evInstanceCt)
-    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt)
+    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt),
+      hasStateHashes(false), stateHashes()
 {}
 
 void AsyncChecksum::Serialize(Serializer& ser) const
@@ -25,15 +30,28 @@ void AsyncChecksum::Serialize(Serializer& ser) const
     ser.PushUnsignedInt(objIdCt);
     ser.PushUnsignedInt(eventCt);
     ser.PushUnsignedInt(evInstanceCt);
+    ser.PushBool(hasStateHashes);
+    if(hasStateHashes)
+    {
+        for(const unsigned hash : stateHashes)
+            ser.PushUnsignedInt(hash);
+    }
 }
 
-void AsyncChecksum::Deserialize(Serializer& ser)
+void AsyncChecksum::Deserialize(gc::Deserializer& ser)
 {
     randChecksum = ser.PopUnsignedInt();
     objCt = ser.PopUnsignedInt();
     objIdCt = ser.PopUnsignedInt();
     eventCt = ser.PopUnsignedInt();
     evInstanceCt = ser.PopUnsignedInt();
+    hasStateHashes = ser.getDataVersion() >= 2 && ser.PopBool();
+    stateHashes.fill(0);
+    if(hasStateHashes)
+    {
+        for(unsigned& hash : stateHashes)
+            hash = ser.PopUnsignedInt();
+    }
 }
 
 unsigned AsyncChecksum::getHash() const
@@ -43,14 +61,47 @@ unsigned AsyncChecksum::getHash() const
     return CalcChecksumOfBuffer(ser.GetData(), ser.GetLength());
 }
 
+std::string AsyncChecksum::getDifferingStateParts(const AsyncChecksum& rhs) const
+{
+    std::string result;
+    if(!hasStateHashes || !rhs.hasStateHashes)
+        return result;
+    for(unsigned i = 0; i < stateHashes.size(); i++)
+    {
+        if(stateHashes[i] == rhs.stateHashes[i])
+            continue;
+        if(!result.empty())
+            result += ", ";
+        result += WorldStateHash::getName(static_cast<WorldStateHash::Part>(i));
+    }
+    return result;
+}
+
 AsyncChecksum AsyncChecksum::create(const Game& game)
 {
-    return AsyncChecksum(RANDOM.GetChecksum(), GameObject::GetNumObjs(), GameObject::GetObjIDCounter(),
+    AsyncChecksum result(RANDOM.GetChecksum(), GameObject::GetNumObjs(), GameObject::GetObjIDCounter(),
                          game.em_->GetNumActiveEvents(), game.em_->GetEventInstanceCtr());
+    const WorldStateHash& stateHash = game.world_.GetStateHash();
+    result.hasStateHashes = true;
+    for(unsigned i = 0; i < result.stateHashes.size(); i++)
+    {
+        const uint64_t hash = stateHash.get(static_cast<WorldStateHash::Part>(i));
+        result.stateHashes[i] = static_cast<unsigned>(hash ^ (hash >> 32));
+    }
+    return result;
 }
 
 std::ostream& operator<<(std::ostream& os, const AsyncChecksum& checksum)
 {
-    return os << "RandCS = " << checksum.randChecksum << ",\tobjects/ID = " << checksum.objCt << "/" << checksum.objIdCt
-              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt;
+    os << "RandCS = " << checksum.randChecksum << ",\tobjects/ID = " << checksum.objCt << "/" << checksum.objIdCt
+       << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt;
+    if(checksum.hasStateHashes)
+    {
+        for(unsigned i = 0; i < checksum.stateHashes.size(); i++)
+        {
+            os << ",\t" << WorldStateHash::getName(static_cast<WorldStateHash::Part>(i)) << " = "
+               << checksum.stateHashes[i];
+        }
+    }
+    return os;
 }
@@ -4,10 +4,16 @@
 
 #pragma once
 
+#include "world/WorldStateHash.h"
+#include <array>
 #include <iosfwd>
+#include <string>
 
 class Game;
 class Serializer;
+namespace gc {
+struct Deserializer;
+}
 
 /// Checksum of the game before the game commands of any player is executed
 struct AsyncChecksum
@@ -15,12 +21,18 @@ struct AsyncChecksum
     unsigned randChecksum;
     unsigned objCt, objIdCt;
     unsigned eventCt, evInstanceCt;
+    /// Hashes of the parts of the world state (see WorldStateHash) folded to 32 bits.
+    /// Not available in replays recorded before they were added
+    bool hasStateHashes;
+    std::array<unsigned, WorldStateHash::NUM_PARTS> stateHashes;
     AsyncChecksum();
     AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt);
     void Serialize(Serializer& ser) const;
-    void Deserialize(Serializer& ser);
+    void Deserialize(gc::Deserializer& ser);
     /// Get a hash for this checksum
     unsigned getHash() const;
+    /// Return the names of the parts of the world state which differ, empty if unknown or all are equal
+    std::string getDifferingStateParts(const AsyncChecksum& rhs) const;
 
     static AsyncChecksum create(const Game& game);
 
@@ -31,7 +43,8 @@ struct AsyncChecksum
 inline bool AsyncChecksum::operator==(const AsyncChecksum& rhs) const
 {
     return randChecksum == rhs.randChecksum && objCt == rhs.objCt && objIdCt == rhs.objIdCt && eventCt == rhs.eventCt
-           && evInstanceCt == rhs.evInstanceCt;
+           && evInstanceCt == rhs.evInstanceCt
+           && (!hasStateHashes || !rhs.hasStateHashes || stateHashes == rhs.stateHashes);
 }
 
 inline bool AsyncChecksum::operator!=(const AsyncChecksum& rhs) const
@@ -52,6 +52,8 @@ public:
     bool ObjectHasEvents(const GameObject& obj);
     /// Return true if the object will be destroyed after the current GF
     bool IsObjectInKillList(const GameObject& obj);
+    /// Get all events in the order they will be processed
+    std::vector<const GameEvent*> GetEvents() const;
 
 protected:
     // Use list to allow removing of events while iterating (Event A can cause Event B in the same GF to be removed)
@@ -75,6 +77,4 @@ protected:
     void ExecuteEvents(const EventMap::iterator& itEvents);
     /// Destroy all objects in the kill list
     void DestroyCurrentObjects();
-    /// Get all events in the order they will be processed
-    std::vector<const GameEvent*> GetEvents() const;
 };
@@ -7,7 +7,10 @@
 #include "EventManager.h"
 #include "GameInterface.h"
 #include "GamePlayer.h"
+#include "StatisticsHistory.h"
+#include "WorkerPool.h"
 #include "addons/AddonEconomyModeGameLength.h"
+#include "addons/AddonTransportPlanner.h"
 #include "addons/const_addons.h"
 #include "ai/AIPlayer.h"
 #include "lua/LuaInterfaceGame.h"
@@ -20,7 +23,8 @@ Game::Game(GlobalGameSettings settings, unsigned startGF, const std::vector<Play
 {}
 
 Game::Game(GlobalGameSettings settings, std::unique_ptr<EventManager> em, const std::vector<PlayerInfo>& players)
-    : ggs_(std::move(settings)), em_(std::move(em)), world_(players, ggs_, *em_), started_(false), finished_(false)
+    : ggs_(std::move(settings)), em_(std::move(em)), world_(players, ggs_, *em_), started_(false), finished_(false),
+      workerPool_(std::make_unique<WorkerPool>())
 {}
 
 Game::~Game() = default;
@@ -42,6 +46,7 @@ void Game::Start(bool startFromSave)
         }
         StatisticStep();
     }
+    RecordStatistics();
     if(world_.HasLua())
         world_.GetLua().EventStart(!startFromSave);
 }
@@ -57,6 +62,21 @@ void Game::SetLua(std::unique_ptr<LuaInterfaceGame> newLua)
     world_.SetLua(lua.get());
 }
 
+void Game::SetNumWorkerThreads(unsigned numThreads)
+{
+    workerPool_ = std::make_unique<WorkerPool>(numThreads);
+}
+
+unsigned Game::GetNumWorkerThreads() const
+{
+    return workerPool_->getNumThreads();
+}
+
+void Game::SetStatisticsRecorder(std::unique_ptr<StatisticsRecorder> recorder)
+{
+    statisticsRecorder_ = std::move(recorder);
+}
+
 namespace {
 unsigned getNumAlivePlayers(const GameWorldBase& world)
 {
@@ -68,6 +88,13 @@ unsigned getNumAlivePlayers(const GameWorldBase& world)
     }
     return numPlayersAlive;
 }
+
+/// Return the interval in GFs in which the ware transports are planned or 0 if disabled
+unsigned getTransportPlanInterval(const GlobalGameSettings& ggs)
+{
+    const auto interval = AddonTransportPlannerIntervalList[ggs.getSelection(AddonId::TRANSPORT_PLANNER)];
+    return interval / SPEED_GF_LENGTHS[referenceSpeed];
+}
 } // namespace
 
 void Game::RunGF()
@@ -75,17 +102,28 @@ void Game::RunGF()
     unsigned numPlayersAlive = getNumAlivePlayers(world_);
     //  EventManager Bescheid sagen
     em_->ExecuteNextGF();
+    const unsigned transportPlanInterval = getTransportPlanInterval(ggs_);
+    const bool planTransports = transportPlanInterval > 0 && em_->GetCurrentGF() % transportPlanInterval == 0;
     // Notfallprogramm durchlaufen lassen
+    // The tests are too cheap to run them on the worker pool every GF, its synchronization would cost more
+    auto startTime = std::chrono::steady_clock::now();
     for(unsigned i = 0; i < world_.GetNumPlayers(); ++i)
     {
         GamePlayer& player = world_.GetPlayer(i);
         if(player.isUsed())
         {
             // Auf Notfall testen (Wenige Bretter/Steine und keine Holzindustrie)
-            player.TestForEmergencyProgramm();
-            player.TestPacts();
+            player.SetEmergency(player.CalcEmergency());
+            player.CancelExpiredPacts(player.FindExpiredPacts());
+            if(planTransports)
+            {
+                phaseTimings_.playerUpdate += std::chrono::steady_clock::now() - startTime;
+                player.PlanWareTransports();
+                startTime = std::chrono::steady_clock::now();
+            }
         }
     }
+    phaseTimings_.playerUpdate += std::chrono::steady_clock::now() - startTime;
 
     if(world_.HasLua())
         world_.GetLua().EventGameFrame(em_->GetCurrentGF());
@@ -93,6 +131,7 @@ void Game::RunGF()
     constexpr unsigned GFsIn30s = std::chrono::duration<unsigned>(30) / SPEED_GF_LENGTHS[referenceSpeed];
     if(em_->GetCurrentGF() % GFsIn30s == 0)
         StatisticStep();
+    RecordStatistics();
     // If some players got defeated check objective
     if(getNumAlivePlayers(world_) < numPlayersAlive)
         CheckObjective();
@@ -100,12 +139,24 @@ void Game::RunGF()
 
 void Game::StatisticStep()
 {
-    for(unsigned i = 0; i < world_.GetNumPlayers(); ++i)
-        world_.GetPlayer(i).StatisticStep();
+    // Only reads the world and writes the statistics of each player
+    const auto startTime = std::chrono::steady_clock::now();
+    workerPool_->run(world_.GetNumPlayers(), [this](unsigned i) { world_.GetPlayer(i).StatisticStep(); });
+    phaseTimings_.statistics += std::chrono::steady_clock::now() - startTime;
 
     CheckObjective();
 }
 
+void Game::RecordStatistics()
+{
+    if(!statisticsRecorder_ || !statisticsRecorder_->isDue(em_->GetCurrentGF()))
+        return;
+    std::vector<StatisticValues> values(world_.GetNumPlayers());
+    workerPool_->run(values.size(),
+                     [this, &values](unsigned i) { values[i] = world_.GetPlayer(i).CalcCurrentStatistics(); });
+    statisticsRecorder_->addRow(em_->GetCurrentGF(), values);
+}
+
 void Game::CheckObjective()
 {
     // Check objective if there is one
@@ -7,9 +7,12 @@
 #include "GlobalGameSettings.h"
 #include "world/GameWorld.h"
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <chrono>
 #include <memory>
 
 class AIPlayer;
+class StatisticsRecorder;
+class WorkerPool;
 
 /// Holds all data for a running game
 class Game
@@ -33,12 +36,33 @@ public:
     void AddAIPlayer(std::unique_ptr<AIPlayer> newAI);
     void SetLua(std::unique_ptr<LuaInterfaceGame> newLua);
 
+    /// Wall time spent in the per-player phases of the GFs
+    struct PhaseTimings
+    {
+        /// Emergency program and pacts
+        std::chrono::nanoseconds playerUpdate{0};
+        std::chrono::nanoseconds statistics{0};
+    };
+    const PhaseTimings& GetPhaseTimings() const { return phaseTimings_; }
+    /// Set the number of threads used for the statistics of the players, 0 for one per hardware thread.
+    /// The result is the same for every number of threads.
+    void SetNumWorkerThreads(unsigned numThreads);
+    unsigned GetNumWorkerThreads() const;
+    /// Record the statistics of all players during the game (optional)
+    void SetStatisticsRecorder(std::unique_ptr<StatisticsRecorder> recorder);
+
 private:
     /// Updates the statistics
     void StatisticStep();
     /// Check if the objective was reached (if set)
     void CheckObjective();
+    /// Add the current statistics to the recorder if due
+    void RecordStatistics();
 
     bool started_, finished_;
     std::unique_ptr<LuaInterfaceGame> lua;
+    /// Calculates the statistics of the players in parallel
+    std::unique_ptr<WorkerPool> workerPool_;
+    PhaseTimings phaseTimings_;
+    std::unique_ptr<StatisticsRecorder> statisticsRecorder_;
 };
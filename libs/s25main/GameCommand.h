@@ -89,6 +89,8 @@ public:
         return *this;
     }
 
+    GCType GetType() const { return gcType; }
+
     /// Builds a GameCommand depending on Type
     static GameCommandPtr Deserialize(Deserializer& ser);
 
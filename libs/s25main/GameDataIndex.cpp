@@ -0,0 +1,130 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameDataIndex.h"
+#include "helpers/serializeContainers.h"
+#include "helpers/serializeEnums.h"
+#include "s25util/Serializer.h"
+#include <stdexcept>
+
+namespace {
+/// Write the values with their count, so the number of goods and jobs may change
+template<class T_Array>
+void pushValues(Serializer& ser, const T_Array& values)
+{
+    ser.PushVarSize(values.size());
+    helpers::pushContainer(ser, values);
+}
+
+template<class T_Array>
+void popValues(Serializer& ser, T_Array& values)
+{
+    const unsigned count = ser.PopVarSize();
+    for(unsigned i = 0; i < count; i++)
+    {
+        const unsigned value = ser.PopUnsignedInt();
+        if(i < values.size())
+            values.data()[i] = value;
+    }
+}
+} // namespace
+
+void GameDataIndex::clear()
+{
+    sections.clear();
+    objects = {};
+    events.clear();
+    inventories.clear();
+}
+
+void GameDataIndex::Serialize(Serializer& ser) const
+{
+    ser.PushVarSize(sections.size());
+    for(const Section& section : sections)
+    {
+        helpers::pushEnum<uint8_t>(ser, section.type);
+        ser.PushUnsignedChar(section.player);
+        ser.PushUnsignedInt(section.offset);
+        ser.PushUnsignedInt(section.size);
+    }
+    ser.PushVarSize(objects.size());
+    for(const ObjectStats& stats : objects)
+    {
+        ser.PushUnsignedInt(stats.count);
+        ser.PushUnsignedInt(stats.size);
+    }
+    ser.PushVarSize(events.size());
+    for(const Event& event : events)
+    {
+        ser.PushUnsignedInt(event.instanceId);
+        ser.PushUnsignedInt(event.startGF);
+        ser.PushUnsignedInt(event.length);
+        ser.PushUnsignedInt(event.id);
+        helpers::pushEnum<uint16_t>(ser, event.objType);
+        ser.PushUnsignedInt(event.objId);
+    }
+    ser.PushVarSize(inventories.size());
+    for(const Inventory& inventory : inventories)
+    {
+        pushValues(ser, inventory.goods);
+        pushValues(ser, inventory.people);
+    }
+}
+
+void GameDataIndex::Deserialize(Serializer& ser)
+{
+    clear();
+    try
+    {
+        sections.resize(ser.PopVarSize());
+        for(Section& section : sections)
+        {
+            section.type = helpers::popEnum<SectionType>(ser);
+            section.player = ser.PopUnsignedChar();
+            section.offset = ser.PopUnsignedInt();
+            section.size = ser.PopUnsignedInt();
+        }
+        const unsigned numObjectTypes = ser.PopVarSize();
+        for(unsigned i = 0; i < numObjectTypes; i++)
+        {
+            ObjectStats stats;
+            stats.count = ser.PopUnsignedInt();
+            stats.size = ser.PopUnsignedInt();
+            // Ignore types unknown to this version
+            if(i < objects.size())
+                objects.data()[i] = stats;
+        }
+        events.resize(ser.PopVarSize());
+        for(Event& event : events)
+        {
+            event.instanceId = ser.PopUnsignedInt();
+            event.startGF = ser.PopUnsignedInt();
+            event.length = ser.PopUnsignedInt();
+            event.id = ser.PopUnsignedInt();
+            event.objType = helpers::popEnum<GO_Type>(ser);
+            event.objId = ser.PopUnsignedInt();
+        }
+        inventories.resize(ser.PopVarSize());
+        for(Inventory& inventory : inventories)
+        {
+            popValues(ser, inventory.goods);
+            popValues(ser, inventory.people);
+        }
+    } catch(const std::range_error& e)
+    {
+        throw std::runtime_error(std::string("Invalid game data index: ") + e.what());
+    }
+}
+
+const char* GameDataIndex::getName(const SectionType type)
+{
+    switch(type)
+    {
+        case SectionType::World: return "world";
+        case SectionType::Events: return "events";
+        case SectionType::EconomyMode: return "economy mode";
+        case SectionType::Player: return "player";
+    }
+    return "unknown";
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/EnumArray.h"
+#include "gameTypes/GO_Type.h"
+#include "gameTypes/Inventory.h"
+#include <cstdint>
+#include <vector>
+
+class Serializer;
+
+/// Summary of serialized game data collected while it is written.
+/// Stored in savegames next to the game data, so it can be inspected without loading (or even decompressing) the game.
+struct GameDataIndex
+{
+    enum class SectionType : uint8_t
+    {
+        World,
+        Events,
+        EconomyMode,
+        Player
+    };
+    friend constexpr auto maxEnumValue(SectionType) { return SectionType::Player; }
+    /// Part of the game data. Objects are contained in the section in which they were first referenced.
+    struct Section
+    {
+        SectionType type;
+        /// Player for player sections, 0 otherwise
+        unsigned player;
+        /// Offset and size in the uncompressed game data
+        unsigned offset, size;
+    };
+    struct ObjectStats
+    {
+        unsigned count = 0;
+        /// Size in bytes without the objects serialized inside of them
+        unsigned size = 0;
+    };
+    struct Event
+    {
+        unsigned instanceId;
+        unsigned startGF, length;
+        unsigned id;
+        /// Object handling the event
+        GO_Type objType;
+        unsigned objId;
+
+        unsigned GetTargetGF() const { return startGF + length; }
+    };
+
+    /// Sections in order of the game data
+    std::vector<Section> sections;
+    helpers::EnumArray<ObjectStats, GO_Type> objects;
+    /// Events in the order they will be executed
+    std::vector<Event> events;
+    /// Inventory of each player
+    std::vector<Inventory> inventories;
+
+    bool empty() const { return sections.empty(); }
+    void clear();
+
+    void Serialize(Serializer& ser) const;
+    /// Throws on invalid data
+    void Deserialize(Serializer& ser);
+
+    static const char* getName(SectionType type);
+};
@@ -4,6 +4,7 @@
 
 #include "GameObject.h"
 #include "EventManager.h"
+#include "GameObjectPool.h"
 #include "SerializedGameData.h"
 #include "postSystem/PostMsg.h"
 #include "world/GameWorld.h"
@@ -38,6 +39,16 @@ GameObject::GameObject(const GameObject& go) : objId(go.objId)
 
 void GameObject::Destroy() {}
 
+void* GameObject::operator new(const size_t size)
+{
+    return GameObjectPool::get().allocate(size);
+}
+
+void GameObject::operator delete(void* ptr, const size_t size) noexcept
+{
+    GameObjectPool::get().deallocate(ptr, size);
+}
+
 GameObject::~GameObject()
 {
     // RTTR_Assert(!world || !GetEvMgr().ObjectHasEvents(*this));
@@ -30,6 +30,10 @@ protected:
 public:
     GameObject& operator=(const GameObject&) = delete;
 
+    /// Game objects are allocated from pools by size, see GameObjectPool
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size) noexcept;
+
     /// Handle destruction before deleting the instance
     virtual void Destroy() = 0;
 
@@ -0,0 +1,91 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameObjectPool.h"
+#include "RTTR_Assert.h"
+#include <algorithm>
+#include <new>
+#include <ostream>
+
+GameObjectPool& GameObjectPool::get()
+{
+    // Never destroyed, as objects might still be freed during static destruction
+    static auto* const instance = new GameObjectPool;
+    return *instance;
+}
+
+void GameObjectPool::addSlab(Pool& pool, const size_t objSize)
+{
+    const size_t numObjs = std::max<size_t>(MIN_SLAB_SIZE / objSize, 16u);
+    // Memory from new[] is aligned for any object with fundamental alignment
+    pool.slabs.push_back(std::make_unique<std::byte[]>(numObjs * objSize));
+    std::byte* const slab = pool.slabs.back().get();
+    // Link the objects such that they are used in memory order
+    for(size_t i = numObjs; i-- > 0;)
+    {
+        auto* block = reinterpret_cast<FreeBlock*>(slab + i * objSize);
+        block->next = pool.freeList;
+        pool.freeList = block;
+    }
+    pool.stats.numSlabs++;
+}
+
+void* GameObjectPool::allocate(const size_t size)
+{
+    if(size > MAX_POOLED_SIZE)
+        return ::operator new(size);
+    const size_t poolIdx = getPoolIdx(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Pool& pool = pools_[poolIdx];
+    if(!pool.freeList)
+        addSlab(pool, (poolIdx + 1) * SIZE_STEP);
+    FreeBlock* block = pool.freeList;
+    pool.freeList = block->next;
+    Statistics& stats = pool.stats;
+    stats.numAllocations++;
+    stats.maxAlive = std::max(stats.maxAlive, ++stats.numAlive);
+    return block;
+}
+
+void GameObjectPool::deallocate(void* ptr, const size_t size) noexcept
+{
+    if(!ptr)
+        return;
+    if(size > MAX_POOLED_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Pool& pool = pools_[getPoolIdx(size)];
+    RTTR_Assert(pool.stats.numAlive > 0);
+    pool.stats.numAlive--;
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = pool.freeList;
+    pool.freeList = block;
+}
+
+std::vector<GameObjectPool::Statistics> GameObjectPool::getStatistics() const
+{
+    std::vector<Statistics> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(size_t i = 0; i < NUM_POOLS; i++)
+    {
+        if(pools_[i].stats.numAllocations == 0)
+            continue;
+        result.push_back(pools_[i].stats);
+        result.back().objSize = (i + 1) * SIZE_STEP;
+    }
+    return result;
+}
+
+void GameObjectPool::printStatistics(std::ostream& out) const
+{
+    out << "Game object pools (size: allocations, alive, max alive, slabs):\n";
+    for(const Statistics& stats : getStatistics())
+    {
+        out << stats.objSize << ": " << stats.numAllocations << ", " << stats.numAlive << ", " << stats.maxAlive
+            << ", " << stats.numSlabs << '\n';
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// Slab allocator for the game objects (see GameObject::operator new).
+/// Objects are put into pools by their size, so all objects of a class (e.g. all wares or all carriers) are allocated
+/// next to each other in slabs of many objects. Freed memory is reused by the next object of the same size,
+/// so the short living objects (fire, signs, wares...) don't fragment the heap. Slabs are only freed at exit.
+class GameObjectPool
+{
+public:
+    /// Granularity of the sizes. Also the alignment of all objects
+    static constexpr size_t SIZE_STEP = alignof(std::max_align_t);
+    /// Larger objects are allocated normally
+    static constexpr size_t MAX_POOLED_SIZE = 1024;
+    /// Minimum number of bytes allocated at once
+    static constexpr size_t MIN_SLAB_SIZE = 16 * 1024;
+
+    struct Statistics
+    {
+        /// Object size (rounded up to SIZE_STEP)
+        size_t objSize = 0;
+        /// Number of allocations since start
+        size_t numAllocations = 0;
+        /// Number of objects currently allocated and the maximum of it
+        size_t numAlive = 0;
+        size_t maxAlive = 0;
+        size_t numSlabs = 0;
+    };
+
+    /// Return the pool used for all game objects
+    static GameObjectPool& get();
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr, size_t size) noexcept;
+
+    /// Return the statistics for all used object sizes
+    std::vector<Statistics> getStatistics() const;
+    void printStatistics(std::ostream& out) const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    struct Pool
+    {
+        FreeBlock* freeList = nullptr;
+        std::vector<std::unique_ptr<std::byte[]>> slabs;
+        Statistics stats;
+    };
+
+    static constexpr size_t NUM_POOLS = MAX_POOLED_SIZE / SIZE_STEP;
+    static_assert(SIZE_STEP >= sizeof(FreeBlock), "Freed objects must be able to hold the free list");
+
+    static size_t getPoolIdx(size_t size) { return (size + SIZE_STEP - 1) / SIZE_STEP - 1; }
+    void addSlab(Pool& pool, size_t objSize);
+
+    /// Objects might be created and destroyed concurrently (e.g. while loading)
+    mutable std::mutex mutex_;
+    Pool pools_[NUM_POOLS];
+};
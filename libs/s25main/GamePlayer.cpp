@@ -11,6 +11,7 @@
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
 #include "TradePathCache.h"
+#include "TransportPlanner.h"
 #include "Ware.h"
 #include "WineLoader.h"
 #include "addons/const_addons.h"
@@ -24,12 +25,14 @@
 #include "helpers/mathFuncs.h"
 #include "lua/LuaInterfaceGame.h"
 #include "notifications/ToolNote.h"
+#include "pathfinding/RoadNetworks.h"
 #include "pathfinding/RoadPathFinder.h"
 #include "postSystem/DiplomacyPostQuestion.h"
 #include "postSystem/PostManager.h"
 #include "random/Random.h"
 #include "world/GameWorld.h"
 #include "world/TradeRoute.h"
+#include "world/WorldStateHash.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noShip.h"
 #include "gameTypes/BuildingCount.h"
@@ -61,6 +64,7 @@ GamePlayer::GamePlayer(unsigned playerId, const PlayerInfo& playerInfo, GameWorl
 
     // Inventur nullen
     global_inventory.clear();
+    numJobsWanted = {};
 
     // Statistiken mit 0en füllen
     statistic = {};
@@ -243,10 +247,12 @@ void GamePlayer::Deserialize(SerializedGameData& sgd)
     sgd.PopObjectContainer(roads, GO_Type::Roadsegment);
 
     jobs_wanted.resize(sgd.PopUnsignedInt());
+    numJobsWanted = {};
     for(JobNeeded& job : jobs_wanted)
     {
         job.job = sgd.Pop<Job>();
         job.workplace = sgd.PopObject<noRoadNode>();
+        numJobsWanted[job.job]++;
     }
 
     if(sgd.GetGameDataVersion() < 2)
@@ -360,6 +366,7 @@ nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsW
     nobBaseWarehouse* best = nullptr;
 
     unsigned best_length = std::numeric_limits<unsigned>::max();
+    const RoadNetworks& roadNetworks = world.GetRoadNetworks();
 
     for(nobBaseWarehouse* wh : buildings.GetStorehouses())
     {
@@ -380,6 +387,10 @@ nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsW
         // takes time
         if(world.CalcDistance(start.GetPos(), wh->GetPos()) > best_length)
             continue;
+        // The search would fail anyway, which is the usual case for the searches redone for all roads, jobs and
+        // buildings whenever a road is built
+        if(to_wh ? roadNetworks.isUnreachable(start, *wh) : roadNetworks.isUnreachable(*wh, start))
+            continue;
         // Bei der erlaubten Benutzung von Bootsstraßen Waren-Pathfinding benutzen wenns zu nem Lagerhaus gehn soll
         // start <-> ziel tauschen bei der wegfindung
         unsigned tlength;
@@ -471,6 +482,9 @@ void GamePlayer::NewRoadConnection(RoadSegment* rs)
     // Zu den Straßen hinzufgen, da's ja ne neue ist
     roads.push_back(rs);
 
+    // Everything is rechecked as before, but the warehouse searches skip the pathfinder for warehouses in other road
+    // networks (see RoadNetworks). So requests which can't be served in their network don't search roads at all.
+
     // Alle Straßen müssen nun gucken, ob sie einen Weg zu einem Warehouse finden
     FindCarrierForAllRoads();
 
@@ -504,7 +518,7 @@ void GamePlayer::AddRoad(RoadSegment* rs)
 
 void GamePlayer::DeleteRoad(RoadSegment* rs)
 {
-    RTTR_Assert(helpers::contains(roads, rs));
+    RTTR_Assert(roads.contains(rs));
     roads.remove(rs);
 }
 
@@ -719,6 +733,7 @@ void GamePlayer::AddJobWanted(const Job job, noRoadNode* workplace)
     {
         JobNeeded jn = {job, workplace};
         jobs_wanted.push_back(jn);
+        numJobsWanted[job]++;
     }
 }
 
@@ -728,7 +743,7 @@ void GamePlayer::JobNotWanted(noRoadNode* workplace, bool all)
     {
         if(it->workplace == workplace)
         {
-            it = jobs_wanted.erase(it);
+            it = EraseJobWanted(it);
             if(!all)
                 return;
         } else
@@ -743,7 +758,7 @@ void GamePlayer::OneJobNotWanted(const Job job, noRoadNode* workplace)
     const auto it = helpers::find_if(
       jobs_wanted, [workplace, job](const auto& it) { return it.workplace == workplace && it.job == job; });
     if(it != jobs_wanted.end())
-        jobs_wanted.erase(it);
+        EraseJobWanted(it);
 }
 
 void GamePlayer::SendPostMessage(std::unique_ptr<PostMsg> msg)
@@ -800,12 +815,19 @@ bool GamePlayer::FindWarehouseForJob(const Job job, noRoadNode* goal) const
     return false;
 }
 
+std::list<GamePlayer::JobNeeded>::iterator GamePlayer::EraseJobWanted(const std::list<JobNeeded>::iterator it)
+{
+    RTTR_Assert(numJobsWanted[it->job] > 0);
+    numJobsWanted[it->job]--;
+    return jobs_wanted.erase(it);
+}
+
 void GamePlayer::FindWarehouseForAllJobs()
 {
     for(auto it = jobs_wanted.begin(); it != jobs_wanted.end();)
     {
         if(FindWarehouseForJob(it->job, it->workplace))
-            it = jobs_wanted.erase(it);
+            it = EraseJobWanted(it);
         else
             ++it;
     }
@@ -813,12 +835,12 @@ void GamePlayer::FindWarehouseForAllJobs()
 
 void GamePlayer::FindWarehouseForAllJobs(const Job job)
 {
-    for(auto it = jobs_wanted.begin(); it != jobs_wanted.end();)
+    for(auto it = jobs_wanted.begin(); it != jobs_wanted.end() && numJobsWanted[job] > 0;)
     {
         if(it->job == job)
         {
             if(FindWarehouseForJob(it->job, it->workplace))
-                it = jobs_wanted.erase(it);
+                it = EraseJobWanted(it);
             else
                 ++it;
         } else
@@ -1100,6 +1122,11 @@ noBaseBuilding* GamePlayer::FindClientForWare(const Ware& ware)
     return bestBld;
 }
 
+unsigned GamePlayer::PlanWareTransports()
+{
+    return TransportPlanner(world).Plan(ware_list);
+}
+
 nobBaseWarehouse* GamePlayer::FindWarehouseForWare(const Ware& ware) const
 {
     // Check whs that collect this ware
@@ -1299,7 +1326,7 @@ void GamePlayer::CallFlagWorker(const MapPoint pt, const Job job)
 
 bool GamePlayer::IsFlagWorker(const nofFlagWorker* flagworker)
 {
-    return helpers::contains(flagworkers, flagworker);
+    return flagworkers.contains(flagworker);
 }
 
 void GamePlayer::FlagDestroyed(noFlag* flag)
@@ -1467,28 +1494,34 @@ void GamePlayer::IncreaseMerchandiseStatistic(GoodType type)
 /// Calculates current statistics
 void GamePlayer::CalcStatistics()
 {
+    statisticCurrentData = CalcCurrentStatistics();
+}
+
+helpers::EnumArray<uint32_t, StatisticType> GamePlayer::CalcCurrentStatistics() const
+{
+    helpers::EnumArray<uint32_t, StatisticType> result = statisticCurrentData;
     // Waren aus der Inventur zählen
-    statisticCurrentData[StatisticType::Merchandise] = 0;
+    result[StatisticType::Merchandise] = 0;
     for(const auto i : helpers::enumRange<GoodType>())
-        statisticCurrentData[StatisticType::Merchandise] += global_inventory[i];
+        result[StatisticType::Merchandise] += global_inventory[i];
 
     // Bevölkerung aus der Inventur zählen
-    statisticCurrentData[StatisticType::Inhabitants] = 0;
+    result[StatisticType::Inhabitants] = 0;
     for(const auto i : helpers::enumRange<Job>())
-        statisticCurrentData[StatisticType::Inhabitants] += global_inventory[i];
+        result[StatisticType::Inhabitants] += global_inventory[i];
 
     // Militär aus der Inventur zählen
-    statisticCurrentData[StatisticType::Military] =
+    result[StatisticType::Military] =
       global_inventory.people[Job::Private] + global_inventory.people[Job::PrivateFirstClass] * 2
       + global_inventory.people[Job::Sergeant] * 3 + global_inventory.people[Job::Officer] * 4
       + global_inventory.people[Job::General] * 5;
 
     // Produktivität berechnen
-    statisticCurrentData[StatisticType::Productivity] = buildings.CalcAverageProductivity();
+    result[StatisticType::Productivity] = buildings.CalcAverageProductivity();
 
     // Total points for tournament games
-    statisticCurrentData[StatisticType::Tournament] =
-      statisticCurrentData[StatisticType::Military] + 3 * statisticCurrentData[StatisticType::Vanquished];
+    result[StatisticType::Tournament] = result[StatisticType::Military] + 3 * result[StatisticType::Vanquished];
+    return result;
 }
 
 void GamePlayer::StatisticStep()
@@ -1758,7 +1791,7 @@ void GamePlayer::MakeStartPacts()
 
 bool GamePlayer::IsWareRegistred(const Ware& ware)
 {
-    return helpers::contains(ware_list, &ware);
+    return ware_list.contains(&ware);
 }
 
 bool GamePlayer::IsWareDependent(const Ware& ware)
@@ -1774,12 +1807,28 @@ bool GamePlayer::IsWareDependent(const Ware& ware)
 
 void GamePlayer::IncreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Add(ConvertShields(ware), count);
+    const GoodType good = ConvertShields(ware);
+    global_inventory.Add(good, count);
+    world.GetStateHash().inventoryChanged(GetPlayerId(), good, global_inventory[good] - count, global_inventory[good]);
 }
 
 void GamePlayer::DecreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Remove(ConvertShields(ware), count);
+    const GoodType good = ConvertShields(ware);
+    global_inventory.Remove(good, count);
+    world.GetStateHash().inventoryChanged(GetPlayerId(), good, global_inventory[good] + count, global_inventory[good]);
+}
+
+void GamePlayer::IncreaseInventoryJob(const Job job, const unsigned count)
+{
+    global_inventory.Add(job, count);
+    world.GetStateHash().inventoryChanged(GetPlayerId(), job, global_inventory[job] - count, global_inventory[job]);
+}
+
+void GamePlayer::DecreaseInventoryJob(const Job job, const unsigned count)
+{
+    global_inventory.Remove(job, count);
+    world.GetStateHash().inventoryChanged(GetPlayerId(), job, global_inventory[job] + count, global_inventory[job]);
 }
 
 /// Registriert ein Schiff beim Einwohnermeldeamt
@@ -1832,12 +1881,10 @@ bool GamePlayer::OrderShip(nobHarborBuilding& hb)
 
     noShip* best_ship = nullptr;
     uint32_t best_distance = std::numeric_limits<uint32_t>::max();
-    std::vector<Direction> best_route;
 
     for(auto& it : sfh)
     {
         uint32_t distance;
-        std::vector<Direction> route;
 
         // the estimate (air-line distance) for this and all other ships in the list is already worse than what we
         // found? disregard the rest
@@ -1855,13 +1902,13 @@ bool GamePlayer::OrderShip(nobHarborBuilding& hb)
             return (true);
         }
 
-        if(world.FindShipPathToHarbor(ship.GetPos(), hb.GetHarborPosID(), ship.GetSeaID(), &route, &distance))
+        // Only the length is required here which is cheap to get, the route is only calculated for the best ship
+        if(world.FindShipPathToHarbor(ship.GetPos(), hb.GetHarborPosID(), ship.GetSeaID(), nullptr, &distance))
         {
             if(distance < best_distance)
             {
                 best_ship = &ship;
                 best_distance = distance;
-                best_route = route;
             }
         }
     }
@@ -1869,6 +1916,10 @@ bool GamePlayer::OrderShip(nobHarborBuilding& hb)
     // only order ships not already on their way
     if(best_ship && best_ship->IsIdling())
     {
+        std::vector<Direction> best_route;
+        [[maybe_unused]] const bool routeFound = world.FindShipPathToHarbor(
+          best_ship->GetPos(), hb.GetHarborPosID(), best_ship->GetSeaID(), &best_route, nullptr);
+        RTTR_Assert(routeFound && best_route.size() == best_distance);
         best_ship->GoToHarbor(hb, best_route);
 
         return (true);
@@ -1896,7 +1947,6 @@ void GamePlayer::GetJobForShip(noShip& ship)
     // Evtl. steht irgendwo eine Expedition an und das Schiff kann diese übernehmen
     nobHarborBuilding* best = nullptr;
     int best_points = 0;
-    std::vector<Direction> best_route;
 
     // Beste Weglänge, die ein Schiff zurücklegen muss, welches gerade nichts zu tun hat
     for(nobHarborBuilding* harbor : buildings.GetHarbors())
@@ -1925,9 +1975,9 @@ void GamePlayer::GetJobForShip(noShip& ship)
             }
 
             unsigned length;
-            std::vector<Direction> route;
 
-            if(world.FindShipPathToHarbor(ship.GetPos(), harbor->GetHarborPosID(), ship.GetSeaID(), &route, &length))
+            // Route is only calculated for the best harbor
+            if(world.FindShipPathToHarbor(ship.GetPos(), harbor->GetHarborPosID(), ship.GetSeaID(), nullptr, &length))
             {
                 // Punkte ausrechnen
                 int points = harbor->GetNeedForShip(ships_coming) - length;
@@ -1935,7 +1985,6 @@ void GamePlayer::GetJobForShip(noShip& ship)
                 {
                     best = harbor;
                     best_points = points;
-                    best_route = route;
                 }
             }
         }
@@ -1943,8 +1992,14 @@ void GamePlayer::GetJobForShip(noShip& ship)
 
     // Einen Hafen gefunden?
     if(best)
+    {
+        std::vector<Direction> best_route;
+        [[maybe_unused]] const bool routeFound =
+          world.FindShipPathToHarbor(ship.GetPos(), best->GetHarborPosID(), ship.GetSeaID(), &best_route, nullptr);
+        RTTR_Assert(routeFound);
         // Dann bekommt das gleich der Hafen
         ship.GoToHarbor(*best, best_route);
+    }
 }
 
 /// Gibt die ID eines Schiffes zurück
@@ -2037,15 +2092,20 @@ bool GamePlayer::FindHarborForUnloading(noShip* ship, const MapPoint start, unsi
 }
 
 void GamePlayer::TestForEmergencyProgramm()
+{
+    SetEmergency(CalcEmergency());
+}
+
+bool GamePlayer::CalcEmergency() const
 {
     // we are already defeated, do not even think about an emergency program - it's too late :-(
     if(isDefeated)
-        return;
+        return emergency;
 
     // In Lagern vorhandene Bretter und Steine zählen
     unsigned boards = 0;
     unsigned stones = 0;
-    for(nobBaseWarehouse* wh : buildings.GetStorehouses())
+    for(const nobBaseWarehouse* wh : buildings.GetStorehouses())
     {
         boards += wh->GetInventory().goods[GoodType::Boards];
         stones += wh->GetInventory().goods[GoodType::Stones];
@@ -2056,33 +2116,38 @@ void GamePlayer::TestForEmergencyProgramm()
     // ...and no woddcutter or sawmill
     isNewEmergency &=
       buildings.GetBuildings(BuildingType::Woodcutter).empty() || buildings.GetBuildings(BuildingType::Sawmill).empty();
+    return isNewEmergency;
+}
 
+void GamePlayer::SetEmergency(const bool isEmergency)
+{
+    if(isEmergency == emergency)
+        return;
+    emergency = isEmergency;
     // Wenn nötig, Notfallprogramm auslösen
-    if(isNewEmergency)
+    if(emergency)
     {
-        if(!emergency)
-        {
-            emergency = true;
-            SendPostMessage(std::make_unique<PostMsg>(
-              world.GetEvMgr().GetCurrentGF(), _("The emergency program has been activated."), PostCategory::Economy));
-        }
+        SendPostMessage(std::make_unique<PostMsg>(
+          world.GetEvMgr().GetCurrentGF(), _("The emergency program has been activated."), PostCategory::Economy));
     } else
     {
         // Sobald Notfall vorbei, Notfallprogramm beenden, evtl. Baustellen wieder mit Kram versorgen
-        if(emergency)
-        {
-            emergency = false;
-            SendPostMessage(std::make_unique<PostMsg>(world.GetEvMgr().GetCurrentGF(),
-                                                      _("The emergency program has been deactivated."),
-                                                      PostCategory::Economy));
-            FindMaterialForBuildingSites();
-        }
+        SendPostMessage(std::make_unique<PostMsg>(world.GetEvMgr().GetCurrentGF(),
+                                                  _("The emergency program has been deactivated."),
+                                                  PostCategory::Economy));
+        FindMaterialForBuildingSites();
     }
 }
 
 /// Testet die Bündnisse, ob sie nicht schon abgelaufen sind
 void GamePlayer::TestPacts()
 {
+    CancelExpiredPacts(FindExpiredPacts());
+}
+
+std::vector<GamePlayer::ExpiredPact> GamePlayer::FindExpiredPacts() const
+{
+    std::vector<ExpiredPact> expiredPacts;
     for(unsigned i = 0; i < world.GetNumPlayers(); ++i)
     {
         if(i == GetPlayerId())
@@ -2090,25 +2155,35 @@ void GamePlayer::TestPacts()
 
         for(const auto pact : helpers::enumRange<PactType>())
         {
-            // Pact not running
-            if(pacts[i][pact].duration == 0)
-                continue;
-            if(GetPactState(pact, i) == PactState::None)
-            {
-                // Pact was running but is expired -> Cancel for both players
-                pacts[i][pact].duration = 0;
-                pacts[i][pact].accepted = false;
-                GamePlayer& otherPlayer = world.GetPlayer(i);
-                RTTR_Assert(otherPlayer.pacts[GetPlayerId()][pact].duration);
-                RTTR_Assert(otherPlayer.pacts[GetPlayerId()][pact].accepted);
-                otherPlayer.pacts[GetPlayerId()][pact].duration = 0;
-                otherPlayer.pacts[GetPlayerId()][pact].accepted = false;
-                // And notify
-                PactChanged(pact);
-                otherPlayer.PactChanged(pact);
-            }
+            // Pact was running but is expired
+            if(pacts[i][pact].duration != 0 && GetPactState(pact, i) == PactState::None)
+                expiredPacts.push_back(ExpiredPact{static_cast<unsigned char>(i), pact});
         }
     }
+    return expiredPacts;
+}
+
+void GamePlayer::CancelExpiredPacts(const std::vector<ExpiredPact>& expiredPacts)
+{
+    for(const ExpiredPact& expiredPact : expiredPacts)
+    {
+        Pact& ownPact = pacts[expiredPact.otherPlayer][expiredPact.pact];
+        // Already canceled by the other player
+        if(ownPact.duration == 0)
+            continue;
+        // Cancel for both players
+        ownPact.duration = 0;
+        ownPact.accepted = false;
+        GamePlayer& otherPlayer = world.GetPlayer(expiredPact.otherPlayer);
+        Pact& otherPact = otherPlayer.pacts[GetPlayerId()][expiredPact.pact];
+        RTTR_Assert(otherPact.duration);
+        RTTR_Assert(otherPact.accepted);
+        otherPact.duration = 0;
+        otherPact.accepted = false;
+        // And notify
+        PactChanged(expiredPact.pact);
+        otherPlayer.PactChanged(expiredPact.pact);
+    }
 }
 
 bool GamePlayer::CanBuildCatapult() const
@@ -7,6 +7,7 @@
 #include "BuildingRegister.h"
 #include "GamePlayerInfo.h"
 #include "helpers/EnumArray.h"
+#include "helpers/IndexedList.h"
 #include "helpers/MultiArray.h"
 #include "variant.h"
 #include "gameTypes/BuildingType.h"
@@ -153,6 +154,9 @@ public:
 
     /// Sucht einen Abnehmer (sprich Militärgebäude), wenn es keinen findet, wird ein Warenhaus zurückgegeben bzw. 0
     nobBaseMilitary* FindClientForCoin(const Ware& ware) const;
+    /// Swap the goals of the wares waiting at flags to reduce the transport costs (see TransportPlanner).
+    /// Return the number of wares with a new goal
+    unsigned PlanWareTransports();
 
     /// Gibt Priorität der Baustelle zurück (entscheidet selbständig, welche Reihenfolge usw)
     /// je kleiner die Rückgabe, destro größer die Priorität!
@@ -178,8 +182,8 @@ public:
     /// Fügt Waren zur Inventur hinzu
     void IncreaseInventoryWare(GoodType ware, unsigned count);
     void DecreaseInventoryWare(GoodType ware, unsigned count);
-    void IncreaseInventoryJob(const Job job, unsigned count) { global_inventory.Add(job, count); }
-    void DecreaseInventoryJob(const Job job, unsigned count) { global_inventory.Remove(job, count); }
+    void IncreaseInventoryJob(Job job, unsigned count);
+    void DecreaseInventoryJob(Job job, unsigned count);
 
     /// Gibt Inventory-Settings zurück
     const Inventory& GetInventory() const { return global_inventory; }
@@ -276,6 +280,16 @@ public:
     void MakeStartPacts();
     /// Testet die Bündnisse, ob sie nicht schon abgelaufen sind
     void TestPacts();
+    /// Expired pact with another player
+    struct ExpiredPact
+    {
+        unsigned char otherPlayer;
+        PactType pact;
+    };
+    /// Return the pacts that expired. Doesn't change the game state so it may run in parallel for all players
+    std::vector<ExpiredPact> FindExpiredPacts() const;
+    /// Cancel the given pacts for both players unless that already happened
+    void CancelExpiredPacts(const std::vector<ExpiredPact>& expiredPacts);
 
     /// Returns all warehouses that can trade with the given goal
     /// IMPORTANT: Warehouses can be destroyed. So check them first before using!
@@ -317,6 +331,8 @@ public:
 
     /// Calculates current statistics
     void CalcStatistics();
+    /// Return the current statistics without storing them, e.g. to record them more often than the statistic steps
+    helpers::EnumArray<uint32_t, StatisticType> CalcCurrentStatistics() const;
     void StatisticStep();
 
     const Statistic& GetStatistic(StatisticTime time) const { return statistic[time]; };
@@ -324,6 +340,10 @@ public:
 
     // Testet ob Notfallprogramm aktiviert werden muss und tut dies dann
     void TestForEmergencyProgramm();
+    /// Return whether the emergency program is required. Doesn't change the game state
+    bool CalcEmergency() const;
+    /// (De)activate the emergency program if required
+    void SetEmergency(bool isEmergency);
     bool hasEmergency() const { return emergency; }
     /// Testet ob der Spieler noch mehr Katapulte bauen darf
     bool CanBuildCatapult() const;
@@ -341,7 +361,7 @@ private:
     BuildingRegister buildings; //-V730_NOINIT
 
     /// Lister aller Straßen von dem Spieler
-    std::list<RoadSegment*> roads;
+    helpers::IndexedList<RoadSegment*> roads;
 
     struct JobNeeded
     {
@@ -351,11 +371,13 @@ private:
 
     /// Liste von Baustellen/Gebäuden, die bestimmten Beruf wollen
     std::list<JobNeeded> jobs_wanted;
+    /// Number of entries in jobs_wanted per job, so searches for a job nobody wants are skipped
+    helpers::EnumArray<unsigned, Job> numJobsWanted;
 
     /// Liste von sämtlichen Waren, die herumgetragen werden und an Fahnen liegen
-    std::list<Ware*> ware_list;
+    helpers::IndexedList<Ware*> ware_list;
     /// Liste von Geologen und Spähern, die an eine Flagge gebunden sind
-    std::list<nofFlagWorker*> flagworkers;
+    helpers::IndexedList<nofFlagWorker*> flagworkers;
     /// Liste von Schiffen dieses Spielers
     std::vector<noShip*> ships;
 
@@ -424,6 +446,8 @@ private:
     void PactChanged(PactType pt);
     // Sucht Weg für Job zu entsprechenden noRoadNode
     bool FindWarehouseForJob(Job job, noRoadNode* goal) const;
+    /// Remove the entry from jobs_wanted and return the next one
+    std::list<JobNeeded>::iterator EraseJobWanted(std::list<JobNeeded>::iterator it);
     /// Prüft, ob der Spieler besiegt wurde
     void TestDefeat();
 
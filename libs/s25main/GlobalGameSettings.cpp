@@ -100,6 +100,7 @@ void GlobalGameSettings::registerAllAddons()
         AddonStatisticsVisibility,
         AddonToolOrdering,
         AddonTrade,
+        AddonTransportPlanner,
         AddonAutoFlags,
         AddonWine
     >;
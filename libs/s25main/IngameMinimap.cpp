@@ -5,124 +5,123 @@
 #include "IngameMinimap.h"
 #include "FOWObjects.h"
 #include "GamePlayer.h"
-#include "RttrForeachPt.h"
+#include "helpers/mathFuncs.h"
 #include "world/GameWorldBase.h"
 #include "world/GameWorldViewer.h"
 #include "gameData/MinimapConsts.h"
 #include "gameData/TerrainDesc.h"
 #include "libsiedler2/ColorBGRA.h"
+#include <algorithm>
 
 IngameMinimap::IngameMinimap(const GameWorldViewer& gwv)
-    : Minimap(gwv.GetWorld().GetSize()), gwv(gwv), nodes_updated(GetMapSize().x * GetMapSize().y, false),
-      dos(GetMapSize().x * GetMapSize().y, DrawnObject::Invalid), territory(true), houses(true), roads(true)
+    : Minimap(gwv.GetWorld().GetSize()), gwv(gwv),
+      numTiles(helpers::divCeil(GetMapSize().x, DIRTY_TILE_SIZE), helpers::divCeil(GetMapSize().y, DIRTY_TILE_SIZE)),
+      dirtyTiles(prodOfComponents(numTiles)), dirtyNodes(prodOfComponents(GetMapSize()), false), numNodesToUpdate(0), territory(true), houses(true), roads(true)
 {
+    const unsigned numPixels = prodOfComponents(GetMapSize()) * 2;
+    layers.baseColors.resize(numPixels);
+    layers.territoryColors.resize(numPixels);
+    layers.drawnObjects.resize(numPixels, DrawnObject::Invalid);
+    layers.fow.resize(numPixels);
     CreateMapTexture();
 }
 
 unsigned IngameMinimap::CalcPixelColor(const MapPoint pt, const unsigned t)
 {
-    unsigned color = 0;
+    CalcPixelLayers(pt, t);
+    return ComposePixel(GetPixelIdx(pt, t));
+}
 
+void IngameMinimap::CalcPixelLayers(const MapPoint pt, const unsigned t)
+{
+    const unsigned idx = GetPixelIdx(pt, t);
     Visibility visibility = gwv.GetVisibility(pt);
 
     if(visibility == Visibility::Invisible)
     {
-        dos[GetMMIdx(pt)] = DrawnObject::Invisible;
         // Man sieht nichts --> schwarz
-        return 0xFF000000;
-    } else
-    {
-        DrawnObject drawn_object = DrawnObject::Invalid;
+        layers.drawnObjects[idx] = DrawnObject::Invisible;
+        layers.baseColors[idx] = layers.territoryColors[idx] = 0xFF000000;
+        layers.fow[idx] = false;
+        return;
+    }
 
-        const bool fow = (visibility == Visibility::FogOfWar);
+    DrawnObject drawn_object;
+    unsigned color;
 
-        unsigned char owner;
-        NodalObjectType noType = NodalObjectType::Nothing;
-        FoW_Type fot = FoW_Type::Nothing;
-        if(!fow)
-        {
-            const MapNode& node = gwv.GetNode(pt);
-            owner = node.owner;
-            if(node.obj)
-                noType = node.obj->GetType();
-        } else
-        {
-            const FoWNode& node = gwv.GetYoungestFOWNode(pt);
-            owner = node.owner;
-            if(node.object)
-                fot = node.object->GetType();
-        }
+    const bool fow = (visibility == Visibility::FogOfWar);
 
-        // Baum an dieser Stelle?
-        if((!fow && noType == NodalObjectType::Tree) || (fow && fot == FoW_Type::Tree)) //-V807
-        {
-            color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
-            drawn_object = DrawnObject::Terrain;
-            // Ggf. mit Spielerfarbe
-            if(owner)
-            {
-                drawn_object = DrawnObject::Player;
-                if(territory)
-                    color = CombineWithPlayerColor(color, owner);
-            }
-        }
-        // Granit an dieser Stelle?
-        else if((!fow && noType == NodalObjectType::Granite) || (fow && fot == FoW_Type::Granite))
-        {
-            color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
+    unsigned char owner;
+    NodalObjectType noType = NodalObjectType::Nothing;
+    FoW_Type fot = FoW_Type::Nothing;
+    if(!fow)
+    {
+        const MapNode& node = gwv.GetNode(pt);
+        owner = node.owner;
+        if(node.obj)
+            noType = node.obj->GetType();
+    } else
+    {
+        const FoWNode& node = gwv.GetYoungestFOWNode(pt);
+        owner = node.owner;
+        if(node.object)
+            fot = node.object->GetType();
+    }
+
+    // Baum an dieser Stelle?
+    if((!fow && noType == NodalObjectType::Tree) || (fow && fot == FoW_Type::Tree)) //-V807
+    {
+        color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
+        drawn_object = owner ? DrawnObject::Player : DrawnObject::Terrain;
+    }
+    // Granit an dieser Stelle?
+    else if((!fow && noType == NodalObjectType::Granite) || (fow && fot == FoW_Type::Granite))
+    {
+        color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
+        drawn_object = owner ? DrawnObject::Player : DrawnObject::Terrain;
+    }
+    // Ansonsten die jeweilige Terrainfarbe nehmen
+    else
+    {
+        color = CalcTerrainColor(pt, t);
+        if(!owner)
             drawn_object = DrawnObject::Terrain;
-            // Ggf. mit Spielerfarbe
-            if(owner)
-            {
-                drawn_object = DrawnObject::Player;
-                if(territory)
-                    color = CombineWithPlayerColor(color, owner);
-            }
-        }
-        // Ansonsten die jeweilige Terrainfarbe nehmen
+        // Building?
+        else if(((!fow && (noType == NodalObjectType::Building || noType == NodalObjectType::Buildingsite))
+                 || (fow && (fot == FoW_Type::Building || fot == FoW_Type::Buildingsite))))
+            drawn_object = DrawnObject::Buidling;
+        /// Roads?
+        else if(IsRoad(pt, visibility))
+            drawn_object = DrawnObject::Road;
+        // ansonsten normales Territorium
         else
-        {
-            // Ggf. Spielerfarbe mit einberechnen, falls das von einem Spieler ein Territorium ist
-            if(owner)
-            {
-                // Building?
-                if(((!fow && (noType == NodalObjectType::Building || noType == NodalObjectType::Buildingsite))
-                    || (fow && (fot == FoW_Type::Building || fot == FoW_Type::Buildingsite))))
-                    drawn_object = DrawnObject::Buidling;
-                /// Roads?
-                else if(IsRoad(pt, visibility))
-                    drawn_object = DrawnObject::Road;
-                // ansonsten normales Territorium?
-                else
-                    drawn_object = DrawnObject::Player;
-
-                if(drawn_object == DrawnObject::Buidling && houses)
-                    color = BUILDING_COLOR;
-                /// Roads?
-                else if(drawn_object == DrawnObject::Road && roads)
-                    color = ROAD_COLOR;
-                // ansonsten normales Territorium?
-                else if(territory)
-                    // Normales Terrain und Spielerfarbe berechnen
-                    color = CombineWithPlayerColor(CalcTerrainColor(pt, t), owner);
-                else
-                    // Normales Terrain berechnen
-                    color = CalcTerrainColor(pt, t);
-            } else
-            {
-                // Normales Terrain berechnen
-                color = CalcTerrainColor(pt, t);
-                drawn_object = DrawnObject::Terrain;
-            }
-        }
+            drawn_object = DrawnObject::Player;
+    }
 
-        // Bei FOW die Farben abdunkeln
-        if(fow)
-            color = MakeColor(0xFF, GetRed(color) / 2, GetGreen(color) / 2, GetBlue(color) / 2);
+    layers.drawnObjects[idx] = drawn_object;
+    layers.baseColors[idx] = color;
+    // Ggf. Spielerfarbe mit einberechnen, falls das von einem Spieler ein Territorium ist
+    layers.territoryColors[idx] = owner ? CombineWithPlayerColor(color, owner) : color;
+    layers.fow[idx] = fow;
+}
 
-        dos[GetMMIdx(pt)] = drawn_object;
-    }
+unsigned IngameMinimap::ComposePixel(const unsigned pixelIdx) const
+{
+    const DrawnObject drawn_object = layers.drawnObjects[pixelIdx];
+    unsigned color;
+    if(drawn_object == DrawnObject::Buidling && houses)
+        color = BUILDING_COLOR;
+    else if(drawn_object == DrawnObject::Road && roads)
+        color = ROAD_COLOR;
+    // Territory color equals the base color for unowned nodes
+    else if(territory)
+        color = layers.territoryColors[pixelIdx];
+    else
+        color = layers.baseColors[pixelIdx];
 
+    // Bei FOW die Farben abdunkeln
+    if(layers.fow[pixelIdx])
+        color = MakeColor(0xFF, GetRed(color) / 2, GetGreen(color) / 2, GetBlue(color) / 2);
     return color;
 }
 
@@ -185,10 +184,21 @@ unsigned IngameMinimap::CombineWithPlayerColor(const unsigned color, const unsig
 
 void IngameMinimap::UpdateNode(const MapPoint pt)
 {
-    if(!nodes_updated[GetMMIdx(pt)])
+    if(dirtyNodes[GetMMIdx(pt)])
+        return;
+    dirtyNodes[GetMMIdx(pt)] = true;
+    ++numNodesToUpdate;
+    const unsigned tileIdx = (pt.y / DIRTY_TILE_SIZE) * numTiles.x + pt.x / DIRTY_TILE_SIZE;
+    DirtyArea& tile = dirtyTiles[tileIdx];
+    if(!tile.isDirty)
+    {
+        tile.isDirty = true;
+        tile.min = tile.max = pt;
+        dirtyTileIdxs.push_back(tileIdx);
+    } else
     {
-        nodes_updated[GetMMIdx(pt)] = true;
-        nodesToUpdate.push_back(pt);
+        tile.min = MapPoint(std::min(tile.min.x, pt.x), std::min(tile.min.y, pt.y));
+        tile.max = MapPoint(std::max(tile.max.x, pt.x), std::max(tile.max.y, pt.y));
     }
 }
 
@@ -200,32 +210,49 @@ void IngameMinimap::BeforeDrawing()
     // Ab welcher Knotenanzahl (Teil der Gesamtknotenanzahl) die Textur komplett neu erstellt werden soll
     static const unsigned MAX_NODES_UPDATE_DENOMINATOR = 2; // (2 = 1/2, 3 = 1/3 usw.)
 
-    if(!nodesToUpdate.empty())
+    if(dirtyTileIdxs.empty())
+        return;
+
+    // Komplette Textur neu erzeugen, weil es zu viele Knoten sind?
+    if(numNodesToUpdate >= prodOfComponents(GetMapSize()) / MAX_NODES_UPDATE_DENOMINATOR)
+        UpdateAll();
+    else
     {
-        // Komplette Textur neu erzeugen, weil es zu viele Knoten sind?
-        if(nodesToUpdate.size() >= nodes_updated.size() / MAX_NODES_UPDATE_DENOMINATOR)
-        {
-            // Ja, alles neu erzeugen
-            UpdateAll();
-            std::fill(nodes_updated.begin(), nodes_updated.end(), false);
-        } else
+        // Upload each changed rectangle separately to keep the uploaded area small
+        for(const unsigned tileIdx : dirtyTileIdxs)
         {
+            const DirtyArea& tile = dirtyTiles[tileIdx];
             map.beginUpdate();
-            // Entsprechende Pixel updaten
-            for(auto& it : nodesToUpdate)
-            {
-                for(unsigned t = 0; t < 2; ++t)
-                {
-                    unsigned color = CalcPixelColor(it, t);
-                    DrawPoint texPos((it.x * 2 + t + (it.y & 1)) % (GetMapSize().x * 2), it.y);
-                    map.updatePixel(texPos, libsiedler2::ColorBGRA(color));
-                }
-                nodes_updated[GetMMIdx(it)] = false;
-            }
+            for(MapCoord y = tile.min.y; y <= tile.max.y; ++y)
+                UpdateRow(y, tile.min.x, tile.max.x);
             map.endUpdate();
         }
+        ClearDirtyTiles();
+    }
+}
 
-        this->nodesToUpdate.clear();
+void IngameMinimap::UpdateRow(const MapCoord y, const MapCoord xStart, const MapCoord xEnd)
+{
+    // Layers of the row are stored consecutively
+    const unsigned firstIdx = GetPixelIdx(MapPoint(xStart, y), 0);
+    const unsigned lastIdx = GetPixelIdx(MapPoint(xEnd, y), 1);
+    // Only recalculate the changed nodes as trees and granite get a random brightness
+    for(MapPoint pt(xStart, y); pt.x <= xEnd; ++pt.x)
+    {
+        if(!dirtyNodes[GetMMIdx(pt)])
+            continue;
+        dirtyNodes[GetMMIdx(pt)] = false;
+        CalcPixelLayers(pt, 0);
+        CalcPixelLayers(pt, 1);
+    }
+    const unsigned texWidth = GetMapSize().x * 2;
+    // Odd rows are shifted by one pixel
+    unsigned texX = (xStart * 2 + (y & 1)) % texWidth;
+    for(unsigned idx = firstIdx; idx <= lastIdx; ++idx)
+    {
+        map.updatePixel(DrawPoint(texX, y), libsiedler2::ColorBGRA(ComposePixel(idx)));
+        if(++texX == texWidth)
+            texX = 0;
     }
 }
 
@@ -236,28 +263,44 @@ void IngameMinimap::UpdateAll()
 {
     map.DeleteTexture();
     CreateMapTexture();
+    ClearDirtyTiles();
+}
+
+void IngameMinimap::ClearDirtyTiles()
+{
+    for(const unsigned tileIdx : dirtyTileIdxs)
+    {
+        DirtyArea& tile = dirtyTiles[tileIdx];
+        tile.isDirty = false;
+        for(MapPoint pt(0, tile.min.y); pt.y <= tile.max.y; ++pt.y)
+        {
+            for(pt.x = tile.min.x; pt.x <= tile.max.x; ++pt.x)
+                dirtyNodes[GetMMIdx(pt)] = false;
+        }
+    }
+    dirtyTileIdxs.clear();
+    numNodesToUpdate = 0;
 }
 
 /**
- *  Update all nodes with the given drawn object
+ *  Recomposite all pixels with the given drawn object. Only the toggles changed, so the layers are still valid
  */
-void IngameMinimap::UpdateAll(const DrawnObject drawn_object)
+void IngameMinimap::RecomposeAll(const DrawnObject drawn_object)
 {
+    const unsigned texWidth = GetMapSize().x * 2;
     map.beginUpdate();
-    // Gesamte Karte neu berechnen
-    RTTR_FOREACH_PT(MapPoint, GetMapSize())
+    unsigned idx = 0;
+    for(MapCoord y = 0; y < GetMapSize().y; ++y)
     {
-        for(unsigned t = 0; t < 2; ++t)
+        for(unsigned x = 0; x < texWidth; ++x, ++idx)
         {
-            if(dos[GetMMIdx(pt)] == drawn_object
+            const DrawnObject curObj = layers.drawnObjects[idx];
+            if(curObj == drawn_object
                || (drawn_object == DrawnObject::Player && // for DrawnObject::Player check for not drawn buildings or
                                                           // roads as there is only the player territory visible
-                   ((dos[GetMMIdx(pt)] == DrawnObject::Buidling && !houses)
-                    || (dos[GetMMIdx(pt)] == DrawnObject::Road && !roads))))
+                   ((curObj == DrawnObject::Buidling && !houses) || (curObj == DrawnObject::Road && !roads))))
             {
-                unsigned color = CalcPixelColor(pt, t);
-                DrawPoint texPos((pt.x * 2 + t + (pt.y & 1)) % (GetMapSize().x * 2), pt.y);
-                map.updatePixel(texPos, libsiedler2::ColorBGRA(color));
+                map.updatePixel(DrawPoint((x + (y & 1)) % texWidth, y), libsiedler2::ColorBGRA(ComposePixel(idx)));
             }
         }
     }
@@ -267,17 +310,17 @@ void IngameMinimap::UpdateAll(const DrawnObject drawn_object)
 void IngameMinimap::ToggleTerritory()
 {
     territory = !territory;
-    UpdateAll(DrawnObject::Player);
+    RecomposeAll(DrawnObject::Player);
 }
 
 void IngameMinimap::ToggleHouses()
 {
     houses = !houses;
-    UpdateAll(DrawnObject::Buidling);
+    RecomposeAll(DrawnObject::Buidling);
 }
 
 void IngameMinimap::ToggleRoads()
 {
     roads = !roads;
-    UpdateAll(DrawnObject::Road);
+    RecomposeAll(DrawnObject::Road);
 }
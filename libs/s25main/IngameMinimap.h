@@ -6,22 +6,23 @@
 
 #include "Minimap.h"
 #include "gameTypes/MapTypes.h"
+#include <cstdint>
 #include <vector>
 
 class GameWorldViewer;
 
 class IngameMinimap : public Minimap
 {
+public:
+    /// Size (in nodes) of the tiles used to group changed nodes into rectangles
+    static constexpr unsigned DIRTY_TILE_SIZE = 16;
+
+private:
     /// Referenz auf den GameWorldViewer
     const GameWorldViewer& gwv;
-    /// Speichert die einzelnen Veränderungen eines jeden Mappunktes, damit nicht unnötigerweise
-    /// in einem GF mehrmals der Mappunkt verändert wird
-    std::vector<bool> nodes_updated;
-    /// Liste mit allen Punkten, die geändert werden müssen
-    std::vector<MapPoint> nodesToUpdate;
 
     /// Für jeden einzelnen Knoten speichern, welches Objekt hier dominiert, also wessen Pixel angezeigt wird
-    enum class DrawnObject
+    enum class DrawnObject : uint8_t
     {
         Invalid,
         Invisible, /// im im vollständigem Dunklen
@@ -31,7 +32,32 @@ class IngameMinimap : public Minimap
         Road       /// Straße
     };
 
-    std::vector<DrawnObject> dos;
+    /// Color layers of each pixel (2 per node: one for each triangle) from which the final color gets composited
+    /// according to the toggles. Stored per layer so a row can be processed in one go
+    struct PixelLayers
+    {
+        /// Color of terrain, tree or granite
+        std::vector<unsigned> baseColors;
+        /// Base color combined with the owners color (Same as baseColor if unowned)
+        std::vector<unsigned> territoryColors;
+        std::vector<DrawnObject> drawnObjects;
+        std::vector<bool> fow;
+    } layers;
+
+    /// Bounding box of the changed nodes of one tile
+    struct DirtyArea
+    {
+        MapPoint min, max;
+        bool isDirty = false;
+    };
+    MapExtent numTiles;
+    std::vector<DirtyArea> dirtyTiles;
+    /// Indices of all tiles with changed nodes
+    std::vector<unsigned> dirtyTileIdxs;
+    /// Changed nodes, only those are recalculated. The rectangles just group them for the upload
+    std::vector<bool> dirtyNodes;
+    /// Number of changed nodes
+    unsigned numNodesToUpdate;
 
     /// Einzelne Dinge anzeigen oder nicht anzeigen
     bool territory; /// Länder der Spieler
@@ -52,6 +78,9 @@ public:
     void ToggleHouses();
     void ToggleRoads();
 
+    /// Number of rectangles waiting to be uploaded
+    unsigned GetNumDirtyRects() const { return static_cast<unsigned>(dirtyTileIdxs.size()); }
+
 protected:
     /// Berechnet die Farbe für einen bestimmten Pixel der Minimap (t = Terrain1 oder 2)
     unsigned CalcPixelColor(MapPoint pt, unsigned t) override;
@@ -64,6 +93,18 @@ protected:
     /// Zusätzliche Dinge, die die einzelnen Maps vor dem Zeichenvorgang zu tun haben
     /// in dem Falle: Karte aktualisieren
     void BeforeDrawing() override;
-    /// Alle Punkte Updaten, bei denen das DrawnObject gleich dem übergebenen drawn_object ist
-    void UpdateAll(DrawnObject drawn_object);
+
+private:
+    /// Index of the pixel for the given triangle of the node in the layers
+    unsigned GetPixelIdx(const MapPoint pt, const unsigned t) const { return GetMMIdx(pt) * 2 + t; }
+    /// Calculate the layers of the given pixel from the world
+    void CalcPixelLayers(MapPoint pt, unsigned t);
+    /// Get the final color of the pixel from its layers
+    unsigned ComposePixel(unsigned pixelIdx) const;
+    /// Recalculate the layers of the changed nodes in [xStart, xEnd] of row y and write the composited colors of all of
+    /// them to the texture
+    void UpdateRow(MapCoord y, MapCoord xStart, MapCoord xEnd);
+    /// Recomposite all pixels with the given drawn object from the stored layers
+    void RecomposeAll(DrawnObject drawn_object);
+    void ClearDirtyTiles();
 };
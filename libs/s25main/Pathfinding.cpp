@@ -6,10 +6,12 @@
 #include "helpers/EnumRange.h"
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/HumanReachability.h"
 #include "pathfinding/PathConditionHuman.h"
 #include "pathfinding/PathConditionShip.h"
 #include "pathfinding/PathConditionTrade.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ShipPathCache.h"
 #include "world/GameWorld.h"
 #include "gameTypes/ShipDirection.h"
 #include "gameData/GameConsts.h"
@@ -19,6 +21,9 @@ helpers::OptionalEnum<Direction> GameWorldBase::FindHumanPath(const MapPoint sta
                                                               const unsigned max_route, const bool random_route,
                                                               unsigned* length, std::vector<Direction>* route) const
 {
+    // Don't search if the destination is not connected at all
+    if(!humanReachability->mayBeReachable(start, dest))
+        return boost::none;
     Direction first_dir{};
     if(GetFreePathFinder().FindPath(start, dest, random_route, max_route, route, length, &first_dir,
                                     PathConditionHuman(*this)))
@@ -51,7 +56,7 @@ RoadPathDirection GameWorld::FindPathForWareOnRoads(const noRoadNode& start, con
 }
 
 bool GameWorldBase::FindShipPathToHarbor(const MapPoint start, unsigned harborId, unsigned seaId,
-                                         std::vector<Direction>* route, unsigned* length)
+                                         std::vector<Direction>* route, unsigned* length) const
 {
     // Find the distance to the furthest harbor from the target harbor and take that as maximum
     unsigned maxDistance = 0;
@@ -71,10 +76,31 @@ bool GameWorldBase::FindShipPathToHarbor(const MapPoint start, unsigned harborId
 }
 
 bool GameWorldBase::FindShipPath(const MapPoint start, const MapPoint dest, unsigned maxDistance,
-                                 std::vector<Direction>* route, unsigned* length)
+                                 std::vector<Direction>* route, unsigned* length) const
 {
-    return GetFreePathFinder().FindPath(start, dest, true, maxDistance, route, length, nullptr,
-                                        PathConditionShip(*this));
+    // Water never changes so the precomputed distances tell us if there is a path without searching for it
+    const boost::optional<unsigned> distance = shipPathCache->getDistance(start, dest);
+    if(distance && start != dest)
+    {
+        // A* always finds a shortest path if there is one not longer than maxDistance
+        if(*distance > maxDistance)
+            return false;
+        if(length)
+            *length = *distance;
+        if(!route)
+            return true;
+        // Route depends on the start direction so we get the exact same route as the pathfinder would return
+        if(shipPathCache->getRoute(start, dest, GetFreePathFinder().GetStartDir(start, true), *route))
+            return true;
+    }
+    if(!GetFreePathFinder().FindPath(start, dest, true, maxDistance, route, length, nullptr, PathConditionShip(*this)))
+        return false;
+    if(distance && route)
+    {
+        RTTR_Assert(route->size() == *distance);
+        shipPathCache->addRoute(start, dest, GetFreePathFinder().GetStartDir(start, true), *route);
+    }
+    return true;
 }
 
 /// Prüft, ob eine Schiffsroute noch Gültigkeit hat
@@ -243,6 +243,11 @@ bool Replay::LoadHeader(const boost::filesystem::path& filepath)
 }
 
 bool Replay::LoadGameData(MapInfo& mapInfo)
+{
+    return LoadGameData(mapInfo, SaveGameDataToLoad::All);
+}
+
+bool Replay::LoadGameData(MapInfo& mapInfo, const SaveGameDataToLoad savegameData)
 {
     try
     {
@@ -283,7 +288,7 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
                 break;
             case MapType::Savegame:
                 mapInfo.savegame = std::make_unique<Savegame>();
-                if(!mapInfo.savegame->Load(file_, SaveGameDataToLoad::All))
+                if(!mapInfo.savegame->Load(file_, savegameData))
                 {
                     lastErrorMsg = std::string(_("Savegame error: ")) + mapInfo.savegame->GetLastErrorMsg();
                     return false;
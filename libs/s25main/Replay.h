@@ -15,6 +15,7 @@
 #include <string>
 
 class MapInfo;
+enum class SaveGameDataToLoad;
 struct PlayerGameCommands;
 class TmpFile;
 
@@ -69,6 +70,8 @@ public:
     bool LoadHeader(const boost::filesystem::path& filepath);
     /// Load the remaining data into the mapInfo
     bool LoadGameData(MapInfo& mapInfo);
+    /// Load the remaining data but only the given parts of a savegame. The commands can be read afterwards in any case
+    bool LoadGameData(MapInfo& mapInfo, SaveGameDataToLoad savegameData);
 
     /// Record a chat message
     void AddChatCommand(unsigned gf, uint8_t player, ChatDestination dest, const std::string& str);
@@ -7,6 +7,7 @@
 #include "s25util/BinaryFile.h"
 #include <boost/filesystem/operations.hpp>
 #include <boost/nowide/fstream.hpp>
+#include <utility>
 
 std::string Savegame::GetSignature() const
 {
@@ -16,7 +17,8 @@ std::string Savegame::GetSignature() const
 uint8_t Savegame::GetLatestMinorVersion() const
 {
     // 4.1: Portraits support
-    return 1;
+    // 4.2: Index of the game data
+    return 2;
 }
 
 uint8_t Savegame::GetLatestMajorVersion() const
@@ -45,6 +47,7 @@ bool Savegame::Save(BinaryFile& file, const std::string& mapName)
     WriteAllHeaderData(file, mapName);
     WritePlayerData(file);
     WriteGGS(file);
+    WriteIndex(file);
     WriteGameData(file);
 
     return true;
@@ -63,6 +66,7 @@ bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
     {
         ClearPlayers();
         sgd.Clear();
+        sgd.SetIndex(GameDataIndex());
         if(!ReadAllHeaderData(file))
             return false;
 
@@ -75,7 +79,12 @@ bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
         if(what == SaveGameDataToLoad::HeaderAndSettings)
             return true;
 
-        ReadGameData(file);
+        if(GetMinorVersion() >= 2)
+            ReadIndex(file);
+        if(what == SaveGameDataToLoad::HeaderSettingsAndIndex)
+            SkipGameData(file);
+        else
+            ReadGameData(file);
     } catch(const std::runtime_error& e)
     {
         lastErrorMsg = e.what();
@@ -99,6 +108,30 @@ bool Savegame::ReadExtHeader(BinaryFile& file)
     return true;
 }
 
+void Savegame::WriteIndex(BinaryFile& file)
+{
+    Serializer ser;
+    sgd.GetIndex().Serialize(ser);
+    std::vector<char> data(ser.GetData(), ser.GetData() + ser.GetLength());
+    const unsigned uncompressedLength = data.size();
+    data = CompressedData::compress(data);
+    file.WriteUnsignedInt(uncompressedLength);
+    file.WriteUnsignedInt(data.size());
+    file.WriteRawData(data.data(), data.size());
+}
+
+void Savegame::ReadIndex(BinaryFile& file)
+{
+    const auto uncompressedLength = file.ReadUnsignedInt();
+    std::vector<char> data(file.ReadUnsignedInt());
+    file.ReadRawData(data.data(), data.size());
+    data = CompressedData::decompress(data, uncompressedLength);
+    Serializer ser(data.data(), data.size());
+    GameDataIndex index;
+    index.Deserialize(ser);
+    sgd.SetIndex(std::move(index));
+}
+
 void Savegame::WriteGameData(BinaryFile& file)
 {
     file.WriteUnsignedInt(1); // Compressed flag for compatibility
@@ -138,3 +171,14 @@ bool Savegame::ReadGameData(BinaryFile& file)
     sgd.PushRawData(data.data(), data.size());
     return true;
 }
+
+void Savegame::SkipGameData(BinaryFile& file)
+{
+    auto size = file.ReadUnsignedInt();
+    if(size == 1u) // Compressed flag
+    {
+        file.ReadUnsignedInt(); // Uncompressed size
+        size = file.ReadUnsignedInt();
+    }
+    file.Seek(size, SEEK_CUR);
+}
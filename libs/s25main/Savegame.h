@@ -14,6 +14,8 @@ enum class SaveGameDataToLoad
 {
     Header,
     HeaderAndSettings,
+    /// Header, settings and the index of the game data which is skipped
+    HeaderSettingsAndIndex,
     All
 };
 
@@ -44,6 +46,9 @@ public:
     SerializedGameData sgd;
 
 protected:
+    void WriteIndex(BinaryFile& file);
+    void ReadIndex(BinaryFile& file);
     void WriteGameData(BinaryFile& file);
     bool ReadGameData(BinaryFile& file);
+    void SkipGameData(BinaryFile& file);
 };
@@ -102,7 +102,8 @@
 /// 9: Drop serialization of node BQ
 /// 10: troop_limits state introduced to military buildings
 /// 11: wineaddon added, three new building types and two new goods
-static const unsigned currentGameDataVersion = 11;
+/// 12: Map nodes stored as planes of values for all nodes followed by the FoW data and objects of all nodes
+static const unsigned currentGameDataVersion = 12;
 // clang-format on
 
 std::unique_ptr<GameObject> SerializedGameData::Create_GameObject(const GO_Type got, const unsigned obj_id)
@@ -201,7 +202,7 @@ std::unique_ptr<FOWObject> SerializedGameData::Create_FOWObject(const FoW_Type f
 }
 
 SerializedGameData::SerializedGameData()
-    : debugMode(false), expectedNumObjects(0), em(nullptr), writeEm(nullptr), isReading(false)
+    : debugMode(false), expectedNumObjects(0), nestedObjectsSize(0), em(nullptr), writeEm(nullptr), isReading(false)
 {}
 
 void SerializedGameData::Prepare(bool reading)
@@ -224,12 +225,20 @@ void SerializedGameData::Prepare(bool reading)
     writtenObjIds.clear();
     readObjects.clear();
     expectedNumObjects = 0;
+    nestedObjectsSize = 0;
     isReading = reading;
 }
 
+void SerializedGameData::AddSection(const GameDataIndex::SectionType type, const unsigned player,
+                                    const unsigned offset)
+{
+    index.sections.push_back({type, player, offset, GetLength() - offset});
+}
+
 void SerializedGameData::MakeSnapshot(const Game& game)
 {
     Prepare(false);
+    index.clear();
 
     const GameWorldBase& gw = game.world_;
     writeEm = &gw.GetEvMgr();
@@ -239,19 +248,33 @@ void SerializedGameData::MakeSnapshot(const Game& game)
     PushUnsignedInt(expectedNumObjects);
 
     // World and objects
+    unsigned sectionStart = GetLength();
     MapSerializer::Serialize(gw, *this);
+    AddSection(GameDataIndex::SectionType::World, 0, sectionStart);
     // EventManager
+    sectionStart = GetLength();
     writeEm->Serialize(*this);
+    AddSection(GameDataIndex::SectionType::Events, 0, sectionStart);
+    for(const GameEvent* ev : writeEm->GetEvents())
+    {
+        index.events.push_back(
+          {ev->GetInstanceId(), ev->startGF, ev->length, ev->id, ev->obj->GetGOT(), ev->obj->GetObjId()});
+    }
     if(game.ggs_.objective == GameObjective::EconomyMode)
     {
+        sectionStart = GetLength();
         PushObject(gw.getEconHandler(), true);
+        AddSection(GameDataIndex::SectionType::EconomyMode, 0, sectionStart);
     }
     // Spieler serialisieren
     for(unsigned i = 0; i < gw.GetNumPlayers(); ++i)
     {
         if(debugMode)
             LOG.write("Start serializing player %1% at %2%\n") % i % GetLength();
+        sectionStart = GetLength();
         gw.GetPlayer(i).Serialize(*this);
+        AddSection(GameDataIndex::SectionType::Player, i, sectionStart);
+        index.inventories.push_back(gw.GetPlayer(i).GetInventory());
         if(debugMode)
             LOG.write("Done serializing player %1% at %2%\n") % i % GetLength();
     }
@@ -365,6 +388,10 @@ void SerializedGameData::PushObject_(const GameObject* go, const bool known)
 
     RTTR_Assert(writtenObjIds.size() < GameObject::GetNumObjs());
 
+    const unsigned startLength = GetLength();
+    const unsigned outerNestedObjectsSize = nestedObjectsSize;
+    nestedObjectsSize = 0;
+
     // Objekt nich bekannt? Dann Type-ID noch mit drauf
     if(!known)
         PushEnum<uint16_t>(go->GetGOT());
@@ -378,6 +405,12 @@ void SerializedGameData::PushObject_(const GameObject* go, const bool known)
 
     // Sicherheitscode reinschreiben
     PushUnsignedShort(GetSafetyCode(*go));
+
+    const unsigned size = GetLength() - startLength;
+    GameDataIndex::ObjectStats& stats = index.objects[go->GetGOT()];
+    stats.count++;
+    stats.size += size - nestedObjectsSize;
+    nestedObjectsSize = outerNestedObjectsSize + size;
 }
 
 void SerializedGameData::PushEvent(const GameEvent* event)
@@ -455,6 +488,14 @@ std::unique_ptr<FOWObject> SerializedGameData::PopFOWObject()
     return Create_FOWObject(type);
 }
 
+const uint8_t* SerializedGameData::PopBlock(const unsigned expectedSize)
+{
+    const unsigned size = PopUnsignedInt();
+    if(size != expectedSize)
+        throw Error(helpers::format("Invalid block size. Expected: %1%, got: %2%", expectedSize, size));
+    return static_cast<const uint8_t*>(static_cast<const void*>(PopAndDiscard(size)));
+}
+
 GameObject* SerializedGameData::PopObject_(helpers::OptionalEnum<GO_Type> got)
 {
     RTTR_Assert(isReading);
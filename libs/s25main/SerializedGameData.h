@@ -5,6 +5,7 @@
 #pragma once
 
 #include "FOWObjects.h"
+#include "GameDataIndex.h"
 #include "RTTR_Assert.h"
 #include "helpers/MaxEnumValue.h"
 #include "helpers/OptionalEnum.h"
@@ -22,6 +23,7 @@
 #include <set>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 class GameObject;
 class EventManager;
@@ -89,6 +91,10 @@ public:
     /// See `currentGameDataVersion` in SerializedGameData.cpp for version history
     unsigned GetGameDataVersion() const { return gameDataVersion; }
 
+    /// Summary of the data collected by MakeSnapshot or set when loading a savegame
+    const GameDataIndex& GetIndex() const { return index; }
+    void SetIndex(GameDataIndex newIndex) { index = std::move(newIndex); }
+
     //////////////////////////////////////////////////////////////////////////
     // Write methods
     //////////////////////////////////////////////////////////////////////////
@@ -155,6 +161,11 @@ public:
     /// FoW-Objekt
     std::unique_ptr<FOWObject> PopFOWObject();
 
+    /// Read a block of plain data with a single size header, e.g. one value for every node of the map.
+    /// The size must match the given one.
+    /// Returns the data in the buffer without copying it, so it is only valid as long as the buffer is not changed.
+    const uint8_t* PopBlock(unsigned expectedSize);
+
     /// Read a container of GameObjects
     template<typename T>
     void PopObjectContainer(T& gos, helpers::OptionalEnum<GO_Type> got = {});
@@ -200,6 +211,10 @@ private:
     /// Expected number of objects to be read/written
     unsigned expectedNumObjects;
 
+    GameDataIndex index;
+    /// Size of the objects written inside of the object currently written (-> only valid during writing)
+    unsigned nestedObjectsSize;
+
     /// EventManager, used during deserialization to add events, nullptr otherwise
     EventManager* em;
     /// EventManager, used during serialization to add events, nullptr otherwise
@@ -209,6 +224,8 @@ private:
 
     /// Starts reading or writing according to the param
     void Prepare(bool reading);
+    /// Add a section from the given offset to the current end of the data to the index
+    void AddSection(GameDataIndex::SectionType type, unsigned player, unsigned offset);
     /// Erzeugt GameObject
     std::unique_ptr<GameObject> Create_GameObject(GO_Type got, unsigned obj_id);
     /// Erzeugt FOWObject
@@ -0,0 +1,305 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "StatisticsHistory.h"
+#include "RTTR_Assert.h"
+#include "helpers/EnumRange.h"
+#include "helpers/format.hpp"
+#include "gameTypes/CompressedData.h"
+#include "s25util/Log.h"
+#include <algorithm>
+#include <array>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+constexpr std::array<char, 8> magic = {'R', 'T', 'T', 'R', 'S', 'T', 'A', 'T'};
+constexpr uint16_t version = 1;
+constexpr unsigned numTypes = helpers::NumEnumValues_v<StatisticType>;
+
+void writeUInt(std::ostream& out, uint32_t value, unsigned numBytes = sizeof(uint32_t))
+{
+    for(unsigned i = 0; i < numBytes; i++, value >>= 8)
+        out.put(static_cast<char>(value & 0xFF));
+}
+
+bool tryReadUInt(std::istream& in, uint32_t& value, unsigned numBytes = sizeof(uint32_t))
+{
+    std::array<unsigned char, sizeof(uint32_t)> bytes;
+    if(!in.read(reinterpret_cast<char*>(bytes.data()), numBytes))
+        return false;
+    value = 0;
+    for(unsigned i = numBytes; i-- > 0;)
+        value = (value << 8) | bytes[i];
+    return true;
+}
+
+uint32_t readUInt(std::istream& in, unsigned numBytes = sizeof(uint32_t))
+{
+    uint32_t value;
+    if(!tryReadUInt(in, value, numBytes))
+        throw std::runtime_error("Unexpected end of statistics file");
+    return value;
+}
+
+uint32_t getUInt(const std::vector<char>& data, size_t offset)
+{
+    if(offset + sizeof(uint32_t) > data.size())
+        throw std::runtime_error("Corrupt statistics chunk");
+    uint32_t value = 0;
+    for(unsigned i = sizeof(uint32_t); i-- > 0;)
+        value = (value << 8) | static_cast<unsigned char>(data[offset + i]);
+    return value;
+}
+
+/// Append the difference of the values as a zigzag varint, so small changes in both directions take few bytes
+void encodeDelta(std::vector<char>& out, uint32_t lastValue, uint32_t value)
+{
+    const auto delta = static_cast<int32_t>(value - lastValue);
+    uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+    for(; zigzag >= 0x80; zigzag >>= 7)
+        out.push_back(static_cast<char>((zigzag & 0x7F) | 0x80));
+    out.push_back(static_cast<char>(zigzag));
+}
+
+std::string quoteCsv(const std::string& value)
+{
+    std::string result = "\"";
+    for(const char c : value)
+    {
+        if(c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + '"';
+}
+} // namespace
+
+StatisticsRecorder::StatisticsRecorder(const boost::filesystem::path& filePath,
+                                       const std::vector<std::string>& playerNames, unsigned interval,
+                                       unsigned rowsPerChunk)
+    : file_(filePath, std::ios::binary), interval_(std::max(1u, interval)), numPlayers_(playerNames.size()),
+      rowsPerChunk_(std::max(1u, rowsPerChunk)), values_(numPlayers_ * numTypes * rowsPerChunk_)
+{
+    if(!file_)
+        throw std::runtime_error(helpers::format("Could not open %1% for writing", filePath));
+    RTTR_Assert(numPlayers_ <= 0xFF);
+    file_.write(magic.data(), magic.size());
+    writeUInt(file_, version, sizeof(version));
+    writeUInt(file_, interval_);
+    writeUInt(file_, numPlayers_, 1);
+    for(const std::string& name : playerNames)
+    {
+        const unsigned len = std::min<size_t>(name.size(), 0xFF);
+        writeUInt(file_, len, 1);
+        file_.write(name.data(), len);
+    }
+    file_.flush();
+    if(!file_)
+        throw std::runtime_error(helpers::format("Could not write to %1%", filePath));
+}
+
+StatisticsRecorder::~StatisticsRecorder()
+{
+    try
+    {
+        flush();
+    } catch(const std::exception& e)
+    {
+        LOG.write("Could not write statistics: %1%\n") % e.what();
+    }
+}
+
+void StatisticsRecorder::addRow(const unsigned gf, const std::vector<StatisticValues>& values)
+{
+    RTTR_Assert(values.size() == numPlayers_);
+    // Rows of a chunk are consecutive, start a new one if some were skipped
+    if(numRows_ > 0 && gf != firstGF_ + numRows_ * interval_)
+        flush();
+    if(numRows_ == 0)
+        firstGF_ = gf;
+    for(unsigned player = 0; player < numPlayers_; player++)
+    {
+        for(const auto type : helpers::enumRange<StatisticType>())
+        {
+            const unsigned column = player * numTypes + static_cast<unsigned>(type);
+            values_[column * rowsPerChunk_ + numRows_] = values[player][type];
+        }
+    }
+    if(++numRows_ == rowsPerChunk_)
+        flush();
+}
+
+void StatisticsRecorder::flush()
+{
+    if(numRows_ == 0)
+        return;
+    const unsigned numColumns = numPlayers_ * numTypes;
+    std::vector<char> data(numColumns * sizeof(uint32_t));
+    for(unsigned column = 0; column < numColumns; column++)
+    {
+        const auto* columnValues = &values_[column * rowsPerChunk_];
+        uint32_t lastValue = 0;
+        for(unsigned row = 0; row < numRows_; row++)
+        {
+            encodeDelta(data, lastValue, columnValues[row]);
+            lastValue = columnValues[row];
+        }
+        // Store the end offset of the column
+        for(unsigned i = 0; i < sizeof(uint32_t); i++)
+            data[column * sizeof(uint32_t) + i] = static_cast<char>((data.size() >> (i * 8)) & 0xFF);
+    }
+    const std::vector<char> compressedData = CompressedData::compress(data);
+    writeUInt(file_, firstGF_);
+    writeUInt(file_, numRows_);
+    writeUInt(file_, data.size());
+    writeUInt(file_, compressedData.size());
+    file_.write(compressedData.data(), compressedData.size());
+    file_.flush();
+    numRows_ = 0;
+    if(!file_)
+        throw std::runtime_error("Writing the statistics chunk failed");
+}
+
+StatisticsReader::StatisticsReader(const boost::filesystem::path& filePath) : filePath_(filePath)
+{
+    boost::nowide::ifstream file(filePath_, std::ios::binary | std::ios::ate);
+    if(!file)
+        throw std::runtime_error(helpers::format("Could not open %1%", filePath_));
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0);
+
+    std::array<char, magic.size()> fileMagic;
+    if(!file.read(fileMagic.data(), fileMagic.size()) || fileMagic != magic)
+        throw std::runtime_error(helpers::format("%1% is not a statistics file", filePath_));
+    const uint32_t fileVersion = readUInt(file, sizeof(version));
+    if(fileVersion != version)
+        throw std::runtime_error(helpers::format("Unsupported statistics file version %1%", fileVersion));
+    interval_ = readUInt(file);
+    playerNames_.resize(readUInt(file, 1));
+    for(std::string& name : playerNames_)
+    {
+        name.resize(readUInt(file, 1));
+        if(!file.read(&name[0], name.size()))
+            throw std::runtime_error("Unexpected end of statistics file");
+    }
+
+    Chunk chunk;
+    // An incomplete last chunk (e.g. after a crash) is ignored
+    while(tryReadUInt(file, chunk.firstGF) && tryReadUInt(file, chunk.numRows)
+          && tryReadUInt(file, chunk.uncompressedSize) && tryReadUInt(file, chunk.compressedSize))
+    {
+        chunk.offset = file.tellg();
+        if(chunk.offset + chunk.compressedSize > fileSize)
+            break;
+        chunks_.push_back(chunk);
+        numRows_ += chunk.numRows;
+        file.seekg(chunk.compressedSize, std::ios::cur);
+    }
+}
+
+std::vector<unsigned> StatisticsReader::readGFs() const
+{
+    std::vector<unsigned> result;
+    result.reserve(numRows_);
+    for(const Chunk& chunk : chunks_)
+    {
+        for(unsigned row = 0; row < chunk.numRows; row++)
+            result.push_back(chunk.firstGF + row * interval_);
+    }
+    return result;
+}
+
+std::vector<uint32_t> StatisticsReader::readColumn(const unsigned player, const StatisticType type) const
+{
+    RTTR_Assert(player < getNumPlayers());
+    std::vector<uint32_t> result;
+    result.reserve(numRows_);
+    for(const Chunk& chunk : chunks_)
+        decodeColumn(chunk, readChunk(chunk), player * numTypes + static_cast<unsigned>(type), result);
+    return result;
+}
+
+void StatisticsReader::exportCsv(std::ostream& out) const
+{
+    out << "gf,player,name";
+    for(const auto type : helpers::enumRange<StatisticType>())
+        out << ',' << getName(type);
+    out << '\n';
+
+    const unsigned numColumns = getNumPlayers() * numTypes;
+    std::vector<std::vector<uint32_t>> columns(numColumns);
+    for(const Chunk& chunk : chunks_)
+    {
+        const std::vector<char> data = readChunk(chunk);
+        for(unsigned column = 0; column < numColumns; column++)
+        {
+            columns[column].clear();
+            decodeColumn(chunk, data, column, columns[column]);
+        }
+        for(unsigned row = 0; row < chunk.numRows; row++)
+        {
+            for(unsigned player = 0; player < getNumPlayers(); player++)
+            {
+                out << chunk.firstGF + row * interval_ << ',' << player << ',' << quoteCsv(playerNames_[player]);
+                for(unsigned type = 0; type < numTypes; type++)
+                    out << ',' << columns[player * numTypes + type][row];
+                out << '\n';
+            }
+        }
+    }
+}
+
+const char* StatisticsReader::getName(const StatisticType type)
+{
+    switch(type)
+    {
+        case StatisticType::Country: return "country";
+        case StatisticType::Buildings: return "buildings";
+        case StatisticType::Inhabitants: return "inhabitants";
+        case StatisticType::Merchandise: return "merchandise";
+        case StatisticType::Military: return "military";
+        case StatisticType::Gold: return "gold";
+        case StatisticType::Productivity: return "productivity";
+        case StatisticType::Vanquished: return "vanquished";
+        case StatisticType::Tournament: return "tournament";
+    }
+    return "unknown";
+}
+
+std::vector<char> StatisticsReader::readChunk(const Chunk& chunk) const
+{
+    boost::nowide::ifstream file(filePath_, std::ios::binary);
+    std::vector<char> compressedData(chunk.compressedSize);
+    if(!file.seekg(chunk.offset) || !file.read(compressedData.data(), compressedData.size()))
+        throw std::runtime_error(helpers::format("Could not read from %1%", filePath_));
+    return CompressedData::decompress(compressedData, chunk.uncompressedSize);
+}
+
+void StatisticsReader::decodeColumn(const Chunk& chunk, const std::vector<char>& data, const unsigned column,
+                                    std::vector<uint32_t>& result) const
+{
+    const size_t begin = column == 0 ? getNumPlayers() * numTypes * sizeof(uint32_t) :
+                                       getUInt(data, (column - 1) * sizeof(uint32_t));
+    const size_t end = getUInt(data, column * sizeof(uint32_t));
+    if(begin > end || end > data.size())
+        throw std::runtime_error("Corrupt statistics chunk");
+    size_t pos = begin;
+    uint32_t value = 0;
+    for(unsigned row = 0; row < chunk.numRows; row++)
+    {
+        uint32_t zigzag = 0;
+        for(unsigned shift = 0;; shift += 7)
+        {
+            if(pos >= end || shift > 28)
+                throw std::runtime_error("Corrupt statistics chunk");
+            const auto byte = static_cast<unsigned char>(data[pos++]);
+            zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if(!(byte & 0x80))
+                break;
+        }
+        value += (zigzag >> 1) ^ (0u - (zigzag & 1u));
+        result.push_back(value);
+    }
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/EnumArray.h"
+#include "gameTypes/StatisticTypes.h"
+#include <boost/filesystem/path.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Values of all statistic types of one player
+using StatisticValues = helpers::EnumArray<uint32_t, StatisticType>;
+
+/// Records the statistic values of all players in a sidecar file with a column per player and statistic type.
+/// The rows are collected in chunks which are written compressed when full, so the memory use doesn't depend on the
+/// length of the game.
+///
+/// File format (all integers little endian):
+///  - Header: "RTTRSTAT", version (u16), interval in GFs (u32), number of players (u8),
+///    player names (u8 length + chars)
+///  - Chunks: GF of the first row, number of rows, uncompressed size, compressed size (all u32), bzip2 data
+///  - Uncompressed chunk: End offset of each column (u32) followed by the columns. A column holds the differences
+///    between consecutive values as zigzag varints.
+class StatisticsRecorder
+{
+public:
+    /// Record the statistics every interval GFs and write a chunk every rowsPerChunk rows. Throws on failure.
+    StatisticsRecorder(const boost::filesystem::path& filePath, const std::vector<std::string>& playerNames,
+                       unsigned interval = 1, unsigned rowsPerChunk = 4096);
+    ~StatisticsRecorder();
+
+    unsigned getInterval() const { return interval_; }
+    /// Return whether a row should be recorded in the given GF
+    bool isDue(unsigned gf) const { return gf % interval_ == 0; }
+    /// Add the values of all players in the given GF. Rows must be added in order.
+    void addRow(unsigned gf, const std::vector<StatisticValues>& values);
+    /// Write the collected rows. Throws on failure.
+    void flush();
+
+private:
+    boost::nowide::ofstream file_;
+    const unsigned interval_;
+    const unsigned numPlayers_;
+    const unsigned rowsPerChunk_;
+    unsigned firstGF_ = 0;
+    unsigned numRows_ = 0;
+    /// Values of the current chunk, column-major
+    std::vector<uint32_t> values_;
+};
+
+/// Reads a file written by the StatisticsRecorder. Only the chunk headers are kept in memory.
+class StatisticsReader
+{
+public:
+    /// Open the file and read the chunk headers. Throws on failure.
+    explicit StatisticsReader(const boost::filesystem::path& filePath);
+
+    unsigned getInterval() const { return interval_; }
+    unsigned getNumPlayers() const { return playerNames_.size(); }
+    const std::string& getPlayerName(unsigned player) const { return playerNames_[player]; }
+    unsigned getNumRows() const { return numRows_; }
+
+    /// GFs of all rows
+    std::vector<unsigned> readGFs() const;
+    /// Values of the statistic of the player for all rows
+    std::vector<uint32_t> readColumn(unsigned player, StatisticType type) const;
+    /// Write all rows as CSV with one line per GF and player. Processes one chunk at a time.
+    void exportCsv(std::ostream& out) const;
+
+    static const char* getName(StatisticType type);
+
+private:
+    struct Chunk
+    {
+        std::streamoff offset;
+        unsigned firstGF, numRows, uncompressedSize, compressedSize;
+    };
+    /// Decompressed data of the chunk
+    std::vector<char> readChunk(const Chunk& chunk) const;
+    /// Decode the column of the chunk appending the values to result
+    void decodeColumn(const Chunk& chunk, const std::vector<char>& data, unsigned column,
+                      std::vector<uint32_t>& result) const;
+
+    boost::filesystem::path filePath_;
+    unsigned interval_;
+    std::vector<std::string> playerNames_;
+    std::vector<Chunk> chunks_;
+    unsigned numRows_ = 0;
+};
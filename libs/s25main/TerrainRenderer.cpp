@@ -40,8 +40,12 @@
  *  - gl_texCoords: Texture coordinates for the triangle
  *  - gl_colors: Color (shade) at each point of the triangle
  *
- * Drawing then binds a texture and draws all adjacent vertices with the same texture in one call by
- * providing an index and a count into the above arrays.
+ * The map is split into chunks of CHUNK_SIZE x CHUNK_SIZE nodes. All triangles of one chunk (including the border
+ * triangles) are stored consecutively in those arrays and sorted by texture.
+ *
+ * Drawing then binds a texture and draws the triangles with that texture of every visible chunk with one call per chunk
+ * by providing an index and a count into the above arrays.
+ * Changes to the vertex data only mark their chunk as changed. Changed chunks are uploaded once before drawing.
  */
 
 glArchivItem_Bitmap* new_clone(const glArchivItem_Bitmap& bmp)
@@ -262,9 +266,18 @@ void TerrainRenderer::Init(const MapExtent& size)
     vertices.clear();
     terrain.clear();
     borders.clear();
+    triangleOffsets.clear();
     vertices.resize(size_.x * size_.y);
     terrain.resize(vertices.size());
     borders.resize(size_.x * size_.y);
+    triangleOffsets.resize(vertices.size());
+
+    numChunks_ = Extent(helpers::divCeil(size_.x, CHUNK_SIZE), helpers::divCeil(size_.y, CHUNK_SIZE));
+    chunks.clear();
+    chunks.resize(prodOfComponents(numChunks_));
+    chunkChanges.clear();
+    chunkChanges.resize(chunks.size());
+    changedChunks.clear();
 
     gl_vertices.clear();
     gl_texcoords.clear();
@@ -296,8 +309,7 @@ void TerrainRenderer::GenerateOpenGL(const GameWorldViewer& gwv)
     const WorldDescription& desc = world.GetDescription();
     LoadTextures(desc);
 
-    // Add extra vertices for borders
-    unsigned numTriangles = gl_vertices.size();
+    // Determine the borders, their triangles are added in GenerateChunks
     RTTR_FOREACH_PT(MapPoint, size_)
     {
         const unsigned pos = GetVertexIdx(pt);
@@ -306,40 +318,30 @@ void TerrainRenderer::GenerateOpenGL(const GameWorldViewer& gwv)
         const TerrainDesc& t3 = desc.get(terrain[GetVertexIdx(GetNeighbour(pt, Direction::East))][0]);
         const TerrainDesc& t4 = desc.get(terrain[GetVertexIdx(GetNeighbour(pt, Direction::SouthWest))][1]);
 
-        if((borders[pos].left_right[0] = GetEdgeType(t2, t1)))
-            borders[pos].left_right_offset[0] = numTriangles++;
-        if((borders[pos].left_right[1] = GetEdgeType(t1, t2)))
-            borders[pos].left_right_offset[1] = numTriangles++;
-
-        if((borders[pos].right_left[0] = GetEdgeType(t3, t2)))
-            borders[pos].right_left_offset[0] = numTriangles++;
-        if((borders[pos].right_left[1] = GetEdgeType(t2, t3)))
-            borders[pos].right_left_offset[1] = numTriangles++;
-
-        if((borders[pos].top_down[0] = GetEdgeType(t4, t1)))
-            borders[pos].top_down_offset[0] = numTriangles++;
-        if((borders[pos].top_down[1] = GetEdgeType(t1, t4)))
-            borders[pos].top_down_offset[1] = numTriangles++;
+        borders[pos].left_right[0] = GetEdgeType(t2, t1);
+        borders[pos].left_right[1] = GetEdgeType(t1, t2);
+        borders[pos].right_left[0] = GetEdgeType(t3, t2);
+        borders[pos].right_left[1] = GetEdgeType(t2, t3);
+        borders[pos].top_down[0] = GetEdgeType(t4, t1);
+        borders[pos].top_down[1] = GetEdgeType(t1, t4);
     }
 
-    gl_vertices.resize(numTriangles);
-    gl_texcoords.resize(numTriangles);
-    gl_colors.resize(numTriangles);
+    GenerateChunks();
 
     // Normales Terrain erzeugen
     RTTR_FOREACH_PT(MapPoint, size_)
     {
-        UpdateTrianglePos(pt, false);
-        UpdateTriangleColor(pt, false);
-        UpdateTriangleTerrain(pt, false);
+        UpdateTrianglePos(pt);
+        UpdateTriangleColor(pt);
+        UpdateTriangleTerrain(pt);
     }
 
     // Ränder erzeugen
     RTTR_FOREACH_PT(MapPoint, size_)
     {
-        UpdateBorderTrianglePos(pt, false);
-        UpdateBorderTriangleColor(pt, false);
-        UpdateBorderTriangleTerrain(pt, false);
+        UpdateBorderTrianglePos(pt);
+        UpdateBorderTriangleColor(pt);
+        UpdateBorderTriangleTerrain(pt);
     }
 
     if(SETTINGS.video.vbo)
@@ -359,82 +361,136 @@ void TerrainRenderer::GenerateOpenGL(const GameWorldViewer& gwv)
     }
 }
 
-void TerrainRenderer::UpdateTrianglePos(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::GenerateChunks()
 {
-    unsigned pos = GetTriangleIdx(pt);
+    // Counting sort of all triangles of a chunk by their texture
+    unsigned numTriangles = 0;
+    for(unsigned cy = 0; cy < numChunks_.y; ++cy)
+    {
+        for(unsigned cx = 0; cx < numChunks_.x; ++cx)
+        {
+            Chunk& chunk = chunks[cy * numChunks_.x + cx];
+            chunk.terrainRanges.clear();
+            chunk.terrainRanges.resize(terrainTextures.size());
+            chunk.edgeRanges.clear();
+            chunk.edgeRanges.resize(edgeTextures.size());
+
+            const MapPoint chunkStart(cx * CHUNK_SIZE, cy * CHUNK_SIZE);
+            const MapPoint chunkEnd(std::min<unsigned>(chunkStart.x + CHUNK_SIZE, size_.x),
+                                    std::min<unsigned>(chunkStart.y + CHUNK_SIZE, size_.y));
+            const auto forEachPtInChunk = [&](auto&& func) {
+                for(MapPoint pt(0, chunkStart.y); pt.y < chunkEnd.y; ++pt.y)
+                {
+                    for(pt.x = chunkStart.x; pt.x < chunkEnd.x; ++pt.x)
+                        func(pt, GetVertexIdx(pt));
+                }
+            };
+            const auto forEachBorder = [](Borders& curBorders, auto&& func) {
+                for(unsigned char i = 0; i < 2; ++i)
+                {
+                    if(curBorders.left_right[i])
+                        func(curBorders.left_right[i], curBorders.left_right_offset[i]);
+                }
+                for(unsigned char i = 0; i < 2; ++i)
+                {
+                    if(curBorders.right_left[i])
+                        func(curBorders.right_left[i], curBorders.right_left_offset[i]);
+                }
+                for(unsigned char i = 0; i < 2; ++i)
+                {
+                    if(curBorders.top_down[i])
+                        func(curBorders.top_down[i], curBorders.top_down_offset[i]);
+                }
+            };
 
-    gl_vertices[pos][0] = GetVertexPos(pt);
-    gl_vertices[pos][1] = GetNeighbourVertexPos(pt, Direction::SouthWest);
-    gl_vertices[pos][2] = GetNeighbourVertexPos(pt, Direction::SouthEast);
+            forEachPtInChunk([&](MapPoint, unsigned pos) {
+                for(const DescIdx<TerrainDesc> t : terrain[pos])
+                    ++chunk.terrainRanges[t].count;
+                forEachBorder(borders[pos], [&](DescIdx<EdgeDesc> edge, unsigned) { ++chunk.edgeRanges[edge].count; });
+            });
 
-    ++pos;
+            chunk.triangles.first = numTriangles;
+            for(DrawRange& range : chunk.terrainRanges)
+            {
+                range.first = numTriangles;
+                numTriangles += range.count;
+            }
+            for(DrawRange& range : chunk.edgeRanges)
+            {
+                range.first = numTriangles;
+                numTriangles += range.count;
+            }
+            chunk.triangles.count = numTriangles - chunk.triangles.first;
+
+            // Assign the offsets using the (now known) start of each range
+            DescriptionVector<unsigned, TerrainDesc> nextTerrainOffset(terrainTextures.size());
+            for(const auto t : chunk.terrainRanges.indices())
+                nextTerrainOffset[t] = chunk.terrainRanges[t].first;
+            DescriptionVector<unsigned, EdgeDesc> nextEdgeOffset(edgeTextures.size());
+            for(const auto edge : chunk.edgeRanges.indices())
+                nextEdgeOffset[edge] = chunk.edgeRanges[edge].first;
+
+            forEachPtInChunk([&](MapPoint, unsigned pos) {
+                for(unsigned i = 0; i < 2; ++i)
+                    triangleOffsets[pos][i] = nextTerrainOffset[terrain[pos][i]]++;
+                forEachBorder(borders[pos],
+                              [&](DescIdx<EdgeDesc> edge, unsigned& offset) { offset = nextEdgeOffset[edge]++; });
+            });
+        }
+    }
 
-    gl_vertices[pos][0] = GetVertexPos(pt);
-    gl_vertices[pos][1] = GetNeighbourVertexPos(pt, Direction::SouthEast);
-    gl_vertices[pos][2] = GetNeighbourVertexPos(pt, Direction::East);
+    gl_vertices.resize(numTriangles);
+    gl_texcoords.resize(numTriangles);
+    gl_colors.resize(numTriangles);
+}
 
-    if(updateVBO && vbo_vertices.isValid())
-    {
-        vbo_vertices.update(&gl_vertices[pos - 1], 2, pos - 1);
-        vbo_vertices.unbind();
-    }
+void TerrainRenderer::UpdateTrianglePos(const MapPoint pt)
+{
+    const std::array<unsigned, 2>& offsets = triangleOffsets[GetVertexIdx(pt)];
+
+    gl_vertices[offsets[0]][0] = GetVertexPos(pt);
+    gl_vertices[offsets[0]][1] = GetNeighbourVertexPos(pt, Direction::SouthWest);
+    gl_vertices[offsets[0]][2] = GetNeighbourVertexPos(pt, Direction::SouthEast);
+
+    gl_vertices[offsets[1]][0] = GetVertexPos(pt);
+    gl_vertices[offsets[1]][1] = GetNeighbourVertexPos(pt, Direction::SouthEast);
+    gl_vertices[offsets[1]][2] = GetNeighbourVertexPos(pt, Direction::East);
 }
 
-void TerrainRenderer::UpdateTriangleColor(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::UpdateTriangleColor(const MapPoint pt)
 {
-    unsigned pos = GetTriangleIdx(pt);
+    const std::array<unsigned, 2>& offsets = triangleOffsets[GetVertexIdx(pt)];
 
-    Color& clr0 = gl_colors[pos][0];
-    Color& clr1 = gl_colors[pos][1];
-    Color& clr2 = gl_colors[pos][2];
+    Color& clr0 = gl_colors[offsets[0]][0];
+    Color& clr1 = gl_colors[offsets[0]][1];
+    Color& clr2 = gl_colors[offsets[0]][2];
     clr0.r = clr0.g = clr0.b = GetColor(pt);
     clr1.r = clr1.g = clr1.b = GetColor(GetNeighbour(pt, Direction::SouthWest));
     clr2.r = clr2.g = clr2.b = GetColor(GetNeighbour(pt, Direction::SouthEast));
 
-    ++pos;
-
-    Color& clr3 = gl_colors[pos][0];
-    Color& clr4 = gl_colors[pos][1];
-    Color& clr5 = gl_colors[pos][2];
+    Color& clr3 = gl_colors[offsets[1]][0];
+    Color& clr4 = gl_colors[offsets[1]][1];
+    Color& clr5 = gl_colors[offsets[1]][2];
     clr3.r = clr3.g = clr3.b = GetColor(pt);
     clr4.r = clr4.g = clr4.b = GetColor(GetNeighbour(pt, Direction::SouthEast));
     clr5.r = clr5.g = clr5.b = GetColor(GetNeighbour(pt, Direction::East));
-
-    if(updateVBO && vbo_colors.isValid())
-    {
-        vbo_colors.update(&gl_colors[pos - 1], 2, pos - 1);
-        vbo_colors.unbind();
-    }
 }
 
-void TerrainRenderer::UpdateTriangleTerrain(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::UpdateTriangleTerrain(const MapPoint pt)
 {
     const unsigned nodeIdx = GetVertexIdx(pt);
     const DescIdx<TerrainDesc> t1 = terrain[nodeIdx][0];
     const DescIdx<TerrainDesc> t2 = terrain[nodeIdx][1];
 
-    const unsigned triangleIdx = GetTriangleIdx(pt);
-    gl_texcoords[triangleIdx] = terrainTextures[t1].rsuCoords;
-    gl_texcoords[triangleIdx + 1] = terrainTextures[t2].usdCoords;
-
-    if(updateVBO && vbo_texcoords.isValid())
-    {
-        vbo_texcoords.update(&gl_texcoords[triangleIdx - 1], 2, triangleIdx - 1);
-        vbo_texcoords.unbind();
-    }
+    gl_texcoords[triangleOffsets[nodeIdx][0]] = terrainTextures[t1].rsuCoords;
+    gl_texcoords[triangleOffsets[nodeIdx][1]] = terrainTextures[t2].usdCoords;
 }
 
 /// Erzeugt die Dreiecke für die Ränder
-void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt)
 {
     unsigned pos = GetVertexIdx(pt);
 
-    // Für VBO-Aktualisierung:
-    // Erzeugte Ränder zählen
-    unsigned count_borders = 0;
-    // Erstes Offset merken
-    unsigned first_offset = 0;
-
     // Rand links - rechts
     for(unsigned char i = 0; i < 2; ++i)
     {
@@ -442,14 +498,9 @@ void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
             continue;
         unsigned offset = borders[pos].left_right_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_vertices[offset][i ? 0 : 2] = GetVertexPos(pt);
         gl_vertices[offset][1] = GetNeighbourVertexPos(pt, Direction::SouthEast);
         gl_vertices[offset][i ? 2 : 0] = GetBorderPos(pt, i);
-
-        ++count_borders;
     }
 
     // Rand rechts - links
@@ -459,9 +510,6 @@ void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
             continue;
         unsigned offset = borders[pos].right_left_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_vertices[offset][i ? 2 : 0] = GetNeighbourVertexPos(pt, Direction::SouthEast);
         gl_vertices[offset][1] = GetNeighbourVertexPos(pt, Direction::East);
 
@@ -469,8 +517,6 @@ void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
             gl_vertices[offset][2] = GetBorderPos(pt, 1);
         else
             gl_vertices[offset][0] = GetNeighbourBorderPos(pt, 0, Direction::East);
-
-        ++count_borders;
     }
 
     // Rand oben - unten
@@ -480,9 +526,6 @@ void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
             continue;
         unsigned offset = borders[pos].top_down_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_vertices[offset][i ? 2 : 0] = GetNeighbourVertexPos(pt, Direction::SouthWest);
         gl_vertices[offset][1] = GetNeighbourVertexPos(pt, Direction::SouthEast);
 
@@ -490,27 +533,13 @@ void TerrainRenderer::UpdateBorderTrianglePos(const MapPoint pt, bool updateVBO)
             gl_vertices[offset][2] = GetBorderPos(pt, i);
         else
             gl_vertices[offset][0] = GetNeighbourBorderPos(pt, i, Direction::SouthWest);
-
-        ++count_borders;
-    }
-
-    if(updateVBO && vbo_vertices.isValid())
-    {
-        vbo_vertices.update(&gl_vertices[first_offset], count_borders, first_offset);
-        vbo_vertices.unbind();
     }
 }
 
-void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt)
 {
     unsigned pos = GetVertexIdx(pt);
 
-    // Für VBO-Aktualisierung:
-    // Erzeugte Ränder zählen
-    unsigned count_borders = 0;
-    // Erstes Offset merken
-    unsigned first_offset = 0;
-
     // Rand links - rechts
     for(unsigned char i = 0; i < 2; ++i)
     {
@@ -518,17 +547,12 @@ void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVB
             continue;
         unsigned offset = borders[pos].left_right_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_colors[offset][i ? 0 : 2].r = gl_colors[offset][i ? 0 : 2].g = gl_colors[offset][i ? 0 : 2].b =
           GetColor(pt); //-V807
         gl_colors[offset][1].r = gl_colors[offset][1].g = gl_colors[offset][1].b =
           GetColor(GetNeighbour(pt, Direction::SouthEast)); //-V807
         gl_colors[offset][i ? 2 : 0].r = gl_colors[offset][i ? 2 : 0].g = gl_colors[offset][i ? 2 : 0].b =
           GetBorderColor(pt, i); //-V807
-
-        ++count_borders;
     }
 
     // Rand rechts - links
@@ -538,9 +562,6 @@ void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVB
             continue;
         unsigned offset = borders[pos].right_left_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_colors[offset][i ? 2 : 0].r = gl_colors[offset][i ? 2 : 0].g = gl_colors[offset][i ? 2 : 0].b =
           GetColor(GetNeighbour(pt, Direction::SouthEast));
         gl_colors[offset][1].r = gl_colors[offset][1].g = gl_colors[offset][1].b =
@@ -550,8 +571,6 @@ void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVB
             pt2.x -= size_.x;
         gl_colors[offset][i ? 0 : 2].r = gl_colors[offset][i ? 0 : 2].g = gl_colors[offset][i ? 0 : 2].b =
           GetBorderColor(pt2, i ? 0 : 1);
-
-        ++count_borders;
     }
 
     // Rand oben - unten
@@ -561,9 +580,6 @@ void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVB
             continue;
         unsigned offset = borders[pos].top_down_offset[i];
 
-        if(!first_offset)
-            first_offset = offset;
-
         gl_colors[offset][i ? 2 : 0].r = gl_colors[offset][i ? 2 : 0].g = gl_colors[offset][i ? 2 : 0].b =
           GetColor(GetNeighbour(pt, Direction::SouthWest));
         gl_colors[offset][1].r = gl_colors[offset][1].g = gl_colors[offset][1].b =
@@ -574,25 +590,13 @@ void TerrainRenderer::UpdateBorderTriangleColor(const MapPoint pt, bool updateVB
         else
             gl_colors[offset][0].r = gl_colors[offset][0].g = gl_colors[offset][0].b =
               GetBorderColor(GetNeighbour(pt, Direction::SouthWest), i); //-V807
-
-        ++count_borders;
-    }
-
-    if(updateVBO && vbo_colors.isValid())
-    {
-        vbo_colors.update(&gl_colors[first_offset], count_borders, first_offset);
-        vbo_colors.unbind();
     }
 }
 
-void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool updateVBO)
+void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt)
 {
     unsigned pos = GetVertexIdx(pt);
 
-    // For updating the VBO count created borders and first offset
-    unsigned count_borders = 0;
-    unsigned first_offset = 0;
-
     // left to right border
     for(unsigned char i = 0; i < 2; ++i)
     {
@@ -600,9 +604,6 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
         {
             unsigned offset = borders[pos].left_right_offset[i];
 
-            if(!first_offset)
-                first_offset = offset;
-
             const glArchivItem_Bitmap& texture = *edgeTextures[borders[pos].left_right[i]];
             Extent bmpSize = texture.GetSize();
             PointF texSize(texture.GetTexSize());
@@ -610,8 +611,6 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
             gl_texcoords[offset][i ? 0 : 2] = PointF(0.0f, 0.0f);
             gl_texcoords[offset][1] = PointF(bmpSize.x / texSize.x, 0.0f);
             gl_texcoords[offset][i ? 2 : 0] = PointF(bmpSize.x / texSize.x / 2.f, bmpSize.y / texSize.y);
-
-            ++count_borders;
         }
     }
 
@@ -622,9 +621,6 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
         {
             unsigned offset = borders[pos].right_left_offset[i];
 
-            if(!first_offset)
-                first_offset = offset;
-
             const glArchivItem_Bitmap& texture = *edgeTextures[borders[pos].right_left[i]];
             Extent bmpSize = texture.GetSize();
             PointF texSize(texture.GetTexSize());
@@ -632,8 +628,6 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
             gl_texcoords[offset][i ? 2 : 0] = PointF(0.0f, 0.0f);
             gl_texcoords[offset][1] = PointF(bmpSize.x / texSize.x, 0.0f);
             gl_texcoords[offset][i ? 0 : 2] = PointF(bmpSize.x / texSize.x / 2.f, bmpSize.y / texSize.y);
-
-            ++count_borders;
         }
     }
 
@@ -644,9 +638,6 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
         {
             unsigned offset = borders[pos].top_down_offset[i];
 
-            if(!first_offset)
-                first_offset = offset;
-
             const glArchivItem_Bitmap& texture = *edgeTextures[borders[pos].top_down[i]];
             Extent bmpSize = texture.GetSize();
             PointF texSize(texture.GetTexSize());
@@ -654,16 +645,92 @@ void TerrainRenderer::UpdateBorderTriangleTerrain(const MapPoint pt, bool update
             gl_texcoords[offset][i ? 2 : 0] = PointF(0.0f, 0.0f);
             gl_texcoords[offset][1] = PointF(bmpSize.x / texSize.x, 0.0f);
             gl_texcoords[offset][i ? 0 : 2] = PointF(bmpSize.x / texSize.x / 2.f, bmpSize.y / texSize.y);
+        }
+    }
+}
 
-            ++count_borders;
+/// Return floor(dividend / divisor) for a positive divisor
+static int divFloor(int dividend, int divisor)
+{
+    const int result = dividend / divisor;
+    return (dividend % divisor < 0) ? result - 1 : result;
+}
+
+std::vector<TerrainRenderer::VisibleChunk> TerrainRenderer::GetVisibleChunks(const Position& firstPt,
+                                                                             const Position& lastPt) const
+{
+    std::vector<VisibleChunk> result;
+    const Position mapSize(size_);
+    // The drawn area may wrap around the map borders (even multiple times), so split it into the parts per map copy
+    for(int wrapY = divFloor(firstPt.y, mapSize.y); wrapY <= divFloor(lastPt.y, mapSize.y); ++wrapY)
+    {
+        const int startY = std::max(firstPt.y - wrapY * mapSize.y, 0);
+        const int endY = std::min(lastPt.y - wrapY * mapSize.y, mapSize.y - 1);
+        for(int wrapX = divFloor(firstPt.x, mapSize.x); wrapX <= divFloor(lastPt.x, mapSize.x); ++wrapX)
+        {
+            const int startX = std::max(firstPt.x - wrapX * mapSize.x, 0);
+            const int endX = std::min(lastPt.x - wrapX * mapSize.x, mapSize.x - 1);
+            const Position posOffset = Position(wrapX, wrapY) * mapSize * Position(TR_W, TR_H);
+            for(unsigned cy = startY / CHUNK_SIZE; cy <= endY / CHUNK_SIZE; ++cy)
+            {
+                for(unsigned cx = startX / CHUNK_SIZE; cx <= endX / CHUNK_SIZE; ++cx)
+                    result.push_back(VisibleChunk{&chunks[cy * numChunks_.x + cx], posOffset});
+            }
         }
     }
+    return result;
+}
 
-    if(updateVBO && vbo_texcoords.isValid())
+void TerrainRenderer::MarkChunkChanged(const MapPoint pt, uint8_t changes)
+{
+    // Without VBOs the data is used directly from the gl_* arrays
+    if(!vbo_vertices.isValid())
+        return;
+    const unsigned chunkIdx = GetChunkIdx(pt);
+    if(!chunkChanges[chunkIdx])
+        changedChunks.push_back(chunkIdx);
+    chunkChanges[chunkIdx] |= changes;
+}
+
+void TerrainRenderer::UploadChangedChunks() const
+{
+    if(changedChunks.empty())
+        return;
+    for(const unsigned chunkIdx : changedChunks)
+    {
+        const DrawRange& triangles = chunks[chunkIdx].triangles;
+        if(chunkChanges[chunkIdx] & CHANGED_POS)
+            vbo_vertices.update(&gl_vertices[triangles.first], triangles.count, triangles.first);
+        if(chunkChanges[chunkIdx] & CHANGED_COLOR)
+            vbo_colors.update(&gl_colors[triangles.first], triangles.count, triangles.first);
+        chunkChanges[chunkIdx] = 0;
+    }
+    changedChunks.clear();
+    vbo_colors.unbind();
+}
+
+unsigned TerrainRenderer::GetWaterPercentage(const Position& firstPt, const Position& lastPt,
+                                             const GameWorldBase& world)
+{
+    // Count the visible nodes only, not the whole chunks, so the value does not depend on off-screen terrain
+    const WorldDescription& desc = world.GetDescription();
+    unsigned water_count = 0;
+    for(auto const y : helpers::range(firstPt.y, lastPt.y + 1))
     {
-        vbo_texcoords.update(&gl_texcoords[first_offset], count_borders, first_offset);
-        vbo_texcoords.unbind();
+        for(auto const x : helpers::range(firstPt.x, lastPt.x + 1))
+        {
+            const MapNode& node = world.GetNode(world.MakeMapPoint(Position(x, y)));
+            if(desc.get(node.t1).kind == TerrainKind::Water)
+                ++water_count;
+            if(desc.get(node.t2).kind == TerrainKind::Water)
+                ++water_count;
+        }
     }
+
+    Position diff = lastPt - firstPt + Position(1, 1); // Number of points checked in X and Y, including(!) the last one
+    // For each point there are 2 tiles added (USD, RSU) so we have 2 times the tiles as the number of points.
+    // Calculate the percentage of water tiles
+    return 100 * water_count / (2 * prodOfComponents(diff));
 }
 
 void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, const GameWorldViewer& gwv,
@@ -672,106 +739,24 @@ void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, cons
     RTTR_Assert(!gl_vertices.empty());
     RTTR_Assert(!borders.empty());
 
-    // Sort textures into lists by type
-    DescriptionVector<std::vector<MapTile>, TerrainDesc> sorted_textures(terrainTextures.size());
-    DescriptionVector<std::vector<BorderTile>, EdgeDesc> sorted_borders(edgeTextures.size());
-    PreparedRoads sorted_roads(roadTextures.size());
+    UploadChangedChunks();
 
-    Position lastOffset(0, 0);
+    const std::vector<VisibleChunk> visibleChunks = GetVisibleChunks(firstPt, lastPt);
+
+    if(water)
+        *water = GetWaterPercentage(firstPt, lastPt, gwv.GetWorld());
 
-    // Only draw visible area
+    PreparedRoads sorted_roads(roadTextures.size());
     for(auto const y : helpers::range(firstPt.y, lastPt.y + 1))
     {
-        DescIdx<TerrainDesc> lastTerrain;
-        DescIdx<EdgeDesc> lastBorder;
-
         for(auto const x : helpers::range(firstPt.x, lastPt.x + 1))
         {
             Position posOffset;
             MapPoint tP = ConvertCoords(Position(x, y), &posOffset);
-
-            auto t = terrain[GetVertexIdx(tP)][0];
-            if(posOffset != lastOffset)
-                lastTerrain = DescIdx<TerrainDesc>();
-
-            if(t == lastTerrain && tP != MapPoint(0, 0))
-                ++sorted_textures[t].back().count;
-            else
-            {
-                MapTile tmp(GetTriangleIdx(tP), posOffset);
-                sorted_textures[t].push_back(tmp);
-                lastTerrain = t;
-            }
-
-            t = terrain[GetVertexIdx(tP)][1];
-
-            if(t == lastTerrain)
-                ++sorted_textures[t].back().count;
-            else
-            {
-                MapTile tmp(GetTriangleIdx(tP) + 1, posOffset);
-                sorted_textures[t].push_back(tmp);
-            }
-
-            lastTerrain = t;
-
-            const Borders& curBorders = borders[GetVertexIdx(tP)];
-            helpers::EnumArray<DescIdx<EdgeDesc>, Direction> tiles = {
-              {curBorders.left_right[0], curBorders.left_right[1], curBorders.right_left[0], curBorders.right_left[1],
-               curBorders.top_down[0], curBorders.top_down[1]}};
-
-            // Offsets into gl_* arrays
-            helpers::EnumArray<unsigned, Direction> offsets = {
-              {curBorders.left_right_offset[0], curBorders.left_right_offset[1], curBorders.right_left_offset[0],
-               curBorders.right_left_offset[1], curBorders.top_down_offset[0], curBorders.top_down_offset[1]}};
-
-            for(const auto dir : helpers::EnumRange<Direction>{})
-            {
-                if(!tiles[dir])
-                    continue;
-                if(tiles[dir] == lastBorder)
-                {
-                    BorderTile& curTile = sorted_borders[lastBorder].back();
-                    // Check that we did not wrap around the map and the expected offset matches
-                    if(curTile.tileOffset + curTile.count == offsets[dir])
-                    {
-                        ++curTile.count;
-                        continue;
-                    }
-                }
-                lastBorder = tiles[dir];
-                BorderTile tmp(offsets[dir], posOffset);
-                sorted_borders[lastBorder].push_back(tmp);
-            }
-
             PrepareWaysPoint(sorted_roads, gwv, tP, posOffset);
-
-            lastOffset = posOffset;
-        }
-    }
-
-    if(water)
-    {
-        const WorldDescription& desc = gwv.GetWorld().GetDescription();
-        unsigned water_count = 0;
-        for(const auto t : sorted_textures.indices())
-        {
-            if(desc.get(t).kind == TerrainKind::Water)
-            {
-                for(const MapTile& tile : sorted_textures[t])
-                    water_count += tile.count;
-            }
         }
-
-        Position diff =
-          lastPt - firstPt + Position(1, 1); // Number of points checked in X and Y, including(!) the last one
-        // For each point there are 2 tiles added (USD, RSU) so we have 2 times the tiles as the number of points.
-        // Calculate the percentage of water tiles
-        *water = 100 * water_count / (2 * prodOfComponents(diff));
     }
 
-    lastOffset = Position(0, 0);
-
     glEnableClientState(GL_COLOR_ARRAY);
 
     if(vbo_vertices.isValid())
@@ -798,32 +783,42 @@ void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, cons
     // Disable alpha blending
     glDisable(GL_BLEND);
 
+    Position lastOffset(0, 0);
+    const auto drawRange = [&lastOffset](const DrawRange& range, const Position& posOffset) {
+        if(posOffset != lastOffset)
+        {
+            Position trans = posOffset - lastOffset;
+            glTranslatef(float(trans.x), float(trans.y), 0.0f);
+            lastOffset = posOffset;
+        }
+        // Arguments are in elements. 1 triangle has 3 values
+        glDrawArrays(GL_TRIANGLES, range.first * 3, range.count * 3);
+    };
+
     glPushMatrix();
-    for(const auto t : sorted_textures.indices())
+    for(const auto t : terrainTextures.indices())
     {
-        if(sorted_textures[t].empty())
-            continue;
-        unsigned animationFrame;
-        const unsigned numFrames = terrainTextures[t].textures.size();
-        if(numFrames > 1)
-            animationFrame = GAMECLIENT.GetGlobalAnimation(numFrames, 5 * numFrames, 16, 0); // We have 5/16 per frame
-        else
-            animationFrame = 0;
-
-        VIDEODRIVER.BindTexture(terrainTextures[t].textures[animationFrame].GetTextureNoCreate());
-
-        for(const auto& texture : sorted_textures[t])
+        bool isBound = false;
+        for(const VisibleChunk& visChunk : visibleChunks)
         {
-            if(texture.posOffset != lastOffset)
+            const DrawRange& range = visChunk.chunk->terrainRanges[t];
+            if(!range.count)
+                continue;
+            if(!isBound)
             {
-                Position trans = texture.posOffset - lastOffset;
-                glTranslatef(float(trans.x), float(trans.y), 0.0f);
-                lastOffset = texture.posOffset;
-            }
+                unsigned animationFrame;
+                const unsigned numFrames = terrainTextures[t].textures.size();
+                if(numFrames > 1)
+                    animationFrame =
+                      GAMECLIENT.GetGlobalAnimation(numFrames, 5 * numFrames, 16, 0); // We have 5/16 per frame
+                else
+                    animationFrame = 0;
 
-            RTTR_Assert(texture.tileOffset + texture.count <= size_.x * size_.y * 2u);
-            glDrawArrays(GL_TRIANGLES, texture.tileOffset * 3,
-                         texture.count * 3); // Arguments are in Elements. 1 triangle has 3 values
+                VIDEODRIVER.BindTexture(terrainTextures[t].textures[animationFrame].GetTextureNoCreate());
+                isBound = true;
+            }
+            RTTR_Assert(range.first + range.count <= gl_vertices.size());
+            drawRange(range, visChunk.posOffset);
         }
     }
     glPopMatrix();
@@ -832,23 +827,21 @@ void TerrainRenderer::Draw(const Position& firstPt, const Position& lastPt, cons
 
     lastOffset = Position(0, 0);
     glPushMatrix();
-    for(const auto i : sorted_borders.indices())
+    for(const auto i : edgeTextures.indices())
     {
-        if(sorted_borders[i].empty())
-            continue;
-        VIDEODRIVER.BindTexture(edgeTextures[i]->GetTextureNoCreate());
-
-        for(const auto& texture : sorted_borders[i])
+        bool isBound = false;
+        for(const VisibleChunk& visChunk : visibleChunks)
         {
-            if(texture.posOffset != lastOffset)
+            const DrawRange& range = visChunk.chunk->edgeRanges[i];
+            if(!range.count)
+                continue;
+            if(!isBound)
             {
-                Position trans = texture.posOffset - lastOffset;
-                glTranslatef(float(trans.x), float(trans.y), 0.0f);
-                lastOffset = texture.posOffset;
+                VIDEODRIVER.BindTexture(edgeTextures[i]->GetTextureNoCreate());
+                isBound = true;
             }
-            RTTR_Assert(texture.tileOffset + texture.count <= gl_vertices.size());
-            glDrawArrays(GL_TRIANGLES, texture.tileOffset * 3,
-                         texture.count * 3); // Arguments are in elements. 1 triangle has 3 values
+            RTTR_Assert(range.first + range.count <= gl_vertices.size());
+            drawRange(range, visChunk.posOffset);
         }
     }
     glPopMatrix();
@@ -1047,32 +1040,30 @@ void TerrainRenderer::AltitudeChanged(const MapPoint pt, const GameWorldViewer&
         UpdateBorderVertex(nb);
 
     // den selbst sowieso die Punkte darum updaten, da sich bei letzteren die Schattierung geändert haben könnte
-    UpdateTrianglePos(pt, true);
-    UpdateTriangleColor(pt, true);
+    UpdateTrianglePos(pt);
+    UpdateTriangleColor(pt);
+    UpdateBorderTrianglePos(pt);
+    UpdateBorderTriangleColor(pt);
+    MarkChunkChanged(pt, CHANGED_POS | CHANGED_COLOR);
 
     for(const MapPoint nb : gwv.GetNeighbours(pt))
     {
-        UpdateTrianglePos(nb, true);
-        UpdateTriangleColor(nb, true);
+        UpdateTrianglePos(nb);
+        UpdateTriangleColor(nb);
+        UpdateBorderTrianglePos(nb);
+        UpdateBorderTriangleColor(nb);
+        MarkChunkChanged(nb, CHANGED_POS | CHANGED_COLOR);
     }
 
     // Auch im zweiten Kreis drumherum die Dreiecke neu berechnen, da die durch die Schattenänderung der umliegenden
     // Punkte auch geändert werden könnten
     for(unsigned i = 0; i < 12; ++i)
-        UpdateTriangleColor(gwv.GetWorld().GetNeighbour2(pt, i), true);
-
-    // und für die Ränder
-    UpdateBorderTrianglePos(pt, true);
-    UpdateBorderTriangleColor(pt, true);
-
-    for(const MapPoint nb : gwv.GetNeighbours(pt))
     {
-        UpdateBorderTrianglePos(nb, true);
-        UpdateBorderTriangleColor(nb, true);
+        const MapPoint nb2 = gwv.GetWorld().GetNeighbour2(pt, i);
+        UpdateTriangleColor(nb2);
+        UpdateBorderTriangleColor(nb2);
+        MarkChunkChanged(nb2, CHANGED_COLOR);
     }
-
-    for(unsigned i = 0; i < 12; ++i)
-        UpdateBorderTriangleColor(gwv.GetWorld().GetNeighbour2(pt, i), true);
 }
 
 void TerrainRenderer::VisibilityChanged(const MapPoint pt, const GameWorldViewer& gwv)
@@ -1091,14 +1082,15 @@ void TerrainRenderer::VisibilityChanged(const MapPoint pt, const GameWorldViewer
         UpdateBorderVertex(nb);
 
     // den selbst sowieso die Punkte darum updaten, da sich bei letzteren die Schattierung geändert haben könnte
-    UpdateTriangleColor(pt, true);
+    UpdateTriangleColor(pt);
+    UpdateBorderTriangleColor(pt);
+    MarkChunkChanged(pt, CHANGED_COLOR);
     for(const MapPoint nb : gwv.GetNeighbours(pt))
-        UpdateTriangleColor(nb, true);
-
-    // und für die Ränder
-    UpdateBorderTriangleColor(pt, true);
-    for(const MapPoint nb : gwv.GetNeighbours(pt))
-        UpdateBorderTriangleColor(nb, true);
+    {
+        UpdateTriangleColor(nb);
+        UpdateBorderTriangleColor(nb);
+        MarkChunkChanged(nb, CHANGED_COLOR);
+    }
 }
 
 void TerrainRenderer::UpdateAllColors(const GameWorldViewer& gwv)
@@ -1110,10 +1102,10 @@ void TerrainRenderer::UpdateAllColors(const GameWorldViewer& gwv)
         UpdateBorderVertex(pt);
 
     RTTR_FOREACH_PT(MapPoint, size_)
-        UpdateTriangleColor(pt, false);
+        UpdateTriangleColor(pt);
 
     RTTR_FOREACH_PT(MapPoint, size_)
-        UpdateBorderTriangleColor(pt, false);
+        UpdateBorderTriangleColor(pt);
 
     if(vbo_colors.isValid())
     {
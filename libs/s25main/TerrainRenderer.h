@@ -14,9 +14,11 @@
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+class GameWorldBase;
 class GameWorldViewer;
 class glArchivItem_Bitmap;
 struct EdgeDesc;
@@ -39,6 +41,8 @@ public:
 
     /// Draws the map between the given points. Optionally returns percentage of water drawn
     void Draw(const Position& firstPt, const Position& lastPt, const GameWorldViewer& gwv, unsigned* water) const;
+    /// Percentage of water triangles of the nodes between the given points (inclusive)
+    static unsigned GetWaterPercentage(const Position& firstPt, const Position& lastPt, const GameWorldBase& world);
 
     /// Converts given point into a MapPoint (0 <= x < width and 0 <= y < height)
     /// Optionally returns offset of returned point to original point in pixels (for drawing)
@@ -57,21 +61,41 @@ public:
     /// Recalculates all colors on the map
     void UpdateAllColors(const GameWorldViewer& gwv);
 
+    /// Size (in nodes) of the square chunks the terrain is split into for drawing and updating
+    static constexpr unsigned CHUNK_SIZE = 32;
+    /// Number of chunks in each direction
+    const Extent& GetNumChunks() const { return numChunks_; }
+    /// Number of chunks with changes that are not yet uploaded to the GPU
+    unsigned GetNumChangedChunks() const { return static_cast<unsigned>(changedChunks.size()); }
+
 private:
-    struct MapTile
+    /// Range of triangles in the gl_* arrays
+    struct DrawRange
     {
-        unsigned tileOffset;
-        unsigned count;
-        Position posOffset;
-        MapTile(unsigned tileOffset, Position posOffset) : tileOffset(tileOffset), count(1), posOffset(posOffset) {}
+        unsigned first = 0;
+        unsigned count = 0;
+    };
+
+    /// All triangles of the nodes in one chunk are stored consecutively in the gl_* arrays, sorted by texture
+    struct Chunk
+    {
+        /// Triangles of the whole chunk
+        DrawRange triangles;
+        DescriptionVector<DrawRange, TerrainDesc> terrainRanges;
+        DescriptionVector<DrawRange, EdgeDesc> edgeRanges;
     };
 
-    struct BorderTile
+    /// A chunk to draw at the given offset (for wrapping around the map borders)
+    struct VisibleChunk
     {
-        unsigned tileOffset;
-        unsigned count;
+        const Chunk* chunk;
         Position posOffset;
-        BorderTile(unsigned tileOffset, Position posOffset) : tileOffset(tileOffset), count(1), posOffset(posOffset) {}
+    };
+
+    enum ChunkChange : uint8_t
+    {
+        CHANGED_POS = 1 << 0,
+        CHANGED_COLOR = 1 << 1
     };
 
     struct PreparedRoad
@@ -132,11 +156,21 @@ private:
     std::vector<Triangle> gl_texcoords;
     std::vector<ColorTriangle> gl_colors;
 
-    ogl::VBO<Triangle> vbo_vertices;
+    // Mutable as changes are collected and only uploaded once when drawing
+    mutable ogl::VBO<Triangle> vbo_vertices;
     ogl::VBO<Triangle> vbo_texcoords;
-    ogl::VBO<ColorTriangle> vbo_colors;
+    mutable ogl::VBO<ColorTriangle> vbo_colors;
 
     std::vector<Borders> borders;
+    /// Map sized array with the offsets of the 2 triangles of each node into the gl_* arrays
+    std::vector<std::array<unsigned, 2>> triangleOffsets;
+
+    Extent numChunks_;
+    std::vector<Chunk> chunks;
+    /// Combination of ChunkChange flags for each chunk
+    mutable std::vector<uint8_t> chunkChanges;
+    /// Indices of all chunks with a non-zero entry in chunkChanges
+    mutable std::vector<unsigned> changedChunks;
 
     using BmpPtr = std::unique_ptr<glArchivItem_Bitmap>;
     DescriptionVector<TerrainTexture, TerrainDesc> terrainTextures;
@@ -149,8 +183,8 @@ private:
     {
         return static_cast<unsigned>(pt.y) * static_cast<unsigned>(size_.x) + static_cast<unsigned>(pt.x);
     }
-    /// Returns the index of the first triangle (each point has 2). Used to access gl_* structs
-    unsigned GetTriangleIdx(const MapPoint pt) const { return GetVertexIdx(pt) * 2; }
+    /// Returns the index of the chunk containing the point
+    unsigned GetChunkIdx(const MapPoint pt) const { return (pt.y / CHUNK_SIZE) * numChunks_.x + pt.x / CHUNK_SIZE; }
     /// Return the coordinates of the neighbour node
     MapPoint GetNeighbour(const MapPoint& pt, Direction dir) const;
 
@@ -169,14 +203,23 @@ private:
     /// Update (map-)border vertex attributes
     void UpdateBorderVertex(MapPoint pt);
 
-    /// Fills OGL vertex data from map vertex data (updateVBO = true updates also VBO if used)
-    void UpdateTrianglePos(MapPoint pt, bool updateVBO);
-    void UpdateTriangleColor(MapPoint pt, bool updateVBO);
-    void UpdateTriangleTerrain(MapPoint pt, bool updateVBO);
+    /// Assigns the triangles of each chunk to consecutive offsets in the gl_* arrays and creates the draw ranges
+    void GenerateChunks();
+
+    /// Fills OGL vertex data from map vertex data
+    void UpdateTrianglePos(MapPoint pt);
+    void UpdateTriangleColor(MapPoint pt);
+    void UpdateTriangleTerrain(MapPoint pt);
     /// Fills OGL border vertex data from map vertex data
-    void UpdateBorderTrianglePos(MapPoint pt, bool updateVBO);
-    void UpdateBorderTriangleColor(MapPoint pt, bool updateVBO);
-    void UpdateBorderTriangleTerrain(MapPoint pt, bool updateVBO);
+    void UpdateBorderTrianglePos(MapPoint pt);
+    void UpdateBorderTriangleColor(MapPoint pt);
+    void UpdateBorderTriangleTerrain(MapPoint pt);
+    /// Remember that the OGL data of the chunk containing the point changed. See ChunkChange
+    void MarkChunkChanged(MapPoint pt, uint8_t changes);
+    /// Upload the data of all changed chunks to the VBOs
+    void UploadChangedChunks() const;
+    /// Get all chunks overlapping the area between firstPt and lastPt (inclusive)
+    std::vector<VisibleChunk> GetVisibleChunks(const Position& firstPt, const Position& lastPt) const;
 
     /// liefert den Vertex-Farbwert an der Stelle X,Y
     float GetColor(const MapPoint pt) const { return GetVertex(pt).color; }
@@ -3,34 +3,49 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "TradePathCache.h"
-#include "EventManager.h"
 #include "GamePlayer.h"
+#include "helpers/containerUtils.h"
 #include "world/GameWorld.h"
 #include "gameData/GameConsts.h"
+#include <algorithm>
+#include <limits>
+
+TradePathCache::TradePathCache(const GameWorld& world, const unsigned maxSize) : world(world), maxSize(maxSize)
+{
+    RTTR_Assert(maxSize > 0u);
+}
+
+void TradePathCache::clear()
+{
+    entries.clear();
+    index.clear();
+    numEntriesAtNode.clear();
+}
 
 bool TradePathCache::pathExists(const MapPoint start, const MapPoint goal, const unsigned char player)
 {
     RTTR_Assert(start != goal);
 
-    int entryIdx = findEntry(start, goal, player);
-    if(entryIdx >= 0)
+    const auto it = findEntry(start, goal, player);
+    if(it != entries.end())
     {
         // Found an entry --> Check if the route is still valid
         MapPoint checkedGoal;
-        if(world.CheckTradeRoute(paths[entryIdx].path.start, paths[entryIdx].path.route, 0, player, &checkedGoal))
+        if(world.CheckTradeRoute(it->path.start, it->path.route, 0, player, &checkedGoal))
         {
             RTTR_Assert(checkedGoal == start || checkedGoal == goal);
-            paths[entryIdx].lastUse = world.GetEvMgr().GetCurrentGF();
+            // Mark as most recently used
+            entries.splice(entries.begin(), entries, it);
+            ++numHits;
             return true;
         } else
         {
             // TradePath is now invalid -> remove it
-            if(static_cast<unsigned>(entryIdx) != paths.size() - 1u)
-                std::swap(paths[entryIdx], paths.back());
-            paths.pop_back();
+            removeEntry(it);
         }
     }
 
+    ++numMisses;
     std::vector<Direction> route;
     if(!world.FindTradePath(start, goal, player, std::numeric_limits<unsigned>::max(), false, &route))
         return false;
@@ -39,41 +54,102 @@ bool TradePathCache::pathExists(const MapPoint start, const MapPoint goal, const
     return true;
 }
 
-int TradePathCache::findEntry(const MapPoint start, const MapPoint goal, const PlayerIdx player) const
+uint64_t TradePathCache::getKey(const MapPoint start, const MapPoint goal) const
+{
+    // Paths can be used in both directions
+    const uint64_t startIdx = world.GetIdx(start);
+    const uint64_t goalIdx = world.GetIdx(goal);
+    return (std::min(startIdx, goalIdx) << 32) | std::max(startIdx, goalIdx);
+}
+
+TradePathCache::EntryIt TradePathCache::findEntry(const MapPoint start, const MapPoint goal, const PlayerIdx player)
 {
+    const auto itBucket = index.find(getKey(start, goal));
+    if(itBucket == index.end())
+        return entries.end();
     const GamePlayer& thisPlayer = world.GetPlayer(player);
+    for(const EntryIt it : itBucket->second)
+    {
+        if(thisPlayer.IsAlly(it->player))
+            return it;
+    }
+    return entries.end();
+}
+
+void TradePathCache::removeEntry(const EntryIt it)
+{
+    const auto itBucket = index.find(getKey(it->path.start, it->path.goal));
+    RTTR_Assert(itBucket != index.end());
+    std::vector<EntryIt>& bucket = itBucket->second;
+    bucket.erase(helpers::find(bucket, it));
+    if(bucket.empty())
+        index.erase(itBucket);
+    countNodes(it->path, false);
+    entries.erase(it);
+}
+
+void TradePathCache::countNodes(const TradePath& path, const bool add)
+{
+    if(numEntriesAtNode.empty())
+        numEntriesAtNode.resize(prodOfComponents(world.GetSize()));
+    const auto count = [this, add](const MapPoint pt) {
+        unsigned& numEntries = numEntriesAtNode[world.GetIdx(pt)];
+        if(add)
+            numEntries++;
+        else
+        {
+            RTTR_Assert(numEntries > 0u);
+            numEntries--;
+        }
+    };
+    MapPoint curPt = path.start;
+    count(curPt);
+    for(const Direction dir : path.route)
+    {
+        curPt = world.GetNeighbour(curPt, dir);
+        count(curPt);
+    }
+}
 
-    for(unsigned i = 0; i < paths.size(); i++)
+bool TradePathCache::containsNode(const TradePath& path, const MapPoint pt) const
+{
+    MapPoint curPt = path.start;
+    if(curPt == pt)
+        return true;
+    for(const Direction dir : path.route)
     {
-        const Entry& pathEntry = paths[i];
-        if(pathEntry.path.start != start && pathEntry.path.goal != start)
-            continue;
-        if(pathEntry.path.goal != goal && pathEntry.path.start != goal)
-            continue;
-        if(!thisPlayer.IsAlly(pathEntry.player))
-            continue;
-        return i;
+        curPt = world.GetNeighbour(curPt, dir);
+        if(curPt == pt)
+            return true;
     }
-    return -1;
+    return false;
 }
 
 void TradePathCache::addEntry(TradePath path, const unsigned char player)
 {
-    Entry entry{player, world.GetEvMgr().GetCurrentGF(), std::move(path)};
+    auto it = findEntry(path.start, path.goal, player);
+    if(it != entries.end())
+        removeEntry(it);
+    else if(entries.size() >= maxSize)
+        removeEntry(std::prev(entries.end())); // No space left --> Replace least recently used
+
+    entries.push_front(Entry{player, std::move(path)});
+    index[getKey(entries.front().path.start, entries.front().path.goal)].push_back(entries.begin());
+    countNodes(entries.front().path, true);
+}
 
-    int idx = findEntry(entry.path.start, entry.path.goal, player);
-    if(idx < 0)
+void TradePathCache::nodeChanged(const MapPoint pt)
+{
+    if(numEntriesAtNode.empty() || numEntriesAtNode[world.GetIdx(pt)] == 0u)
+        return;
+    for(auto it = entries.begin(); it != entries.end();)
     {
-        // None found --> Find a new spot
-        if(paths.size() < paths.max_size())
-            paths.emplace_back(std::move(entry)); // We got space left --> append
-        else
+        if(containsNode(it->path, pt))
         {
-            // No space left --> Replace oldest
-            const auto itOldestElement = std::min_element(
-              paths.begin(), paths.end(), [](const Entry& rhs, const Entry& lhs) { return rhs.lastUse < lhs.lastUse; });
-            *itOldestElement = std::move(entry);
-        }
-    } else
-        paths[idx] = std::move(entry);
+            removeEntry(it++);
+            ++numInvalidations;
+        } else
+            ++it;
+    }
+    RTTR_Assert(numEntriesAtNode[world.GetIdx(pt)] == 0u);
 }
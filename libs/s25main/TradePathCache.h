@@ -5,10 +5,17 @@
 #pragma once
 
 #include "world/TradePath.h"
-#include <boost/container/static_vector.hpp>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 class GameWorld;
 
+/// Cache of trade paths between warehouse flags. Entries are shared by allied players and found via a hash index on
+/// the (unordered) start and goal. The least recently used entry is replaced when the cache is full.
+/// Entries are dropped as soon as a node on their route changes (object, road, owner or terrain).
+/// As blocking objects and alliances can also change without such a notification a route is still checked before use.
 class TradePathCache
 {
     using PlayerIdx = unsigned char;
@@ -16,19 +23,44 @@ class TradePathCache
     struct Entry
     {
         PlayerIdx player;
-        unsigned lastUse;
         TradePath path;
     };
+    using EntryIt = std::list<Entry>::iterator;
 
     const GameWorld& world;
-    boost::container::static_vector<Entry, 10> paths;
-    int findEntry(MapPoint start, MapPoint goal, PlayerIdx player) const;
+    const unsigned maxSize;
+    /// All entries, most recently used first
+    std::list<Entry> entries;
+    /// Entries by their start and goal
+    std::unordered_map<uint64_t, std::vector<EntryIt>> index;
+    /// Number of entries whose route contains the node, to quickly ignore changes of other nodes
+    std::vector<unsigned> numEntriesAtNode;
+    uint64_t numHits = 0, numMisses = 0, numInvalidations = 0;
+
+    uint64_t getKey(MapPoint start, MapPoint goal) const;
+    EntryIt findEntry(MapPoint start, MapPoint goal, PlayerIdx player);
+    void removeEntry(EntryIt it);
+    /// Add the nodes of the path to the node counts or remove them
+    void countNodes(const TradePath& path, bool add);
+    bool containsNode(const TradePath& path, MapPoint pt) const;
 
 public:
-    TradePathCache(const GameWorld& world) : world(world) {}
+    static constexpr unsigned DEFAULT_MAX_SIZE = 256;
+
+    TradePathCache(const GameWorld& world, unsigned maxSize = DEFAULT_MAX_SIZE);
 
-    void clear() { paths.clear(); }
-    unsigned size() const { return paths.size(); }
+    void clear();
+    unsigned size() const { return static_cast<unsigned>(entries.size()); }
+    unsigned getMaxSize() const { return maxSize; }
     bool pathExists(MapPoint start, MapPoint goal, PlayerIdx player);
     void addEntry(TradePath path, PlayerIdx player);
+    /// Drop all entries whose route contains the node
+    void nodeChanged(MapPoint pt);
+
+    /// Number of lookups answered by a stored route
+    uint64_t getNumHits() const { return numHits; }
+    /// Number of lookups which required a search
+    uint64_t getNumMisses() const { return numMisses; }
+    /// Number of entries dropped because a node on their route changed
+    uint64_t getNumInvalidations() const { return numInvalidations; }
 };
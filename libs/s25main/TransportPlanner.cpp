@@ -0,0 +1,186 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "TransportPlanner.h"
+#include "Ware.h"
+#include "buildings/noBaseBuilding.h"
+#include "helpers/EnumArray.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noRoadNode.h"
+#include "gameTypes/GoodTypes.h"
+#include <cstdint>
+#include <limits>
+
+TransportPlanner::TransportPlanner(GameWorld& world) : world(world) {}
+
+bool TransportPlanner::CanReassign(const Ware& ware)
+{
+    // Wares being carried or in buildings are not changed
+    if(!ware.IsWaitingAtFlag() || ware.type == GoodType::Coins)
+        return false;
+    const noBaseBuilding* goal = ware.GetGoal();
+    if(!goal)
+        return false;
+    // Only usual buildings can take any ware of the ordered type without side effects
+    const GO_Type got = goal->GetGOT();
+    if(got != GO_Type::NobUsual && got != GO_Type::NobShipyard && got != GO_Type::NobTemple)
+        return false;
+    const RoadPathDirection nextDir = ware.GetNextDir();
+    if(nextDir == RoadPathDirection::None || nextDir == RoadPathDirection::Ship)
+        return false;
+    // Wares at the flag of their goal get carried in right away
+    return ware.GetLocation()->GetPos() != goal->GetFlagPos();
+}
+
+unsigned TransportPlanner::Plan(const helpers::IndexedList<Ware*>& wares)
+{
+    helpers::EnumArray<std::vector<Ware*>, GoodType> candidates;
+    for(Ware* ware : wares)
+    {
+        if(!CanReassign(*ware))
+            continue;
+        std::vector<Ware*>& typeCandidates = candidates[ware->type];
+        if(typeCandidates.size() < MAX_BATCH_SIZE)
+            typeCandidates.push_back(ware);
+    }
+
+    unsigned numReassigned = 0;
+    for(const std::vector<Ware*>& typeCandidates : candidates)
+    {
+        if(typeCandidates.size() > 1u)
+            numReassigned += PlanWares(typeCandidates);
+    }
+    return numReassigned;
+}
+
+unsigned TransportPlanner::GetCosts(const noRoadNode& location, const noBaseBuilding& goal)
+{
+    // The special handling of wares at the flag of their goal is not done here
+    if(location.GetPos() == goal.GetFlagPos())
+        return NO_PATH;
+    const auto key = std::make_pair(location.GetObjId(), goal.GetObjId());
+    const auto it = pathCosts.find(key);
+    if(it != pathCosts.end())
+        return it->second;
+    unsigned length;
+    const unsigned costs =
+      (world.FindPathForWareOnRoads(location, goal, &length) != RoadPathDirection::None) ? length : NO_PATH;
+    pathCosts[key] = costs;
+    return costs;
+}
+
+unsigned TransportPlanner::PlanWares(const std::vector<Ware*>& wares)
+{
+    const unsigned numWares = wares.size();
+    std::vector<noBaseBuilding*> goals;
+    goals.reserve(numWares);
+    for(const Ware* ware : wares)
+        goals.push_back(ware->GetGoal());
+
+    // Costs of every ware for every goal. Wares at the same flag and goals ordering multiple wares share the searches
+    pathCosts.clear();
+    std::vector<std::vector<unsigned>> costs(numWares, std::vector<unsigned>(numWares));
+    unsigned curCosts = 0;
+    for(unsigned i = 0; i < numWares; i++)
+    {
+        for(unsigned j = 0; j < numWares; j++)
+            costs[i][j] = GetCosts(*wares[i]->GetLocation(), *goals[j]);
+        if(costs[i][i] >= NO_PATH)
+            return 0; // Should not happen as the ware has a route to its goal
+        curCosts += costs[i][i];
+    }
+
+    const std::vector<unsigned> assignment = SolveAssignment(costs);
+    unsigned newCosts = 0;
+    for(unsigned i = 0; i < numWares; i++)
+        newCosts += costs[i][assignment[i]];
+    if(newCosts >= curCosts)
+        return 0;
+
+    unsigned numReassigned = 0;
+    for(unsigned i = 0; i < numWares; i++)
+    {
+        Ware& ware = *wares[i];
+        noBaseBuilding* newGoal = goals[assignment[i]];
+        if(newGoal == ware.GetGoal())
+            continue;
+        const RoadPathDirection lastDir = ware.GetNextDir();
+        ware.NotifyGoalAboutLostWare();
+        ware.SetGoal(newGoal);
+        ware.RecalcRoute();
+        // Same as when a road got destroyed: Notify the carriers if the ware goes another way now
+        if(ware.GetNextDir() != lastDir)
+        {
+            ware.RemoveWareJobForDir(lastDir);
+            if(ware.GetNextDir() != RoadPathDirection::None)
+                ware.CallCarrier();
+        }
+        numReassigned++;
+    }
+    return numReassigned;
+}
+
+std::vector<unsigned> TransportPlanner::SolveAssignment(const std::vector<std::vector<unsigned>>& costs)
+{
+    // Hungarian algorithm with potentials in O(n^3). Indices are 1-based, column 0 is a dummy for the current row
+    constexpr int64_t INF = std::numeric_limits<int64_t>::max();
+    const unsigned n = costs.size();
+    std::vector<int64_t> rowPotential(n + 1, 0), colPotential(n + 1, 0), minSlack(n + 1);
+    // Row assigned to each column and previous column on the augmenting path
+    std::vector<unsigned> colRow(n + 1, 0), prevCol(n + 1, 0);
+    std::vector<bool> visited(n + 1);
+    for(unsigned row = 1; row <= n; row++)
+    {
+        RTTR_Assert(costs[row - 1].size() == n);
+        colRow[0] = row;
+        unsigned curCol = 0;
+        std::fill(minSlack.begin(), minSlack.end(), INF);
+        std::fill(visited.begin(), visited.end(), false);
+        do
+        {
+            visited[curCol] = true;
+            const unsigned curRow = colRow[curCol];
+            int64_t delta = INF;
+            unsigned nextCol = 0;
+            for(unsigned col = 1; col <= n; col++)
+            {
+                if(visited[col])
+                    continue;
+                const int64_t slack = costs[curRow - 1][col - 1] - rowPotential[curRow] - colPotential[col];
+                if(slack < minSlack[col])
+                {
+                    minSlack[col] = slack;
+                    prevCol[col] = curCol;
+                }
+                if(minSlack[col] < delta)
+                {
+                    delta = minSlack[col];
+                    nextCol = col;
+                }
+            }
+            for(unsigned col = 0; col <= n; col++)
+            {
+                if(visited[col])
+                {
+                    rowPotential[colRow[col]] += delta;
+                    colPotential[col] -= delta;
+                } else
+                    minSlack[col] -= delta;
+            }
+            curCol = nextCol;
+        } while(colRow[curCol] != 0);
+        // Augment along the path
+        do
+        {
+            const unsigned col = prevCol[curCol];
+            colRow[curCol] = colRow[col];
+            curCol = col;
+        } while(curCol != 0);
+    }
+
+    std::vector<unsigned> result(n);
+    for(unsigned col = 1; col <= n; col++)
+        result[colRow[col] - 1] = col - 1;
+    return result;
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/IndexedList.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+class GameWorld;
+class noBaseBuilding;
+class noRoadNode;
+class Ware;
+
+/// Plans the transport of the wares of a player in batches (addon TRANSPORT_PLANNER).
+/// Wares get their goal when they are produced, one at a time. This reassigns the wares of the same type waiting at
+/// flags to the buildings which ordered them such that the sum of the transport costs is minimal.
+/// The costs are the lengths of the road paths including the additional costs for busy carriers (waiting wares), so
+/// congested roads are avoided. The buildings supplied stay the same, only the ware going to each of them changes.
+class TransportPlanner
+{
+public:
+    /// Maximum number of wares of one type planned at once
+    static constexpr unsigned MAX_BATCH_SIZE = 32;
+
+    explicit TransportPlanner(GameWorld& world);
+
+    /// Plan the transports of the wares (all belonging to the same player). Return the number of wares with a new goal
+    unsigned Plan(const helpers::IndexedList<Ware*>& wares);
+
+    /// Return the column assigned to each row such that the sum of the costs is minimal.
+    /// costs must be a square matrix. Ties are resolved deterministically
+    static std::vector<unsigned> SolveAssignment(const std::vector<std::vector<unsigned>>& costs);
+
+private:
+    /// Costs used for a ware which cannot be transported to a goal
+    static constexpr unsigned NO_PATH = 0x10000000;
+
+    /// Return true if the ware may get another goal
+    static bool CanReassign(const Ware& ware);
+    unsigned PlanWares(const std::vector<Ware*>& wares);
+    unsigned GetCosts(const noRoadNode& location, const noBaseBuilding& goal);
+
+    GameWorld& world;
+    /// Costs per location and goal (by object id) of the current batch
+    std::map<std::pair<unsigned, unsigned>, unsigned> pathCosts;
+};
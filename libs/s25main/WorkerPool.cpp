@@ -0,0 +1,86 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned numThreads)
+    // hardware_concurrency may return 0 if unknown
+    : numThreads_(std::max(1u, numThreads ? numThreads : std::thread::hardware_concurrency()))
+{}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    startRun_.notify_all();
+    for(std::thread& thread : threads_)
+        thread.join();
+}
+
+void WorkerPool::run(const unsigned numTasks, const std::function<void(unsigned)>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Only start as many threads as there is work for
+        const unsigned numWorkers = std::min(numThreads_, numTasks) - (numTasks > 0 ? 1 : 0);
+        while(threads_.size() < numWorkers)
+            threads_.emplace_back(&WorkerPool::workerLoop, this, curRun_);
+        task_ = &task;
+        numTasks_ = numTasks;
+        nextTask_ = 0;
+        errors_.assign(numTasks, nullptr);
+        numBusyWorkers_ = threads_.size();
+        ++curRun_;
+    }
+    if(!threads_.empty())
+        startRun_.notify_all();
+    runTasks();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        runFinished_.wait(lock, [this]() { return numBusyWorkers_ == 0; });
+        task_ = nullptr;
+    }
+    for(const std::exception_ptr& error : errors_)
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::workerLoop(uint64_t lastRun)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            startRun_.wait(lock, [this, lastRun]() { return stop_ || curRun_ != lastRun; });
+            if(stop_)
+                return;
+            lastRun = curRun_;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(--numBusyWorkers_ == 0)
+                runFinished_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::runTasks()
+{
+    for(unsigned idx = nextTask_++; idx < numTasks_; idx = nextTask_++)
+    {
+        try
+        {
+            (*task_)(idx);
+        } catch(...)
+        {
+            errors_[idx] = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Pool of threads running data-parallel tasks, e.g. one per player.
+/// The threads are started on first use and kept for the following runs, so the pool can be used every GF.
+/// The calling thread takes part in the work.
+class WorkerPool
+{
+public:
+    /// Use at most numThreads threads including the calling one, 0 for one per hardware thread
+    explicit WorkerPool(unsigned numThreads = 0);
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    ~WorkerPool();
+
+    unsigned getNumThreads() const { return numThreads_; }
+
+    /// Call task(idx) for each idx in [0, numTasks) and wait until all calls are done.
+    /// The calls may run in any order and in parallel, so each may only write data belonging to its index.
+    /// If any call throws, the exception of the lowest index is rethrown after all calls finished.
+    void run(unsigned numTasks, const std::function<void(unsigned)>& task);
+
+private:
+    void workerLoop(uint64_t lastRun);
+    /// Execute not yet started tasks of the current run
+    void runTasks();
+
+    const unsigned numThreads_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable startRun_, runFinished_;
+    /// Increased for each run so the workers know when to start
+    uint64_t curRun_ = 0;
+    /// Workers still busy with the current run
+    unsigned numBusyWorkers_ = 0;
+    bool stop_ = false;
+    const std::function<void(unsigned)>* task_ = nullptr;
+    unsigned numTasks_ = 0;
+    std::atomic<unsigned> nextTask_{0};
+    std::vector<std::exception_ptr> errors_;
+};
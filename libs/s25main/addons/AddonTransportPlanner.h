@@ -0,0 +1,42 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "AddonList.h"
+#include "helpers/chronoIO.h"
+#include "helpers/format.hpp"
+#include "helpers/make_array.h"
+#include "mygettext/mygettext.h"
+#include <chrono>
+
+/**
+ *  Addon for periodically planning the transport of the wares waiting at flags (see TransportPlanner)
+ */
+constexpr auto AddonTransportPlannerIntervalList = helpers::make_array<std::chrono::seconds>(0, 10, 30, 60);
+// note that the interval of 0 is used for disabling the planner
+
+class AddonTransportPlanner : public AddonList
+{
+    static std::vector<std::string> makeOptions()
+    {
+        std::vector<std::string> result;
+        for(const auto interval : AddonTransportPlannerIntervalList)
+        {
+            if(interval.count() == 0)
+                result.push_back(_("Off"));
+            else
+                result.push_back(helpers::format(_("Every %1%"), helpers::withUnit(interval)));
+        }
+        return result;
+    }
+
+public:
+    AddonTransportPlanner()
+        : AddonList(AddonId::TRANSPORT_PLANNER, AddonGroup::Economy, _("Plan ware transports"),
+                    _("Periodically swaps the destinations of wares waiting at flags so that the buildings which "
+                      "ordered them are supplied over shorter and less busy roads."),
+                    makeOptions())
+    {}
+};
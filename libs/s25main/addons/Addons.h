@@ -18,6 +18,7 @@
 #include "addons/AddonCharburner.h"
 #include "addons/AddonDemolitionProhibition.h"
 #include "addons/AddonTrade.h"
+#include "addons/AddonTransportPlanner.h"
 
 #include "addons/AddonChangeGoldDeposits.h"
 #include "addons/AddonCustomBuildSequence.h"
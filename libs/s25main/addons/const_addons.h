@@ -41,6 +41,7 @@ ENUM_WITH_STRING(AddonId, LIMIT_CATAPULTS = 0x00000000, INEXHAUSTIBLE_MINES = 0x
                  CATAPULT_GRAPHICS = 0x00000006, METALWORKSBEHAVIORONZERO = 0x00000007,
 
                  DEMOLITION_PROHIBITION = 0x00100000, CHARBURNER = 0x00100001, TRADE = 0x00100002,
+                 TRANSPORT_PLANNER = 0x00100003,
 
                  CHANGE_GOLD_DEPOSITS = 0x00200000, MAX_WATERWAY_LENGTH = 0x00200001,
                  CUSTOM_BUILD_SEQUENCE = 0x00200002, STATISTICS_VISIBILITY = 0x00200003,
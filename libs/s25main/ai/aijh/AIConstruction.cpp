@@ -18,6 +18,7 @@
 #include "helpers/containerUtils.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noRoadNode.h"
+#include "world/PlayerObjectIndex.h"
 #include "gameTypes/BuildingQuality.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/GoodTypes.h"
@@ -176,26 +177,12 @@ void AIConstruction::ConstructionsExecuted()
     std::fill(constructionorders.begin(), constructionorders.end(), 0u);
 }
 
-namespace {
-    struct Point2FlagAI
-    {
-        const GameWorldBase& world_;
-        Point2FlagAI(const GameWorldBase& world) : world_(world) {}
-        const noFlag* operator()(const MapPoint pt, unsigned /*r*/) const { return world_.GetSpecObj<noFlag>(pt); }
-    };
-
-    struct IsValidFlag
-    {
-        const unsigned playerId_;
-        IsValidFlag(const unsigned playerId) : playerId_(playerId) {}
-        bool operator()(const noFlag* const flag) const { return flag && flag->GetPlayer() == playerId_; }
-    };
-} // namespace
-
 std::vector<const noFlag*> AIConstruction::FindFlags(const MapPoint pt, unsigned short radius)
 {
-    std::vector<const noFlag*> flags =
-      aii.gwb.GetPointsInRadius<30>(pt, radius, Point2FlagAI(aii.gwb), IsValidFlag(aii.GetPlayerId()));
+    std::vector<const noFlag*> flags;
+    for(const MapPoint flagPt :
+        aii.gwb.GetPlayerObjectIndex().GetInRadius(aii.GetPlayerId(), PlayerObjectIndex::Type::Flag, pt, radius, 30))
+        flags.push_back(aii.gwb.GetSpecObj<noFlag>(flagPt));
     // When the radius is at least half the size of the map then we may have duplicates that need to be removed
     if(radius >= std::min(aii.gwb.GetSize().x, aii.gwb.GetSize().y))
     {
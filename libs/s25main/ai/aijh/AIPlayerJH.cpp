@@ -120,18 +120,22 @@ Subscription recordBQsToUpdate(const GameWorldBase& gw, std::vector<MapPoint>& b
         bqsToUpdate.push_back(pt);
         return false;
     };
-    return gw.GetNotifications().subscribe<NodeNote>([&gw, addToBqsToUpdate](const NodeNote& note) {
-        if(note.type == NodeNote::BQ)
-        {
-            // Need to check surrounding nodes for possible/impossible flags (e.g. near border)
-            gw.CheckPointsInRadius(note.pos, 1, addToBqsToUpdate, true);
-        } else if(note.type == NodeNote::Owner)
-        {
-            // Owner changes border, which changes where buildings can be placed next to it
-            // And as flags are need for buildings we need range 2 (e.g. range 1 is flag, range 2 building)
-            gw.CheckPointsInRadius(note.pos, 2, addToBqsToUpdate, true);
-        }
-    });
+    return gw.GetNotifications().subscribeBatch<NodeNote>(
+      [&gw, addToBqsToUpdate](const std::vector<NodeNote>& notes) {
+          for(const NodeNote& note : notes)
+          {
+              if(note.type == NodeNote::BQ)
+              {
+                  // Need to check surrounding nodes for possible/impossible flags (e.g. near border)
+                  gw.CheckPointsInRadius(note.pos, 1, addToBqsToUpdate, true);
+              } else if(note.type == NodeNote::Owner)
+              {
+                  // Owner changes border, which changes where buildings can be placed next to it
+                  // And as flags are need for buildings we need range 2 (e.g. range 1 is flag, range 2 building)
+                  gw.CheckPointsInRadius(note.pos, 2, addToBqsToUpdate, true);
+              }
+          }
+      });
 }
 
 static bool isUnlimitedResource(const AIResource res, const GlobalGameSettings& ggs)
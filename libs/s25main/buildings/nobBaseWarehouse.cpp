@@ -1364,7 +1364,6 @@ void nobBaseWarehouse::CheckOuthousing(const boost_variant2<GoodType, Job>& what
         empty_event = GetEvMgr().AddEvent(this, empty_INTERVAL, 3);
 }
 
-/// For debug only
 bool nobBaseWarehouse::IsDependentFigure(const noFigure& fig) const
 {
     return helpers::contains(dependent_figures, &fig);
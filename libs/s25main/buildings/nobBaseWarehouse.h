@@ -281,6 +281,6 @@ public:
     void StartTradeCaravane(const boost_variant2<GoodType, Job>& what, unsigned count, const TradeRoute& tr,
                             nobBaseWarehouse* goal);
 
-    /// For debug only
+    /// Return true if the figure is on its way to this warehouse. Also used by the game logic when a figure arrives
     bool IsDependentFigure(const noFigure& fig) const;
 };
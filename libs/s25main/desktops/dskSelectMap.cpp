@@ -56,7 +56,8 @@ constexpr unsigned ID_msgBoxError = 0;
  *  @param[in] pass Server-Passwort
  */
 dskSelectMap::dskSelectMap(CreateServerInfo csi)
-    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr)
+    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenDone(false), mapGenPercentage(0),
+      waitWnd(nullptr)
 {
     WorldDescription desc;
     GameDataLoader gdLoader(desc);
@@ -135,8 +136,11 @@ dskSelectMap::dskSelectMap(CreateServerInfo csi)
 
 dskSelectMap::~dskSelectMap()
 {
-    // if(mapGenThread)
-    //    mapGenThread->join();
+    if(mapGenThread.joinable())
+    {
+        mapGenProgress->cancel();
+        mapGenThread.join();
+    }
     LOBBYCLIENT.RemoveListener(this);
 }
 
@@ -278,13 +282,16 @@ void dskSelectMap::Msg_ButtonClick(const unsigned ctrl_id)
         break;
         case 6: // random map
         {
-            if(!mapGenThread)
+            if(!mapGenThread.joinable())
             {
                 newRandMapPath.clear();
                 randMapGenError.clear();
+                mapGenDone = false;
+                mapGenPercentage = 0;
                 waitWnd = &WINDOWMANAGER.Show(std::make_unique<iwPleaseWait>());
-                // mapGenThread = new boost::thread(boost::bind(&dskSelectMap::CreateRandomMap, this));
-                CreateRandomMap();
+                mapGenProgress = std::make_unique<rttr::mapGenerator::GeneratorProgress>(
+                  [this](unsigned percentage) { mapGenPercentage = percentage; });
+                mapGenThread = std::thread(&dskSelectMap::CreateRandomMap, this);
             }
         }
         break;
@@ -310,12 +317,14 @@ void dskSelectMap::CreateRandomMap()
     try
     {
         // create a random map and save filepath
-        rttr::mapGenerator::CreateRandomMap(mapPath, rndMapSettings);
+        rttr::mapGenerator::CreateRandomMap(mapPath, rndMapSettings, mapGenProgress.get());
         newRandMapPath = mapPath;
-    } catch(const std::runtime_error& e)
+    } catch(const std::exception& e)
     {
+        // Must not leave the thread with an exception
         randMapGenError = e.what();
     }
+    mapGenDone = true;
 }
 
 void dskSelectMap::OnMapCreated(const boost::filesystem::path& mapPath)
@@ -395,8 +404,10 @@ void dskSelectMap::LC_Status_Error(const std::string& error)
 
 void dskSelectMap::Draw_()
 {
-    if(!newRandMapPath.empty() || !randMapGenError.empty())
+    if(mapGenDone)
     {
+        mapGenThread.join();
+        mapGenDone = false;
         if(waitWnd)
         {
             waitWnd->Close();
@@ -411,7 +422,8 @@ void dskSelectMap::Draw_()
             OnMapCreated(newRandMapPath);
         newRandMapPath.clear();
         randMapGenError.clear();
-    }
+    } else if(waitWnd && mapGenThread.joinable())
+        waitWnd->SetProgress(mapGenPercentage);
     Desktop::Draw_();
 }
 
@@ -5,18 +5,20 @@
 #pragma once
 
 #include "Desktop.h"
+#include "mapGenerator/GeneratorProgress.h"
 #include "mapGenerator/MapSettings.h"
 #include "network/CreateServerInfo.h"
 #include "liblobby/LobbyInterface.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/signals2/connection.hpp>
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
-namespace boost {
-class thread;
-}
+class iwPleaseWait;
 
 class dskSelectMap final : public Desktop, public LobbyInterface
 {
@@ -48,7 +50,7 @@ private:
     void GoBack() const;
 
     /**
-     * Generates a new random map and selects the new map in the table (UI).
+     * Generates a new random map. Runs in the map generator thread, the result is handled in Draw_.
      */
     void CreateRandomMap();
 
@@ -56,10 +58,14 @@ private:
 
     CreateServerInfo csi;
     rttr::mapGenerator::MapSettings rndMapSettings;
-    boost::thread* mapGenThread;
+    std::thread mapGenThread;
+    std::unique_ptr<rttr::mapGenerator::GeneratorProgress> mapGenProgress;
+    /// Set by the map generator thread when it is done. Only then the results below may be accessed
+    std::atomic<bool> mapGenDone;
+    std::atomic<unsigned> mapGenPercentage;
     boost::filesystem::path newRandMapPath;
     std::string randMapGenError;
-    IngameWindow* waitWnd;
+    iwPleaseWait* waitWnd;
     /// Mapping of s2 ids to landscape names
     std::map<uint8_t, std::string> landscapeNames;
     /// Maps that we already know are broken
@@ -19,8 +19,10 @@
 #include "ogl/glArchivItem_Bob.h"
 #include "ogl/glSmartBitmap.h"
 #include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/RehomingCache.h"
 #include "random/Random.h"
 #include "world/GameWorld.h"
+#include "world/PlayerObjectIndex.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noRoadNode.h"
 #include "nodeObjs/noSkeleton.h"
@@ -487,22 +489,6 @@ void noFigure::StartWandering(const unsigned burned_wh_id)
     }
 }
 
-namespace {
-struct Point2Flag
-{
-    World& gwb;
-    Point2Flag(World& gwb) : gwb(gwb) {}
-    noFlag* operator()(const MapPoint pt, unsigned /*r*/) const { return gwb.GetSpecObj<noFlag>(pt); }
-};
-
-struct IsValidFlag
-{
-    const unsigned playerId_;
-    IsValidFlag(const unsigned playerId) : playerId_(playerId) {}
-    bool operator()(const noFlag* const flag) const { return flag && flag->GetPlayer() == playerId_; }
-};
-} // namespace
-
 void noFigure::Wander()
 {
     // Sind wir noch auf der Suche nach einer Flagge?
@@ -520,14 +506,16 @@ void noFigure::Wander()
         const unsigned short wander_radius = IsSoldier() ? WANDER_RADIUS_SOLDIERS : WANDER_RADIUS;
 
         // Flaggen sammeln und dann zufällig eine auswählen
-        const std::vector<noFlag*> flags =
-          world->GetPointsInRadius(pos, wander_radius, Point2Flag(*world), IsValidFlag(player));
+        const std::vector<MapPoint> flagPts =
+          world->GetPlayerObjectIndex().GetInRadius(player, PlayerObjectIndex::Type::Flag, pos, wander_radius);
 
+        const RehomingCache& rehomingCache = world->GetRehomingCache();
         unsigned best_way = 0xFFFFFFFF;
         const noFlag* best_flag = nullptr;
 
-        for(auto* flag : flags)
+        for(const MapPoint flagPt : flagPts)
         {
+            const auto* flag = world->GetSpecObj<noFlag>(flagPt);
             // Ist das ein Flüchtling aus einem abgebrannten Lagerhaus?
             if(burned_wh_id != 0xFFFFFFFF)
             {
@@ -544,10 +532,11 @@ void noFigure::Wander()
             if(way < best_way)
             {
                 // Are we at that flag or is there a path to it?
-                if(way == 0 || world->FindHumanPath(pos, flag->GetPos(), wander_radius, false, &way))
+                // Use the shared searches as all figures from a burned warehouse do this at the same time
+                if(way == 0 || rehomingCache.findHumanPath(pos, flag->GetPos(), wander_radius, &way))
                 {
                     // gucken, ob ein Weg zu einem Warenhaus führt
-                    if(world->GetPlayer(player).FindWarehouse(*flag, FW::AcceptsFigure(job_), true, false))
+                    if(rehomingCache.hasWarehouseFor(player, *flag, job_))
                     {
                         // dann nehmen wir die doch glatt
                         best_way = way;
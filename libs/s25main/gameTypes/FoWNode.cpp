@@ -13,9 +13,8 @@ FoWNode::FoWNode() : last_update_time(0), visibility(Visibility::Invisible), own
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
 }
 
-void FoWNode::Serialize(SerializedGameData& sgd) const
+void FoWNode::SerializeFogData(SerializedGameData& sgd) const
 {
-    sgd.PushEnum<uint8_t>(visibility);
     // Only in FoW can be FoW objects
     if(visibility == Visibility::FogOfWar)
     {
@@ -29,7 +28,12 @@ void FoWNode::Serialize(SerializedGameData& sgd) const
 
 void FoWNode::Deserialize(SerializedGameData& sgd)
 {
-    visibility = sgd.Pop<Visibility>();
+    Deserialize(sgd, sgd.Pop<Visibility>());
+}
+
+void FoWNode::Deserialize(SerializedGameData& sgd, const Visibility newVisibility)
+{
+    visibility = newVisibility;
     // Only in FoW can be FoW objects
     if(visibility == Visibility::FogOfWar)
     {
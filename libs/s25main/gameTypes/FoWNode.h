@@ -56,6 +56,10 @@ struct FoWNode
     BoundaryStones boundary_stones;
 
     FoWNode();
-    void Serialize(SerializedGameData& sgd) const;
+    /// Serialize the data stored for FoW only, the visibility is stored separately
+    void SerializeFogData(SerializedGameData& sgd) const;
+    /// Set the visibility and deserialize the FoW data if required
+    void Deserialize(SerializedGameData& sgd, Visibility newVisibility);
+    /// Deserialize the visibility and the FoW data as stored before game data version 12
     void Deserialize(SerializedGameData& sgd);
 };
@@ -17,26 +17,6 @@ MapNode::MapNode()
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
 }
 
-void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc) const
-{
-    helpers::pushContainer(sgd, roads);
-    sgd.PushUnsignedChar(altitude);
-    sgd.PushUnsignedChar(shadow);
-    sgd.PushString(desc.get(t1).name);
-    sgd.PushString(desc.get(t2).name);
-    sgd.PushUnsignedChar(resources.getValue());
-    sgd.PushBool(reserved);
-    sgd.PushUnsignedChar(owner);
-    helpers::pushContainer(sgd, boundary_stones);
-    RTTR_Assert(numPlayers <= fow.size());
-    for(unsigned z = 0; z < numPlayers; ++z)
-        fow[z].Serialize(sgd);
-    sgd.PushObject(obj);
-    sgd.PushObjectContainer(figures);
-    sgd.PushUnsignedShort(seaId);
-    sgd.PushUnsignedInt(harborId);
-}
-
 void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc,
                           const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains)
 {
@@ -59,7 +59,8 @@ struct MapNode
     MapNode(MapNode&&) = default;
     MapNode& operator=(const MapNode&) = delete;
     MapNode& operator=(MapNode&&) = default;
-    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc) const;
+    /// Deserialize a node stored before game data version 12.
+    /// Newer versions store planes of all nodes, see MapSerializer
     void Deserialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc,
                      const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains);
 };
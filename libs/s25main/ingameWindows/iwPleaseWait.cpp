@@ -5,6 +5,8 @@
 #include "iwPleaseWait.h"
 #include "Loader.h"
 #include "WindowManager.h"
+#include "controls/ctrlText.h"
+#include "helpers/format.hpp"
 #include "ogl/FontStyle.h"
 #include "gameData/const_gui_ids.h"
 
@@ -26,3 +28,8 @@ iwPleaseWait::~iwPleaseWait()
 {
     WINDOWMANAGER.SetCursor();
 }
+
+void iwPleaseWait::SetProgress(unsigned percentage)
+{
+    GetCtrl<ctrlText>(0)->SetText(helpers::format("%s (%u%%)", _("Please wait..."), percentage));
+}
@@ -12,4 +12,7 @@ class iwPleaseWait : public IngameWindow
 public:
     iwPleaseWait();
     ~iwPleaseWait() override;
+
+    /// Show the progress of the operation we are waiting for
+    void SetProgress(unsigned percentage);
 };
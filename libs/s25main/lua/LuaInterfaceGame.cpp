@@ -17,6 +17,49 @@
 #include "gameTypes/Resource.h"
 #include "s25util/Serializer.h"
 #include "s25util/strAlgos.h"
+#include <algorithm>
+#include <string>
+
+/// Measures the time of a handler call and enforces the instruction budget
+class LuaInterfaceGame::HandlerCall
+{
+public:
+    HandlerCall(LuaInterfaceGame& luaInterface, Handler handler)
+        : luaInterface_(luaInterface), stats_(luaInterface.handlerStats_[static_cast<unsigned>(handler)]),
+          startTime_(std::chrono::steady_clock::now())
+    {
+        if(luaInterface_.handlerCallDepth_++ == 0 && luaInterface_.instructionBudget_)
+        {
+            lua_sethook(luaInterface_.lua.state(), &InstructionBudgetExceeded, LUA_MASKCOUNT,
+                        static_cast<int>(luaInterface_.instructionBudget_));
+            hasHook_ = true;
+        }
+    }
+    HandlerCall(const HandlerCall&) = delete;
+    HandlerCall& operator=(const HandlerCall&) = delete;
+    ~HandlerCall()
+    {
+        --luaInterface_.handlerCallDepth_;
+        if(hasHook_)
+            lua_sethook(luaInterface_.lua.state(), nullptr, 0, 0);
+        const auto duration =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime_);
+        stats_.numCalls++;
+        stats_.totalTime += duration;
+        stats_.maxTime = std::max(stats_.maxTime, duration);
+    }
+
+private:
+    static void InstructionBudgetExceeded(lua_State* L, lua_Debug*)
+    {
+        luaL_error(L, "Instruction budget of the event handler exceeded");
+    }
+
+    LuaInterfaceGame& luaInterface_;
+    HandlerStats& stats_;
+    const std::chrono::steady_clock::time_point startTime_;
+    bool hasHook_ = false;
+};
 
 LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGameState)
     : LuaInterfaceGameBase(localGameState), localGameState(localGameState), gw(gameInstance.world_), game(gameInstance)
@@ -188,6 +231,21 @@ LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGam
     LuaWorld::Register(lua);
 
     lua["rttr"] = this;
+
+    // Get notified when handlers get defined (which sets a new global) using a metatable for the globals
+    handlerDefined_.fill(false);
+    lua_State* L = lua.state();
+#if LUA_VERSION_NUM >= 502
+    lua_pushglobaltable(L);
+#else
+    lua_pushvalue(L, LUA_GLOBALSINDEX);
+#endif
+    lua_newtable(L);
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &LuaInterfaceGame::OnNewGlobal, 1);
+    lua_setfield(L, -2, "__newindex");
+    lua_setmetatable(L, -2);
+    lua_pop(L, 1);
 }
 
 LuaInterfaceGame::~LuaInterfaceGame() = default;
@@ -224,10 +282,13 @@ void LuaInterfaceGame::Register(kaguya::State& state)
 
 bool LuaInterfaceGame::Serialize(Serializer& luaSaveState)
 {
-    kaguya::LuaRef save = lua["onSave"];
+    if(!HasHandler(Handler::Save))
+        return true;
+    kaguya::LuaRef save = GetHandler(Handler::Save);
     if(save.type() == LUA_TFUNCTION)
     {
         clearErrorOccured();
+        HandlerCall call(*this, Handler::Save);
         if(save.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred())
             return true;
         else
@@ -241,10 +302,13 @@ bool LuaInterfaceGame::Serialize(Serializer& luaSaveState)
 
 bool LuaInterfaceGame::Deserialize(Serializer& luaSaveState)
 {
-    kaguya::LuaRef load = lua["onLoad"];
+    if(!HasHandler(Handler::Load))
+        return true;
+    kaguya::LuaRef load = GetHandler(Handler::Load);
     if(load.type() == LUA_TFUNCTION)
     {
         clearErrorOccured();
+        HandlerCall call(*this, Handler::Load);
         return load.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
     } else
         return true;
@@ -334,9 +398,12 @@ LuaWorld LuaInterfaceGame::GetWorld()
 
 void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigned char owner)
 {
-    kaguya::LuaRef onExplored = lua["onExplored"];
+    if(!HasHandler(Handler::Explored))
+        return;
+    kaguya::LuaRef onExplored = GetHandler(Handler::Explored);
     if(onExplored.type() == LUA_TFUNCTION)
     {
+        HandlerCall call(*this, Handler::Explored);
         if(owner == 0)
         {
             // No owner? Pass nil value to Lua.
@@ -351,61 +418,97 @@ void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigne
 
 void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 {
-    kaguya::LuaRef onOccupied = lua["onOccupied"];
+    if(!HasHandler(Handler::Occupied))
+        return;
+    kaguya::LuaRef onOccupied = GetHandler(Handler::Occupied);
     if(onOccupied.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::Occupied);
         onOccupied.call<void>(player, pt.x, pt.y);
+    }
 }
 
 void LuaInterfaceGame::EventAttack(unsigned char attackerPlayerId, unsigned char defenderPlayerId,
                                    unsigned attackerCount)
 {
-    kaguya::LuaRef onAttack = lua["onAttack"];
+    if(!HasHandler(Handler::Attack))
+        return;
+    kaguya::LuaRef onAttack = GetHandler(Handler::Attack);
     if(onAttack.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::Attack);
         onAttack.call<void>(attackerPlayerId, defenderPlayerId, attackerCount);
+    }
 }
 
 void LuaInterfaceGame::EventStart(bool isFirstStart)
 {
-    kaguya::LuaRef onStart = lua["onStart"];
+    if(!HasHandler(Handler::Start))
+        return;
+    kaguya::LuaRef onStart = GetHandler(Handler::Start);
     if(onStart.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::Start);
         onStart.call<void>(isFirstStart);
+    }
 }
 
 void LuaInterfaceGame::EventGameFrame(unsigned nr)
 {
-    kaguya::LuaRef onGameFrame = lua["onGameFrame"];
+    if(!HasHandler(Handler::GameFrame))
+        return;
+    kaguya::LuaRef onGameFrame = GetHandler(Handler::GameFrame);
     if(onGameFrame.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::GameFrame);
         onGameFrame.call<void>(nr);
+    }
 }
 
 void LuaInterfaceGame::EventResourceFound(unsigned char player, const MapPoint pt, ResourceType type,
                                           unsigned char quantity)
 {
-    kaguya::LuaRef onResourceFound = lua["onResourceFound"];
+    if(!HasHandler(Handler::ResourceFound))
+        return;
+    kaguya::LuaRef onResourceFound = GetHandler(Handler::ResourceFound);
     if(onResourceFound.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::ResourceFound);
         onResourceFound.call<void>(player, pt.x, pt.y, type, quantity);
+    }
 }
 
 bool LuaInterfaceGame::EventCancelPactRequest(PactType pt, unsigned char canceledByPlayerId,
                                               unsigned char targetPlayerId)
 {
-    kaguya::LuaRef onPactCancel = lua["onCancelPactRequest"];
+    if(!HasHandler(Handler::CancelPactRequest))
+        return true;
+    kaguya::LuaRef onPactCancel = GetHandler(Handler::CancelPactRequest);
     if(onPactCancel.type() == LUA_TFUNCTION)
+    {
+        HandlerCall call(*this, Handler::CancelPactRequest);
         return onPactCancel.call<bool>(pt, canceledByPlayerId, targetPlayerId);
+    }
     return true; // always accept pact cancel if there is no handler
 }
 
 void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggestedByPlayerId,
                                         unsigned char targetPlayerId, const unsigned duration)
 {
+    if(!HasHandler(Handler::SuggestPact))
+        return;
     AIPlayer* ai = game.GetAIPlayer(targetPlayerId);
     if(ai != nullptr)
     {
-        kaguya::LuaRef onPactCancel = lua["onSuggestPact"];
+        kaguya::LuaRef onPactCancel = GetHandler(Handler::SuggestPact);
         if(onPactCancel.type() == LUA_TFUNCTION)
         {
             AIInterface& aii = ai->getAIInterface();
-            auto luaResult = onPactCancel.call<bool>(pt, suggestedByPlayerId, targetPlayerId, duration);
+            bool luaResult;
+            {
+                HandlerCall call(*this, Handler::SuggestPact);
+                luaResult = onPactCancel.call<bool>(pt, suggestedByPlayerId, targetPlayerId, duration);
+            }
             if(luaResult)
                 aii.AcceptPact(gw.GetEvMgr().GetCurrentGF(), pt, suggestedByPlayerId);
             else
@@ -417,9 +520,12 @@ void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggest
 void LuaInterfaceGame::EventPactCanceled(const PactType pt, unsigned char canceledByPlayerId,
                                          unsigned char targetPlayerId)
 {
-    kaguya::LuaRef onPactCanceled = lua["onPactCanceled"];
+    if(!HasHandler(Handler::PactCanceled))
+        return;
+    kaguya::LuaRef onPactCanceled = GetHandler(Handler::PactCanceled);
     if(onPactCanceled.type() == LUA_TFUNCTION)
     {
+        HandlerCall call(*this, Handler::PactCanceled);
         onPactCanceled.call<void>(pt, canceledByPlayerId, targetPlayerId);
     }
 }
@@ -427,9 +533,59 @@ void LuaInterfaceGame::EventPactCanceled(const PactType pt, unsigned char cancel
 void LuaInterfaceGame::EventPactCreated(const PactType pt, unsigned char suggestedByPlayerId,
                                         unsigned char targetPlayerId, const unsigned duration)
 {
-    kaguya::LuaRef onPactCreated = lua["onPactCreated"];
+    if(!HasHandler(Handler::PactCreated))
+        return;
+    kaguya::LuaRef onPactCreated = GetHandler(Handler::PactCreated);
     if(onPactCreated.type() == LUA_TFUNCTION)
     {
+        HandlerCall call(*this, Handler::PactCreated);
         onPactCreated.call<void>(pt, suggestedByPlayerId, targetPlayerId, duration);
     }
 }
+
+const char* LuaInterfaceGame::GetHandlerName(const Handler handler)
+{
+    switch(handler)
+    {
+        case Handler::Explored: return "onExplored";
+        case Handler::Occupied: return "onOccupied";
+        case Handler::Attack: return "onAttack";
+        case Handler::Start: return "onStart";
+        case Handler::GameFrame: return "onGameFrame";
+        case Handler::ResourceFound: return "onResourceFound";
+        case Handler::CancelPactRequest: return "onCancelPactRequest";
+        case Handler::SuggestPact: return "onSuggestPact";
+        case Handler::PactCanceled: return "onPactCanceled";
+        case Handler::PactCreated: return "onPactCreated";
+        case Handler::Save: return "onSave";
+        case Handler::Load: return "onLoad";
+    }
+    return "";
+}
+
+int LuaInterfaceGame::OnNewGlobal(lua_State* L)
+{
+    // Arguments: globals table, key, value
+    auto* self = static_cast<LuaInterfaceGame*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if(lua_type(L, 2) == LUA_TSTRING && !lua_isnil(L, 3))
+    {
+        const std::string name = lua_tostring(L, 2);
+        for(unsigned i = 0; i < NUM_HANDLERS; i++)
+        {
+            if(name == GetHandlerName(static_cast<Handler>(i)))
+                self->handlerDefined_[i] = true;
+        }
+    }
+    lua_settop(L, 3);
+    lua_rawset(L, 1);
+    return 0;
+}
+
+kaguya::LuaRef LuaInterfaceGame::GetHandler(const Handler handler)
+{
+    kaguya::LuaRef result = lua[GetHandlerName(handler)];
+    // Removed, so it can only be defined again by setting a new global
+    if(result.type() == LUA_TNIL)
+        handlerDefined_[static_cast<unsigned>(handler)] = false;
+    return result;
+}
@@ -7,6 +7,8 @@
 #include "LuaInterfaceGameBase.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/PactTypes.h"
+#include <array>
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -20,6 +22,32 @@ enum class ResourceType : uint8_t;
 class LuaInterfaceGame : public LuaInterfaceGameBase
 {
 public:
+    /// Events which the script can handle by defining a global function
+    enum class Handler : uint8_t
+    {
+        Explored,
+        Occupied,
+        Attack,
+        Start,
+        GameFrame,
+        ResourceFound,
+        CancelPactRequest,
+        SuggestPact,
+        PactCanceled,
+        PactCreated,
+        Save,
+        Load
+    };
+    static constexpr unsigned NUM_HANDLERS = 12;
+
+    /// Time spent in a handler (wall time, so for profiling only)
+    struct HandlerStats
+    {
+        unsigned numCalls = 0;
+        std::chrono::nanoseconds totalTime{0};
+        std::chrono::nanoseconds maxTime{0};
+    };
+
     // Passing Game by reference here relies on LuaInterfaceGame being part of Game
     LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGameState);
     virtual ~LuaInterfaceGame();
@@ -59,10 +87,36 @@ public:
     void PostMessageLua(int playerIdx, const std::string& msg);
     void PostMessageWithLocation(int playerIdx, const std::string& msg, int x, int y);
 
+    /// Return the name of the Lua function handling the event
+    static const char* GetHandlerName(Handler handler);
+    /// Return true if the script defines (or might define) a handler for the event
+    bool HasHandler(Handler handler) const { return handlerDefined_[static_cast<unsigned>(handler)]; }
+    const HandlerStats& GetHandlerStats(Handler handler) const
+    {
+        return handlerStats_[static_cast<unsigned>(handler)];
+    }
+    /// Abort handlers executing more than that many Lua instructions with an error (0 = unlimited).
+    /// For tests and profiling only as the count depends on the Lua version
+    void SetInstructionBudget(unsigned maxInstructions) { instructionBudget_ = maxInstructions; }
+
 private:
+    class HandlerCall;
+
     ILocalGameState& localGameState;
     GameWorld& gw;
     Game& game;
+    /// Handlers which are defined. Handlers only become defined by setting a new global, which is tracked by a
+    /// metamethod, so events without a handler don't need to access the Lua state at all
+    std::array<bool, NUM_HANDLERS> handlerDefined_;
+    std::array<HandlerStats, NUM_HANDLERS> handlerStats_;
+    unsigned instructionBudget_ = 0;
+    /// Number of handlers currently executing (they might trigger other events)
+    unsigned handlerCallDepth_ = 0;
+
     LuaPlayer GetPlayer(int playerIdx);
     LuaWorld GetWorld();
+    /// Called by Lua when a new global is set
+    static int OnNewGlobal(lua_State* L);
+    /// Return the function handling the event or nil if there is none
+    kaguya::LuaRef GetHandler(Handler handler);
 };
@@ -4,32 +4,103 @@
 
 #include "mapGenerator/Algorithms.h"
 #include "helpers/mathFuncs.h"
+#include "mapGenerator/Parallel.h"
+#include <algorithm>
 
 namespace rttr::mapGenerator {
 
-void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue)
+std::array<std::vector<Position>, 2> GetRadiusOffsets(unsigned radius)
 {
-    while(!queue.empty())
+    // Use a map big enough to not wrap around
+    MapBase map;
+    map.Resize(MapExtent::all(static_cast<MapCoord>(4 * radius + 4)));
+    std::array<std::vector<Position>, 2> offsets;
+    for(unsigned parity = 0; parity < 2; ++parity)
     {
-        const auto currentPoint = queue.front();
-        const auto currentDistance = distances[currentPoint];
-
-        queue.pop();
+        const MapPoint center(2 * radius + 2, 2 * radius + 2 + parity);
+        for(const MapPoint& pt : map.GetPointsInRadius(center, radius))
+            offsets[parity].push_back(Position(pt) - Position(center));
+    }
+    return offsets;
+}
 
-        const auto& neighbors = distances.GetNeighbours(currentPoint);
+void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue)
+{
+    auto scratch = ScratchArena::Acquire();
+    scratch->frontier.clear();
+    for(; !queue.empty(); queue.pop())
+        scratch->frontier.push_back(queue.front());
+    UpdateDistances(distances, *scratch);
+}
 
-        for(const MapPoint& neighbor : neighbors)
+namespace {
+/// Breadth-first search processing the points one by one, used if the initial points have different distances
+void UpdateDistancesSequential(NodeMapBase<unsigned>& distances, std::vector<MapPoint>& queue)
+{
+    // The vector is used as a queue, processed points are not removed
+    for(unsigned i = 0; i < queue.size(); ++i)
+    {
+        const MapPoint currentPoint = queue[i];
+        const unsigned currentDistance = distances[currentPoint];
+        for(const MapPoint& neighbor : distances.GetNeighbours(currentPoint))
         {
             if(distances[neighbor] > 0)
             {
                 if(distances[neighbor] == unsigned(-1))
+                    queue.push_back(neighbor);
+                distances[neighbor] = std::min(distances[neighbor], currentDistance + 1);
+            }
+        }
+    }
+    queue.clear();
+}
+} // namespace
+
+void UpdateDistances(NodeMapBase<unsigned>& distances, ScratchArena& scratch)
+{
+    // Level synchronous breadth-first search: The candidates of the next level are searched in parallel while the
+    // distances are only read. They are assigned afterwards in a fixed order, so the result is always the same.
+    std::vector<MapPoint>& frontier = scratch.frontier;
+    std::vector<MapPoint>& nextFrontier = scratch.nextFrontier;
+    std::vector<MapPoint>& candidates = scratch.candidates;
+    nextFrontier.clear();
+    // Each level is expanded at once, which requires all points of the initial level to have the same distance
+    if(!std::all_of(frontier.begin(), frontier.end(), [&distances, &frontier](const MapPoint& pt) {
+           return distances[pt] == distances[frontier.front()];
+       }))
+    {
+        UpdateDistancesSequential(distances, frontier);
+        return;
+    }
+    while(!frontier.empty())
+    {
+        const unsigned nextDistance = distances[frontier.front()] + 1;
+        candidates.assign(frontier.size() * helpers::NumEnumValues_v<Direction>, MapPoint::Invalid());
+
+        ParallelFor(static_cast<unsigned>(frontier.size()), 1024, [&](unsigned begin, unsigned end) {
+            for(unsigned i = begin; i < end; ++i)
+            {
+                auto* curCandidate = &candidates[i * helpers::NumEnumValues_v<Direction>];
+                for(const MapPoint& neighbor : distances.GetNeighbours(frontier[i]))
                 {
-                    queue.push(neighbor);
+                    // Points with distance 0 are either flagged or excluded
+                    if(distances[neighbor] > nextDistance)
+                        *(curCandidate++) = neighbor;
                 }
-
-                distances[neighbor] = std::min(distances[neighbor], currentDistance + 1);
             }
+        });
+
+        for(const MapPoint& candidate : candidates)
+        {
+            if(!candidate.isValid() || distances[candidate] <= nextDistance)
+                continue;
+            // Only unvisited points get expanded, others (e.g. default value) are just updated
+            if(distances[candidate] == unsigned(-1))
+                nextFrontier.push_back(candidate);
+            distances[candidate] = nextDistance;
         }
+        std::swap(frontier, nextFrontier);
+        nextFrontier.clear();
     }
 }
 
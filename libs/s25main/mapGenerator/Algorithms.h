@@ -7,11 +7,15 @@
 #include "RttrForeachPt.h"
 #include "helpers/containerUtils.h"
 #include "mapGenerator/NodeMapUtilities.h"
+#include "mapGenerator/Parallel.h"
+#include "mapGenerator/ScratchArena.h"
 #include "world/NodeMapBase.h"
+#include <array>
 #include <cmath>
 #include <queue>
 #include <set>
 #include <stdexcept>
+#include <vector>
 
 namespace rttr::mapGenerator {
 
@@ -27,6 +31,9 @@ auto join(const T& container)
     return joined;
 }
 
+/// Offsets of the points in the given radius around a point (excluding it) for points in even (0) and odd (1) rows
+std::array<std::vector<Position>, 2> GetRadiusOffsets(unsigned radius);
+
 /**
  * Smoothes the specified nodes with a smoothing kernel of the specified extent (radius).
  *
@@ -37,28 +44,61 @@ auto join(const T& container)
 template<typename T>
 void Smooth(unsigned iterations, unsigned radius, NodeMapBase<T>& nodes)
 {
-    const MapExtent& size = nodes.GetSize();
-    std::vector<std::vector<MapPoint>> neighbors(size.x * size.y);
-
-    RTTR_FOREACH_PT(MapPoint, size)
-    {
-        neighbors[nodes.GetIdx(pt)] = nodes.GetPointsInRadius(pt, radius);
-    }
-
+    const MapExtent size = nodes.GetSize();
+    // The points in the radius only depend on the parity of the row if the height is even.
+    // Otherwise and if the radius is too big to wrap around the map only once use the generic calculation.
+    const auto offsets = GetRadiusOffsets(radius);
+    const bool useGenericCalculation = size.y % 2u != 0u || radius >= std::min(size.x, size.y);
+
+    // Each iteration reads only the values of the previous one so the nodes can be smoothed in parallel
+    NodeMapBase<T> previous;
     for(unsigned i = 0; i < iterations; ++i)
     {
-        RTTR_FOREACH_PT(MapPoint, size)
-        {
-            int sum = static_cast<int>(nodes[pt]);
-            const auto& neighborPoints = neighbors[nodes.GetIdx(pt)];
-
-            for(const MapPoint& p : neighborPoints)
+        previous = nodes;
+        ParallelFor(size.y, 8, [&](unsigned firstRow, unsigned endRow) {
+            std::vector<unsigned> rowStarts;
+            for(MapPoint pt(0, firstRow); pt.y < endRow; ++pt.y)
             {
-                sum += static_cast<int>(nodes[p]);
+                const auto& curOffsets = offsets[pt.y & 1u];
+                const unsigned numPoints = curOffsets.size() + 1u;
+                if(useGenericCalculation)
+                {
+                    for(pt.x = 0; pt.x < size.x; ++pt.x)
+                    {
+                        int sum = static_cast<int>(previous[pt]);
+                        for(const MapPoint& p : previous.GetPointsInRadius(pt, radius))
+                            sum += static_cast<int>(previous[p]);
+                        nodes[pt] = static_cast<T>(round(static_cast<double>(sum) / numPoints));
+                    }
+                    continue;
+                }
+                // Start index of the row of each offset
+                rowStarts.resize(curOffsets.size());
+                for(unsigned j = 0; j < curOffsets.size(); ++j)
+                {
+                    int y = pt.y + curOffsets[j].y;
+                    if(y < 0)
+                        y += size.y;
+                    else if(y >= size.y)
+                        y -= size.y;
+                    rowStarts[j] = static_cast<unsigned>(y) * size.x;
+                }
+                for(pt.x = 0; pt.x < size.x; ++pt.x)
+                {
+                    int sum = static_cast<int>(previous[pt]);
+                    for(unsigned j = 0; j < curOffsets.size(); ++j)
+                    {
+                        int x = pt.x + curOffsets[j].x;
+                        if(x < 0)
+                            x += size.x;
+                        else if(x >= size.x)
+                            x -= size.x;
+                        sum += static_cast<int>(previous[rowStarts[j] + static_cast<unsigned>(x)]);
+                    }
+                    nodes[pt] = static_cast<T>(round(static_cast<double>(sum) / numPoints));
+                }
             }
-
-            nodes[pt] = static_cast<T>(round(static_cast<double>(sum) / (neighborPoints.size() + 1)));
-        }
+        });
     }
 }
 
@@ -111,28 +151,33 @@ void Scale(NodeMapBase<T>& values, T minimum, T maximum)
 template<typename T>
 std::vector<MapPoint> Collect(const MapBase& map, const MapPoint& pt, T&& evaluator)
 {
-    std::set<MapPoint, MapPointLess> visited;
     std::vector<MapPoint> body;
-    std::queue<MapPoint> searchSpace;
+    if(!evaluator(pt))
+    {
+        return body;
+    }
+
+    auto scratch = ScratchArena::Acquire();
+    VisitPlane& visited = scratch->visited;
+    RingQueue<MapPoint>& searchSpace = scratch->queue;
+    visited.Reset(map.GetSize());
+    searchSpace.clear();
 
+    // Points are marked as visited when evaluated, so each point is evaluated and enqueued at most once
+    visited.Visit(map.GetIdx(pt));
     searchSpace.push(pt);
 
     while(!searchSpace.empty())
     {
-        MapPoint currentPoint = searchSpace.front();
+        const MapPoint currentPoint = searchSpace.front();
         searchSpace.pop();
+        body.push_back(currentPoint);
 
-        if(evaluator(currentPoint))
+        for(const MapPoint neighbor : map.GetNeighbours(currentPoint))
         {
-            if(visited.insert(currentPoint).second)
+            if(visited.Visit(map.GetIdx(neighbor)) && evaluator(neighbor))
             {
-                body.push_back(currentPoint);
-
-                const auto& neighbors = map.GetNeighbours(currentPoint);
-                for(MapPoint neighbor : neighbors)
-                {
-                    searchSpace.push(neighbor);
-                }
+                searchSpace.push(neighbor);
             }
         }
     }
@@ -142,13 +187,19 @@ std::vector<MapPoint> Collect(const MapBase& map, const MapPoint& pt, T&& evalua
 
 /**
  * Updates the specified distance values to the values initially contained by the queue. The queue is being
- * modified throughout the process for performance reasons.
+ * modified throughout the process for performance reasons. If all points in the queue have the same distance the
+ * search is done in parallel.
  *
  * @param distances distance map which is being updated
  * @param queue queue with initial elements to used for distance computation
  */
 void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue);
 
+/**
+ * Same as above but starts with the points in the frontier of the scratch arena.
+ */
+void UpdateDistances(NodeMapBase<unsigned>& distances, ScratchArena& scratch);
+
 /**
  * Computes a map of distance values describing the distance of each grid position to the closest flagged point.
  *
@@ -160,17 +211,21 @@ void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& que
 template<class T_Container>
 NodeMapBase<unsigned> DistancesTo(const T_Container& flaggedPoints, const MapExtent& size)
 {
-    std::queue<MapPoint> queue;
+    auto scratch = ScratchArena::Acquire();
+    scratch->frontier.clear();
     NodeMapBase<unsigned> distances;
     distances.Resize(size, unsigned(-1));
 
     for(const MapPoint& pt : flaggedPoints)
     {
-        distances[pt] = 0;
-        queue.push(pt);
+        if(distances[pt] != 0)
+        {
+            distances[pt] = 0;
+            scratch->frontier.push_back(pt);
+        }
     }
 
-    UpdateDistances(distances, queue);
+    UpdateDistances(distances, *scratch);
 
     return distances;
 }
@@ -178,7 +233,23 @@ NodeMapBase<unsigned> DistancesTo(const T_Container& flaggedPoints, const MapExt
 template<typename T>
 NodeMapBase<unsigned> DistancesTo(const MapExtent& size, T&& evaluator)
 {
-    return DistancesTo(SelectPoints(evaluator, size), size);
+    auto scratch = ScratchArena::Acquire();
+    scratch->frontier.clear();
+    NodeMapBase<unsigned> distances;
+    distances.Resize(size, unsigned(-1));
+
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        if(evaluator(pt))
+        {
+            distances[pt] = 0;
+            scratch->frontier.push_back(pt);
+        }
+    }
+
+    UpdateDistances(distances, *scratch);
+
+    return distances;
 }
 
 /**
@@ -197,7 +268,8 @@ template<typename T, class T_Container>
 NodeMapBase<unsigned> Distances(const MapExtent& size, const T_Container& area, const unsigned defaultValue,
                                 T&& evaluator)
 {
-    std::queue<MapPoint> queue;
+    auto scratch = ScratchArena::Acquire();
+    scratch->frontier.clear();
     NodeMapBase<unsigned> distances;
     distances.Resize(size, defaultValue);
 
@@ -206,14 +278,14 @@ NodeMapBase<unsigned> Distances(const MapExtent& size, const T_Container& area,
         if(evaluator(pt))
         {
             distances[pt] = 0;
-            queue.push(pt);
+            scratch->frontier.push_back(pt);
         } else
         {
             distances[pt] = unsigned(-1);
         }
     }
 
-    UpdateDistances(distances, queue);
+    UpdateDistances(distances, *scratch);
 
     return distances;
 }
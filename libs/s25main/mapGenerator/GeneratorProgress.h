@@ -0,0 +1,48 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace rttr::mapGenerator {
+
+/// Thrown by the generator when the generation was canceled
+class GenerationCanceled : public std::runtime_error
+{
+public:
+    GenerationCanceled() : std::runtime_error("Map generation was canceled") {}
+};
+
+/// Observes the progress of a map generation which may run in a different thread and allows canceling it
+class GeneratorProgress
+{
+public:
+    /// Called from the generator thread with the percentage done
+    using Callback = std::function<void(unsigned percentage)>;
+
+    explicit GeneratorProgress(Callback callback = Callback()) : callback_(std::move(callback)), canceled_(false) {}
+
+    /// Request the generation to stop. It will do so at the next progress report
+    void cancel() { canceled_ = true; }
+    bool isCanceled() const { return canceled_; }
+
+    /// Report that the given percentage of the generation is done. Throws GenerationCanceled if canceled
+    void report(unsigned percentage)
+    {
+        if(canceled_)
+            throw GenerationCanceled();
+        if(callback_)
+            callback_(percentage);
+    }
+
+private:
+    Callback callback_;
+    std::atomic<bool> canceled_;
+};
+
+} // namespace rttr::mapGenerator
@@ -0,0 +1,24 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mapGenerator/Parallel.h"
+#include <algorithm>
+
+namespace rttr::mapGenerator {
+
+unsigned GetNumWorkerThreads()
+{
+    // hardware_concurrency may return 0 if unknown
+    static const unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    return numThreads;
+}
+
+WorkerPool& GetWorkerPool()
+{
+    // One pool per generating thread, so maps can be generated concurrently
+    thread_local WorkerPool pool(GetNumWorkerThreads());
+    return pool;
+}
+
+} // namespace rttr::mapGenerator
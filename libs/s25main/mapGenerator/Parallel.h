@@ -0,0 +1,60 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "WorkerPool.h"
+#include "gameTypes/MapCoordinates.h"
+#include <algorithm>
+
+namespace rttr::mapGenerator {
+
+/// Number of threads used for the data-parallel passes of the generator
+unsigned GetNumWorkerThreads();
+/// Pool of the calling thread for the data-parallel passes.
+/// Its threads are kept between the passes as e.g. each level of a breadth-first search is a separate pass.
+WorkerPool& GetWorkerPool();
+
+/**
+ * Calls func(begin, end) for consecutive blocks of [0, count) which together cover the whole range.
+ * The blocks are processed in parallel, so func may only write data belonging to its block.
+ * As the blocks don't depend on each other the result is the same as for a sequential execution.
+ *
+ * @param count number of elements
+ * @param minBlockSize minimum number of elements worth a separate thread
+ * @param func function taking the begin and end index of the block
+ */
+template<typename T_Func>
+void ParallelFor(unsigned count, unsigned minBlockSize, T_Func&& func)
+{
+    const unsigned numBlocks = std::max(1u, std::min(GetNumWorkerThreads(), count / std::max(1u, minBlockSize)));
+    if(numBlocks <= 1u)
+    {
+        func(0u, count);
+        return;
+    }
+    GetWorkerPool().run(numBlocks, [&func, count, numBlocks](unsigned block) {
+        func(block * count / numBlocks, (block + 1) * count / numBlocks);
+    });
+}
+
+/**
+ * Calls func(pt) for every point of the map with the rows distributed over multiple threads.
+ * func may only write data belonging to pt.
+ */
+template<typename T_Func>
+void ParallelForEachPt(const MapExtent& size, T_Func&& func)
+{
+    // Don't start threads for less than 32 rows of 64 nodes each
+    const unsigned minRows = std::max(1u, 32u * 64u / std::max<unsigned>(1u, size.x));
+    ParallelFor(size.y, minRows, [&func, &size](unsigned firstRow, unsigned endRow) {
+        for(MapPoint pt(0, firstRow); pt.y < endRow; ++pt.y)
+        {
+            for(pt.x = 0; pt.x < size.x; ++pt.x)
+                func(pt);
+        }
+    });
+}
+
+} // namespace rttr::mapGenerator
@@ -119,16 +119,23 @@ void SmoothHeightMap(NodeMapBase<uint8_t>& z, const ValueRange<uint8_t>& range)
     Scale(z, range.minimum, range.maximum);
 }
 
-RandomMap::RandomMap(RandomUtility& rnd, Map& map)
-    : rnd_(rnd), map_(map), texturizer_(map.z, map.getTextures(), map.textureMap)
+RandomMap::RandomMap(RandomUtility& rnd, Map& map, GeneratorProgress* progress)
+    : rnd_(rnd), map_(map), texturizer_(map.z, map.getTextures(), map.textureMap), progress_(progress)
 {}
 
+void RandomMap::ReportProgress(unsigned percentage)
+{
+    if(progress_)
+        progress_->report(percentage);
+}
+
 void RandomMap::Create(const MapSettings& settings)
 {
     auto defaultHeight = map_.height.minimum + map_.height.GetDifference() / 2;
 
     settings_ = settings;
     map_.z.Resize(settings.size, defaultHeight);
+    ReportProgress(0);
 
     switch(settings.style)
     {
@@ -139,8 +146,11 @@ void RandomMap::Create(const MapSettings& settings)
         case MapStyle::Land: CreateLandMap(); break;
     }
 
+    ReportProgress(70);
     AddObjects(map_, rnd_, settings_);
+    ReportProgress(80);
     AddResources(map_, rnd_, settings_);
+    ReportProgress(90);
     AddAnimals(map_, rnd_);
 }
 
@@ -190,6 +200,7 @@ void RandomMap::CreateMixedMap()
         return rnd_.ByChance(percentage);
     });
     SmoothHeightMap(map_.z, map_.height);
+    ReportProgress(30);
 
     const double sea = 0.5;
     const double mountain = 0.1;
@@ -203,7 +214,9 @@ void RandomMap::CreateMixedMap()
 
     CreateFreeIslands(waterNodes);
 
+    ReportProgress(50);
     texturizer_.AddTextures(mountainLevel, GetCoastline(map_.size));
+    ReportProgress(60);
 
     PlaceHarbors(map_, rivers);
     PlaceHeadquarters(map_, rnd_, map_.players, settings_.mountainDistance);
@@ -220,6 +233,7 @@ void RandomMap::CreateWaterMap()
         return rnd_.ByChance(percentage);
     });
     SmoothHeightMap(map_.z, map_.height);
+    ReportProgress(30);
 
     const double sea = 0.80;      // 20% of map is center island (100% - 80% water)
     const double mountain = 0.05; // 20% of center island is mountain (5% of 20% land)
@@ -247,7 +261,9 @@ void RandomMap::CreateWaterMap()
 
     const auto rivers = CreateRivers(center);
 
+    ReportProgress(50);
     texturizer_.AddTextures(mountainLevel, GetCoastline(map_.size));
+    ReportProgress(60);
 
     PlaceHarbors(map_, rivers);
 
@@ -261,6 +277,7 @@ void RandomMap::CreateLandMap()
 {
     Restructure(map_, [this](auto&&) { return rnd_.ByChance(5); });
     SmoothHeightMap(map_.z, map_.height);
+    ReportProgress(30);
 
     const double sea = rnd_.RandomDouble(0.1, 0.2);
     const double mountain = rnd_.RandomDouble(0.15, 0.4 - sea);
@@ -271,27 +288,32 @@ void RandomMap::CreateLandMap()
     const auto mountainLevel = LimitFor(map_.z, land, static_cast<uint8_t>(1)) + 1;
     CreateRivers();
 
+    ReportProgress(50);
     texturizer_.AddTextures(mountainLevel, GetCoastline(map_.size));
+    ReportProgress(60);
 
     PlaceHeadquarters(map_, rnd_, map_.players, settings_.mountainDistance);
 }
 
-Map GenerateRandomMap(RandomUtility& rnd, const WorldDescription& worldDesc, const MapSettings& settings)
+Map GenerateRandomMap(RandomUtility& rnd, const WorldDescription& worldDesc, const MapSettings& settings,
+                      GeneratorProgress* progress)
 {
     auto height = GetMaximumHeight(settings.size);
     Map map(settings.size, settings.numPlayers, worldDesc, settings.type, height);
-    RandomMap randomMap(rnd, map);
+    RandomMap randomMap(rnd, map, progress);
     randomMap.Create(settings);
     return map;
 }
 
-void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings)
+void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings, GeneratorProgress* progress)
 {
     RandomUtility rnd;
     WorldDescription worldDesc;
     loadGameData(worldDesc);
 
-    Map map = GenerateRandomMap(rnd, worldDesc, settings);
+    Map map = GenerateRandomMap(rnd, worldDesc, settings, progress);
+    if(progress)
+        progress->report(95);
     libsiedler2::Write(filePath, map.CreateArchiv());
 }
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "mapGenerator/GeneratorProgress.h"
 #include "mapGenerator/Map.h"
 #include "mapGenerator/MapSettings.h"
 #include "mapGenerator/RandomUtility.h"
@@ -29,7 +30,10 @@ private:
     Map& map_;
     Texturizer texturizer_;
     MapSettings settings_;
+    GeneratorProgress* progress_;
 
+    /// Report the progress if requested. Throws GenerationCanceled if the generation should stop
+    void ReportProgress(unsigned percentage);
     std::vector<River> CreateRivers(MapPoint source = MapPoint::Invalid());
     void CreateFreeIslands(unsigned waterNodes);
     void CreateMixedMap();
@@ -37,11 +41,15 @@ private:
     void CreateWaterMap();
 
 public:
-    RandomMap(RandomUtility& rnd, Map& map);
+    RandomMap(RandomUtility& rnd, Map& map, GeneratorProgress* progress = nullptr);
     void Create(const MapSettings& settings);
 };
 
-Map GenerateRandomMap(RandomUtility& rnd, const WorldDescription& worldDesc, const MapSettings& settings);
-void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings);
+Map GenerateRandomMap(RandomUtility& rnd, const WorldDescription& worldDesc, const MapSettings& settings,
+                      GeneratorProgress* progress = nullptr);
+/// Generate a random map and write it to the given file.
+/// Can be run in a separate thread, the progress can be used to observe and cancel the generation
+void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings,
+                     GeneratorProgress* progress = nullptr);
 
 } // namespace rttr::mapGenerator
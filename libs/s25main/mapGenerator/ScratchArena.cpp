@@ -0,0 +1,42 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mapGenerator/ScratchArena.h"
+
+namespace rttr::mapGenerator {
+
+void VisitPlane::Reset(const MapExtent& size)
+{
+    const unsigned numNodes = prodOfComponents(size);
+    // Start over if the stamp would wrap around
+    if(stamps_.size() != numNodes || curStamp_ == UINT32_MAX)
+    {
+        stamps_.assign(numNodes, 0u);
+        curStamp_ = 0u;
+    }
+    ++curStamp_;
+}
+
+ScratchArena::Lease::Lease(ScratchArena& arena, std::unique_ptr<ScratchArena> tmpArena)
+    : arena_(tmpArena ? tmpArena.get() : &arena), tmpArena_(std::move(tmpArena))
+{
+    arena_->inUse_ = true;
+}
+
+ScratchArena::Lease::~Lease()
+{
+    // Moved-from leases have no arena
+    if(arena_ && !tmpArena_)
+        arena_->inUse_ = false;
+}
+
+ScratchArena::Lease ScratchArena::Acquire()
+{
+    thread_local ScratchArena threadArena;
+    if(threadArena.inUse_)
+        return Lease(threadArena, std::make_unique<ScratchArena>());
+    return Lease(threadArena, nullptr);
+}
+
+} // namespace rttr::mapGenerator
@@ -0,0 +1,124 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/MapCoordinates.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rttr::mapGenerator {
+
+/**
+ * Marks visited nodes of a map. Starting a new visit is O(1) as the nodes are compared against the stamp of the
+ * current visit instead of being cleared.
+ */
+class VisitPlane
+{
+public:
+    /// Start a new visit of a map of the given size with all nodes unvisited
+    void Reset(const MapExtent& size);
+    bool IsVisited(unsigned idx) const { return stamps_[idx] == curStamp_; }
+    /// Mark the node as visited. Returns false if it already was
+    bool Visit(unsigned idx)
+    {
+        if(stamps_[idx] == curStamp_)
+            return false;
+        stamps_[idx] = curStamp_;
+        return true;
+    }
+
+private:
+    std::vector<uint32_t> stamps_;
+    uint32_t curStamp_ = 0;
+};
+
+/// FIFO queue using a ring buffer which keeps its memory when cleared
+template<typename T>
+class RingQueue
+{
+public:
+    bool empty() const { return size_ == 0u; }
+    size_t size() const { return size_; }
+    void clear() { head_ = size_ = 0u; }
+    void reserve(size_t capacity)
+    {
+        if(capacity > buffer_.size())
+            grow(capacity);
+    }
+    void push(const T& value)
+    {
+        if(size_ == buffer_.size())
+            grow(std::max<size_t>(64u, buffer_.size() * 2u));
+        size_t tail = head_ + size_;
+        if(tail >= buffer_.size())
+            tail -= buffer_.size();
+        buffer_[tail] = value;
+        ++size_;
+    }
+    const T& front() const { return buffer_[head_]; }
+    void pop()
+    {
+        if(++head_ == buffer_.size())
+            head_ = 0u;
+        --size_;
+    }
+
+private:
+    void grow(size_t capacity)
+    {
+        std::vector<T> newBuffer(capacity);
+        for(size_t i = 0; i < size_; ++i)
+            newBuffer[i] = buffer_[(head_ + i) % buffer_.size()];
+        buffer_.swap(newBuffer);
+        head_ = 0u;
+    }
+
+    std::vector<T> buffer_;
+    size_t head_ = 0u, size_ = 0u;
+};
+
+/**
+ * Working memory reused by the passes of the generator to avoid allocations on every call.
+ * Each thread has its own arena which is acquired for the duration of a pass with ScratchArena::Acquire().
+ */
+class ScratchArena
+{
+public:
+    VisitPlane visited;
+    RingQueue<MapPoint> queue;
+    /// Points of the current and next level of a breadth-first search
+    std::vector<MapPoint> frontier, nextFrontier;
+    std::vector<MapPoint> candidates;
+
+    /// Exclusive access to an arena, released on destruction
+    class Lease
+    {
+    public:
+        Lease(Lease&& other) noexcept
+            : arena_(std::exchange(other.arena_, nullptr)), tmpArena_(std::move(other.tmpArena_))
+        {}
+        ~Lease();
+        ScratchArena& operator*() const { return *arena_; }
+        ScratchArena* operator->() const { return arena_; }
+
+    private:
+        friend class ScratchArena;
+        Lease(ScratchArena& arena, std::unique_ptr<ScratchArena> tmpArena);
+        ScratchArena* arena_;
+        /// Used if the arena of the thread was already in use
+        std::unique_ptr<ScratchArena> tmpArena_;
+    };
+
+    /// Get the arena of the current thread or a temporary one if it is already in use by an enclosing pass
+    static Lease Acquire();
+
+private:
+    bool inUse_ = false;
+};
+
+} // namespace rttr::mapGenerator
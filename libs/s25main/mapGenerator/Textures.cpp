@@ -4,6 +4,7 @@
 
 #include "mapGenerator/Textures.h"
 #include "mapGenerator/Algorithms.h"
+#include "mapGenerator/Parallel.h"
 #include "mapGenerator/TextureHelper.h"
 
 #include <algorithm>
@@ -84,7 +85,7 @@ void Texturizer::ApplyTexturingByHeightMap(unsigned mountainLevel)
     const MapExtent size = z_.GetSize();
     const auto& z = z_;
 
-    auto interpolateEdges = [&size, z](const Triangle& triangle) {
+    auto interpolateEdges = [&size, &z](const Triangle& triangle) {
         const auto& edges = GetTriangleEdges(triangle, size);
 
         // Assumptions:
@@ -93,13 +94,12 @@ void Texturizer::ApplyTexturingByHeightMap(unsigned mountainLevel)
         return static_cast<uint8_t>(std::ceil(static_cast<double>(z[edges[0]] + z[edges[1]] + z[edges[2]]) / 3));
     };
 
-    RTTR_FOREACH_PT(MapPoint, size)
-    {
+    ParallelForEachPt(size, [this, &mapping, &interpolateEdges](const MapPoint& pt) {
         if(!textures_[pt].rsu)
             textures_[pt].rsu = mapping[interpolateEdges(Triangle(true, pt))];
         if(!textures_[pt].lsd)
             textures_[pt].lsd = mapping[interpolateEdges(Triangle(false, pt))];
-    }
+    });
 }
 
 void Texturizer::ApplyCoastTexturing(const std::vector<MapPoint>& coast, unsigned width)
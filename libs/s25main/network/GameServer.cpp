@@ -772,6 +772,9 @@ bool GameServer::CheckForAsync()
         {
             LOG.write(_("Async at GF %1% of player %2% vs %3%. Checksums:\n%4%\n%5%\n\n")) % currentGF % player.playerId
               % networkPlayers.front().playerId % curChecksum % refChecksum;
+            const std::string differingParts = curChecksum.getDifferingStateParts(refChecksum);
+            if(!differingParts.empty())
+                LOG.write(_("Differing world state: %1%\n")) % differingParts;
             isAsync = true;
         }
     }
@@ -7,6 +7,7 @@
 #include "GamePlayer.h"
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
+#include "pathfinding/RoadNetworks.h"
 #include "world/GameWorld.h"
 #include "s25util/warningSuppression.h"
 
@@ -15,7 +16,6 @@ noRoadNode::noRoadNode(const NodalObjectType nop, const MapPoint pos, const unsi
 {
     for(const auto dir : helpers::EnumRange<Direction>{})
         routes[dir] = nullptr;
-    last_visit = 0;
 }
 
 noRoadNode::~noRoadNode() = default;
@@ -59,8 +59,12 @@ noRoadNode::noRoadNode(SerializedGameData& sgd, const unsigned obj_id)
     {
         routes[dir] = sgd.PopObject<RoadSegment>(GO_Type::Roadsegment);
     }
+}
 
-    last_visit = 0;
+void noRoadNode::SetRoute(const Direction dir, RoadSegment* route)
+{
+    routes[dir] = route;
+    world->GetRoadNetworks().clear();
 }
 
 void noRoadNode::UpgradeRoad(const Direction dir) const
@@ -7,7 +7,9 @@
 #include "notifications/Subscription.h"
 #include <deque>
 #include <functional>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 class NotificationManager
 {
@@ -18,17 +20,30 @@ class NotificationManager
     struct NoteCallback;
 
 public:
+    /// Collects all notes of a type published during its lifetime and publishes them as one batch at its end.
+    /// Used when many notes are published in a loop (e.g. for every node of a territory change).
+    /// Nested batches of the same type are merged into the outermost one.
+    template<class T_Note>
+    class Batch;
+
     ~NotificationManager();
 
     /// Subscribe to a specific notification.
     /// Unsubscribes when the subscription has no references left
     template<class T_Note>
     Subscription subscribe(std::function<void(const T_Note&)> callback) noexcept;
+    /// Subscribe to a specific notification receiving all notes published together at once.
+    /// Single notes are passed as a batch of 1 note
+    template<class T_Note>
+    Subscription subscribeBatch(std::function<void(const std::vector<T_Note>&)> callback) noexcept;
     /// Manually unsubscribes the callback
     static void unsubscribe(Subscription& subscription) noexcept;
     /// Call the registred callbacks for the note
     template<class T_Note>
     void publish(const T_Note& notification);
+    /// Call the registred callbacks for all notes. Batch callbacks are called once for all of them
+    template<class T_Note>
+    void publishBatch(const std::vector<T_Note>& notifications);
 
 private:
     /// We cannot store the real type of the callback in C++ (no mixed type list) so we store it as a void*
@@ -39,11 +54,20 @@ private:
         CallbackList callbacks;
         /// >0 when we are in the publish method
         unsigned isPublishing = 0;
+        /// Notes collected by the active batch (std::vector<T_Note>*) if any
+        void* batchNotes = nullptr;
+        /// Reused to pass single notes to batch callbacks (std::vector<T_Note>), created on first use
+        std::shared_ptr<void> singleNote;
     };
     std::unordered_map<uint32_t, Subscribers> noteId2Subscriber;
 
+    template<class T_Note>
+    Subscription addSubscriber(NoteCallback<T_Note>* subscriber) noexcept;
     template<class T_Note>
     void unsubscribe(NoteCallback<T_Note>* callback) noexcept;
+    /// Call func for every registered callback supporting (un)subscribing during the call
+    template<class T_Note, class T_Func>
+    void forEachCallback(Subscribers& subs, const T_Func& func);
 };
 
 #include "notifications/NotificationManager_impl.h"
@@ -11,6 +11,7 @@
 #include "RTTR_Assert.h"
 #include "helpers/containerUtils.h"
 #include <algorithm>
+#include <exception>
 #include <stdexcept>
 #include <utility>
 
@@ -30,8 +31,48 @@ template<class T_Note>
 struct NotificationManager::NoteCallback final : NoteCallbackBase
 {
     using Callback = std::function<void(const T_Note&)>;
+    using BatchCallback = std::function<void(const std::vector<T_Note>&)>;
     explicit NoteCallback(Callback callback) noexcept : execute(std::move(callback)) {}
+    explicit NoteCallback(BatchCallback callback) noexcept : executeBatch(std::move(callback)) {}
+    /// Exactly one of them is set
     const Callback execute;
+    const BatchCallback executeBatch;
+};
+
+template<class T_Note>
+class NotificationManager::Batch
+{
+public:
+    explicit Batch(NotificationManager& mgr)
+        : mgr_(mgr), subs_(mgr.noteId2Subscriber[T_Note::getNoteId()]),
+          numUncaughtExceptions_(std::uncaught_exceptions())
+    {
+        if(!subs_.batchNotes)
+        {
+            subs_.batchNotes = &notes_;
+            isOutermost_ = true;
+        }
+    }
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+    ~Batch() noexcept(false)
+    {
+        if(!isOutermost_)
+            return;
+        RTTR_Assert(subs_.batchNotes == &notes_);
+        // Notes published by the callbacks are delivered directly
+        subs_.batchNotes = nullptr;
+        // Don't call the callbacks when leaving the scope due to an exception
+        if(std::uncaught_exceptions() == numUncaughtExceptions_)
+            mgr_.publishBatch(notes_);
+    }
+
+private:
+    NotificationManager& mgr_;
+    Subscribers& subs_;
+    const int numUncaughtExceptions_;
+    bool isOutermost_ = false;
+    std::vector<T_Note> notes_;
 };
 
 inline NotificationManager::~NotificationManager()
@@ -57,7 +98,18 @@ inline void NotificationManager::unsubscribe(Subscription& subscription) noexcep
 template<class T_Note>
 Subscription NotificationManager::subscribe(std::function<void(const T_Note&)> callback) noexcept
 {
-    auto* subscriber = new NoteCallback<T_Note>(std::move(callback));
+    return addSubscriber(new NoteCallback<T_Note>(std::move(callback)));
+}
+
+template<class T_Note>
+Subscription NotificationManager::subscribeBatch(std::function<void(const std::vector<T_Note>&)> callback) noexcept
+{
+    return addSubscriber(new NoteCallback<T_Note>(std::move(callback)));
+}
+
+template<class T_Note>
+Subscription NotificationManager::addSubscriber(NoteCallback<T_Note>* subscriber) noexcept
+{
     noteId2Subscriber[T_Note::getNoteId()].callbacks.push_back(subscriber);
 
     return Subscription(subscriber, [this](void* subscription) {
@@ -90,6 +142,69 @@ template<class T_Note>
 void NotificationManager::publish(const T_Note& notification)
 {
     Subscribers& subs = noteId2Subscriber[T_Note::getNoteId()];
+    if(subs.batchNotes)
+    {
+        static_cast<std::vector<T_Note>*>(subs.batchNotes)->push_back(notification);
+        return;
+    }
+    // Batch callbacks get a batch of 1 note. Only filled if there is a batch callback.
+    // The vector of the subscribers is reused unless it is still in use by an outer publish, i.e. a callback publishes
+    std::vector<T_Note>* batch = nullptr;
+    std::vector<T_Note> nestedBatch;
+    const bool isNested = subs.isPublishing > 0u;
+    forEachCallback<T_Note>(subs, [&](const NoteCallback<T_Note>& cb) {
+        if(cb.execute)
+            cb.execute(notification);
+        else
+        {
+            if(!batch)
+            {
+                if(isNested)
+                    batch = &nestedBatch;
+                else
+                {
+                    if(!subs.singleNote)
+                        subs.singleNote = std::make_shared<std::vector<T_Note>>();
+                    batch = static_cast<std::vector<T_Note>*>(subs.singleNote.get());
+                    // Might still contain the note of a publish aborted by an exception
+                    batch->clear();
+                }
+                batch->push_back(notification);
+            }
+            cb.executeBatch(*batch);
+        }
+    });
+    if(batch)
+        batch->clear();
+}
+
+template<class T_Note>
+void NotificationManager::publishBatch(const std::vector<T_Note>& notifications)
+{
+    if(notifications.empty())
+        return;
+    Subscribers& subs = noteId2Subscriber[T_Note::getNoteId()];
+    if(subs.batchNotes)
+    {
+        auto& batchNotes = *static_cast<std::vector<T_Note>*>(subs.batchNotes);
+        // Notes might not be assignable, so insert is not possible
+        for(const T_Note& notification : notifications)
+            batchNotes.push_back(notification);
+        return;
+    }
+    forEachCallback<T_Note>(subs, [&notifications](const NoteCallback<T_Note>& cb) {
+        if(cb.execute)
+        {
+            for(const T_Note& notification : notifications)
+                cb.execute(notification);
+        } else
+            cb.executeBatch(notifications);
+    });
+}
+
+template<class T_Note, class T_Func>
+void NotificationManager::forEachCallback(Subscribers& subs, const T_Func& func)
+{
     ++subs.isPublishing;
     try
     {
@@ -103,7 +218,7 @@ void NotificationManager::publish(const T_Note& notification)
         {
             auto* cb = static_cast<NoteCallback<T_Note>*>(callbacks[i]);
             if(cb)
-                cb->execute(notification);
+                func(*cb);
             else
                 hasEmpty = true;
         }
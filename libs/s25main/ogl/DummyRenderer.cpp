@@ -20,9 +20,13 @@ void APIENTRY glDeleteTextures(GLsizei, const GLuint*) {}
 void APIENTRY glBindTexture(GLenum, GLuint) {}
 void APIENTRY glTexParameteri(GLenum, GLenum, GLint) {}
 void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*) {}
+void APIENTRY glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const GLvoid*) {}
 void APIENTRY glClear(GLbitfield) {}
 void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
 void APIENTRY glTexCoordPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
+void APIENTRY glColorPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
+void APIENTRY glEnableClientState(GLenum) {}
+void APIENTRY glDisableClientState(GLenum) {}
 void APIENTRY glColor4ub(GLubyte, GLubyte, GLubyte, GLubyte) {}
 void APIENTRY glDrawArrays(GLenum, GLint, GLsizei) {}
 void APIENTRY glGetTexLevelParameteriv(GLenum, GLint, GLenum, GLint* params)
@@ -42,9 +46,13 @@ bool DummyRenderer::initOpenGL(OpenGL_Loader_Proc)
     MOCK(glBindTexture);
     MOCK(glTexParameteri);
     MOCK(glTexImage2D);
+    MOCK(glTexSubImage2D);
     MOCK(glClear);
     MOCK(glVertexPointer);
     MOCK(glTexCoordPointer);
+    MOCK(glColorPointer);
+    MOCK(glEnableClientState);
+    MOCK(glDisableClientState);
     MOCK(glColor4ub);
     MOCK(glDrawArrays);
     MOCK(glGetTexLevelParameteriv);
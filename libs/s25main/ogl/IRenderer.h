@@ -8,6 +8,9 @@
 #include "Rect.h"
 
 class glArchivItem_Bitmap;
+namespace ogl {
+struct RGBAColor;
+}
 
 /// Render functions for basic stuff
 /// Abstracts away the used algorithms
@@ -34,4 +37,17 @@ public:
                                unsigned color) = 0;
     virtual void DrawRect(const Rect& rect, unsigned color) = 0;
     virtual void DrawLine(DrawPoint pt1, DrawPoint pt2, unsigned width, unsigned color) = 0;
+    /// Draw textured quads (4 vertices each) with per-vertex colors.
+    /// While sprite batching is active the quads may be drawn later, together with others using the same texture
+    virtual void DrawQuads(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords,
+                           const ogl::RGBAColor* colors, unsigned numVertices) = 0;
+    /// Start collecting quads drawn via DrawQuads into batches. Can be nested
+    virtual void BeginSpriteBatch() = 0;
+    /// Draw all collected quads and stop batching (if this ends the outermost batch)
+    virtual void EndSpriteBatch() = 0;
+    /// Draw all collected quads. Must be called before drawing anything not using DrawQuads to keep the draw order
+    virtual void FlushSprites() = 0;
+    /// Return the number of draw calls issued for quads since the last reset
+    virtual unsigned GetNumSpriteDrawCalls() const = 0;
+    virtual void ResetSpriteStatistics() = 0;
 };
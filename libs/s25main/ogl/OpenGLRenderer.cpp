@@ -4,6 +4,7 @@
 
 #include "OpenGLRenderer.h"
 #include "DrawPoint.h"
+#include "Settings.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "glArchivItem_Bitmap.h"
 #include "openglCfg.hpp"
@@ -16,6 +17,7 @@ void OpenGLRenderer::synchronize()
 
 void OpenGLRenderer::Draw3DBorder(const Rect& rect, bool elevated, glArchivItem_Bitmap& texture)
 {
+    spriteBatch_.flush();
     const Extent rectSize = rect.getSize();
     if(rectSize.x < 4 || rectSize.y < 4)
         return;
@@ -69,6 +71,7 @@ void OpenGLRenderer::Draw3DBorder(const Rect& rect, bool elevated, glArchivItem_
 void OpenGLRenderer::Draw3DContent(const Rect& rect, bool elevated, glArchivItem_Bitmap& texture, bool illuminated,
                                    unsigned color)
 {
+    spriteBatch_.flush();
     if(illuminated)
     {
         // Modulate2x anmachen
@@ -93,6 +96,7 @@ void OpenGLRenderer::Draw3DContent(const Rect& rect, bool elevated, glArchivItem
 
 void OpenGLRenderer::DrawRect(const Rect& rect, unsigned color)
 {
+    spriteBatch_.flush();
     glDisable(GL_TEXTURE_2D);
 
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
@@ -109,6 +113,7 @@ void OpenGLRenderer::DrawRect(const Rect& rect, unsigned color)
 
 void OpenGLRenderer::DrawLine(DrawPoint pt1, DrawPoint pt2, unsigned width, unsigned color)
 {
+    spriteBatch_.flush();
     glDisable(GL_TEXTURE_2D);
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
 
@@ -124,8 +129,11 @@ void OpenGLRenderer::DrawLine(DrawPoint pt1, DrawPoint pt2, unsigned width, unsi
 bool OpenGLRenderer::initOpenGL(OpenGL_Loader_Proc loader)
 {
 #if RTTR_OGL_ES
-    return gladLoadGLES2Loader(loader) != 0;
+    const bool loaded = gladLoadGLES2Loader(loader) != 0;
 #else
-    return gladLoadGLLoader(loader) != 0;
+    const bool loaded = gladLoadGLLoader(loader) != 0;
 #endif
+    if(loaded)
+        spriteBatch_.setUseVBO(SETTINGS.video.vbo);
+    return loaded;
 }
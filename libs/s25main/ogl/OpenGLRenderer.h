@@ -5,6 +5,7 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "SpriteBatch.h"
 
 class glArchivItem_Bitmap;
 
@@ -17,5 +18,18 @@ public:
     void Draw3DContent(const Rect& rect, bool elevated, glArchivItem_Bitmap& texture, bool illuminated,
                        unsigned color) override;
     void DrawRect(const Rect& rect, unsigned color) override;
+    void DrawQuads(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords,
+                   const ogl::RGBAColor* colors, unsigned numVertices) override
+    {
+        spriteBatch_.add(texture, vertices, texCoords, colors, numVertices);
+    }
+    void BeginSpriteBatch() override { spriteBatch_.begin(); }
+    void EndSpriteBatch() override { spriteBatch_.end(); }
+    void FlushSprites() override { spriteBatch_.flush(); }
+    unsigned GetNumSpriteDrawCalls() const override { return spriteBatch_.getNumDrawCalls(); }
+    void ResetSpriteStatistics() override { spriteBatch_.resetStatistics(); }
     void DrawLine(DrawPoint pt1, DrawPoint pt2, unsigned width, unsigned color) override;
+
+private:
+    ogl::SpriteBatch spriteBatch_;
 };
@@ -0,0 +1,110 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ogl/SpriteBatch.h"
+#include "RTTR_Assert.h"
+#include "drivers/VideoDriverWrapper.h"
+#include <cstdint>
+
+namespace ogl {
+
+SpriteBatch::SpriteBatch() : texture_(0), nestingLevel_(0), useVBO_(false), numDrawCalls_(0), numQuads_(0) {}
+
+void SpriteBatch::setUseVBO(bool useVBO)
+{
+    flush();
+    useVBO_ = useVBO;
+    if(!useVBO_)
+        vbo_ = VBO<GLubyte>();
+}
+
+void SpriteBatch::begin()
+{
+    ++nestingLevel_;
+}
+
+void SpriteBatch::end()
+{
+    RTTR_Assert(nestingLevel_ > 0u);
+    if(--nestingLevel_ == 0u)
+        flush();
+}
+
+void SpriteBatch::add(unsigned texture, const Point<GLfloat>* vertices, const Point<GLfloat>* texCoords,
+                      const RGBAColor* colors, unsigned numVertices)
+{
+    RTTR_Assert(numVertices % 4u == 0u);
+    if(!isActive())
+    {
+        drawArrays(texture, vertices, texCoords, colors, numVertices);
+        return;
+    }
+    if(texture != texture_)
+    {
+        flush();
+        texture_ = texture;
+    }
+    vertices_.insert(vertices_.end(), vertices, vertices + numVertices);
+    texCoords_.insert(texCoords_.end(), texCoords, texCoords + numVertices);
+    colors_.insert(colors_.end(), colors, colors + numVertices);
+}
+
+void SpriteBatch::flush()
+{
+    if(vertices_.empty())
+        return;
+    if(useVBO_)
+        drawVBO();
+    else
+        drawArrays(texture_, vertices_.data(), texCoords_.data(), colors_.data(), vertices_.size());
+    vertices_.clear();
+    texCoords_.clear();
+    colors_.clear();
+}
+
+void SpriteBatch::resetStatistics()
+{
+    numDrawCalls_ = numQuads_ = 0;
+}
+
+void SpriteBatch::drawArrays(unsigned texture, const Point<GLfloat>* vertices, const Point<GLfloat>* texCoords,
+                             const RGBAColor* colors, unsigned numVertices)
+{
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, vertices);
+    glTexCoordPointer(2, GL_FLOAT, 0, texCoords);
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors);
+    VIDEODRIVER.BindTexture(texture);
+    glDrawArrays(GL_QUADS, 0, numVertices);
+    glDisableClientState(GL_COLOR_ARRAY);
+    ++numDrawCalls_;
+    numQuads_ += numVertices / 4u;
+}
+
+void SpriteBatch::drawVBO()
+{
+    const size_t posSize = vertices_.size() * sizeof(vertices_[0]);
+    const size_t colorSize = colors_.size() * sizeof(colors_[0]);
+    if(!vbo_.isValid())
+        vbo_ = VBO<GLubyte>(Target::Array);
+    // Orphan the old storage so we don't have to wait for the draw calls still using it
+    vbo_.fill(nullptr, 2 * posSize + colorSize, Usage::Stream);
+    vbo_.update(reinterpret_cast<const GLubyte*>(vertices_.data()), posSize, 0);
+    vbo_.update(reinterpret_cast<const GLubyte*>(texCoords_.data()), posSize, posSize);
+    vbo_.update(reinterpret_cast<const GLubyte*>(colors_.data()), colorSize, 2 * posSize);
+
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, nullptr);
+    glTexCoordPointer(2, GL_FLOAT, 0, reinterpret_cast<const void*>(static_cast<uintptr_t>(posSize)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, reinterpret_cast<const void*>(static_cast<uintptr_t>(2 * posSize)));
+    VIDEODRIVER.BindTexture(texture_);
+    glDrawArrays(GL_QUADS, 0, vertices_.size());
+    // Unbind VBO to not interfere with other program parts
+    vbo_.unbind();
+    glDisableClientState(GL_COLOR_ARRAY);
+    ++numDrawCalls_;
+    numQuads_ += vertices_.size() / 4u;
+}
+
+} // namespace ogl
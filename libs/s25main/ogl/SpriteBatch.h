@@ -0,0 +1,64 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Point.h"
+#include "ogl/VBO.h"
+#include <glad/glad.h>
+#include <vector>
+
+namespace ogl {
+
+struct RGBAColor
+{
+    GLubyte r, g, b, a;
+};
+
+/// Collects textured quads (4 vertices each) and draws all consecutive quads using the same texture with one draw call.
+/// The draw order is preserved: Adding quads with a different texture or flushing draws all pending quads first.
+/// If not active (no begin() call) quads are drawn immediately.
+class SpriteBatch
+{
+public:
+    SpriteBatch();
+
+    /// Use a streaming VBO to upload batched vertices. Requires a real OpenGL context
+    void setUseVBO(bool useVBO);
+
+    /// Start collecting quads. Calls can be nested, only the outermost end() flushes
+    void begin();
+    /// Draw all pending quads and stop collecting if this matches the outermost begin()
+    void end();
+    bool isActive() const { return nestingLevel_ > 0u; }
+
+    /// Draw the given quads or add them to the batch if active
+    void add(unsigned texture, const Point<GLfloat>* vertices, const Point<GLfloat>* texCoords,
+             const RGBAColor* colors, unsigned numVertices);
+    /// Draw all pending quads
+    void flush();
+
+    /// Number of draw calls issued since the last reset
+    unsigned getNumDrawCalls() const { return numDrawCalls_; }
+    /// Number of quads drawn since the last reset
+    unsigned getNumQuads() const { return numQuads_; }
+    void resetStatistics();
+
+private:
+    void drawArrays(unsigned texture, const Point<GLfloat>* vertices, const Point<GLfloat>* texCoords,
+                    const RGBAColor* colors, unsigned numVertices);
+    void drawVBO();
+
+    std::vector<Point<GLfloat>> vertices_, texCoords_;
+    std::vector<RGBAColor> colors_;
+    /// Texture of all pending quads
+    unsigned texture_;
+    unsigned nestingLevel_;
+    bool useVBO_;
+    /// Streaming buffer holding vertices, texCoords and colors one after another
+    VBO<GLubyte> vbo_;
+    unsigned numDrawCalls_, numQuads_;
+};
+
+} // namespace ogl
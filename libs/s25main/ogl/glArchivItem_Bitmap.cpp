@@ -5,6 +5,7 @@
 #include "glArchivItem_Bitmap.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/IRenderer.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
@@ -56,6 +57,7 @@ void glArchivItem_Bitmap::Draw(Rect dstArea, Rect srcArea, unsigned color /*= CO
     texCoords[0].y = texCoords[3].y = srcOrig.y;
     texCoords[1].y = texCoords[2].y = srcEndPt.y;
 
+    VIDEODRIVER.GetRenderer()->FlushSprites();
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
     VIDEODRIVER.BindTexture(GetTexture());
@@ -6,6 +6,7 @@
 #include "Loader.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/IRenderer.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
@@ -106,6 +107,7 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
     colors[4].a = GetAlpha(player_color);
     colors[7] = colors[6] = colors[5] = colors[4];
 
+    VIDEODRIVER.GetRenderer()->FlushSprites();
     glEnableClientState(GL_COLOR_ARRAY);
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
@@ -8,6 +8,7 @@
 #include "drivers/VideoDriverWrapper.h"
 #include "glArchivItem_Bitmap_Raw.h"
 #include "helpers/containerUtils.h"
+#include "ogl/IRenderer.h"
 #include "libsiedler2/ArchivItem_Bitmap_Player.h"
 #include "libsiedler2/ArchivItem_Font.h"
 #include "libsiedler2/PixelBufferBGRA.h"
@@ -248,6 +249,7 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
     for(GlPoint& pt : texList.texCoords)
         pt /= texSize;
 
+    VIDEODRIVER.GetRenderer()->FlushSprites();
     glVertexPointer(2, GL_FLOAT, 0, texList.vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texList.texCoords.data());
     VIDEODRIVER.BindTexture(texture);
@@ -6,6 +6,8 @@
 #include "Loader.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "helpers/mathFuncs.h"
+#include "ogl/IRenderer.h"
+#include "ogl/SpriteBatch.h"
 #include "ogl/glBitmapItem.h"
 #include "libsiedler2/ArchivItem_Bitmap.h"
 #include "libsiedler2/ArchivItem_Bitmap_Player.h"
@@ -15,13 +17,6 @@
 #include <cmath>
 #include <limits>
 
-namespace {
-struct GL_RGBAColor
-{
-    GLbyte r, g, b, a;
-};
-} // namespace
-
 glSmartBitmap::glSmartBitmap() : origin_(0, 0), size_(0, 0), sharedTexture(false), texture(0), hasPlayer(false) {}
 
 glSmartBitmap::~glSmartBitmap()
@@ -276,7 +271,7 @@ void glSmartBitmap::drawRect(Rect dstArea, Rect srcArea, unsigned color /*= 0xFF
     }
 
     std::array<Point<GLfloat>, 8> vertices, curTexCoords;
-    std::array<GL_RGBAColor, 8> colors;
+    std::array<ogl::RGBAColor, 8> colors;
 
     auto drawPt = dstArea.getOrigin();
     drawPt -= origin_;
@@ -327,11 +322,5 @@ void glSmartBitmap::drawRect(Rect dstArea, Rect srcArea, unsigned color /*= 0xFF
     } else
         numQuads = 4;
 
-    glEnableClientState(GL_COLOR_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 0, vertices.data());
-    glTexCoordPointer(2, GL_FLOAT, 0, curTexCoords.data());
-    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
-    VIDEODRIVER.BindTexture(texture);
-    glDrawArrays(GL_QUADS, 0, numQuads);
-    glDisableClientState(GL_COLOR_ARRAY);
+    VIDEODRIVER.GetRenderer()->DrawQuads(texture, vertices.data(), curTexCoords.data(), colors.data(), numQuads);
 }
@@ -0,0 +1,92 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Thread-safe pool of scratch contexts for the pathfinders.
+/// Every query leases a context for its duration, so concurrent queries never share scratch memory.
+/// Returned contexts are kept for reuse, so there are at most as many contexts as concurrent queries were run.
+template<class T_Context>
+class ContextPool
+{
+public:
+    /// Exclusive access to a context. Returns it to the pool on destruction
+    class Lease
+    {
+        friend class ContextPool;
+        ContextPool* pool_;
+        std::unique_ptr<T_Context> ctx_;
+
+        Lease(ContextPool& pool, std::unique_ptr<T_Context> ctx) : pool_(&pool), ctx_(std::move(ctx)) {}
+
+    public:
+        Lease(Lease&&) noexcept = default;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease()
+        {
+            if(ctx_)
+                pool_->release(std::move(ctx_));
+        }
+
+        T_Context& operator*() const { return *ctx_; }
+        T_Context* operator->() const { return ctx_.get(); }
+    };
+
+    ContextPool() = default;
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+    ~ContextPool() { RTTR_Assert(numLeased_ == 0u); }
+
+    /// Get an unused context or create a new one
+    Lease acquire()
+    {
+        std::unique_ptr<T_Context> ctx;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++numLeased_;
+            if(!freeContexts_.empty())
+            {
+                ctx = std::move(freeContexts_.back());
+                freeContexts_.pop_back();
+            }
+        }
+        if(!ctx)
+            ctx = std::make_unique<T_Context>();
+        return Lease(*this, std::move(ctx));
+    }
+
+    /// Destroy all unused contexts. Must not be called while queries are running
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RTTR_Assert(numLeased_ == 0u);
+        freeContexts_.clear();
+    }
+
+    /// Number of contexts created so far that are currently unused
+    size_t getNumFreeContexts() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return freeContexts_.size();
+    }
+
+private:
+    void release(std::unique_ptr<T_Context> ctx)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RTTR_Assert(numLeased_ > 0u);
+        --numLeased_;
+        freeContexts_.push_back(std::move(ctx));
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T_Context>> freeContexts_;
+    unsigned numLeased_ = 0;
+};
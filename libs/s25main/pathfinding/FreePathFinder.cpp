@@ -15,31 +15,25 @@
 /// FreePathFinder implementation
 //////////////////////////////////////////////////////////////////////////
 
-/// MapNodes
-using MapNodes = std::vector<NewNode>;
-using FreePathNodes = std::vector<FreePathNode>;
-MapNodes nodes;
-FreePathNodes fpNodes;
-
-void FreePathFinder::Init(const MapExtent& mapSize)
+void FreePathFinderContext::Init(const MapExtent& mapSize)
 {
     currentVisit = 0;
-    size_ = Extent(mapSize);
-    // Reset nodes
+    const unsigned numNodes = prodOfComponents(mapSize);
     nodes.clear();
     fpNodes.clear();
-    nodes.resize(size_.x * size_.y);
-    fpNodes.resize(nodes.size());
-    RTTR_FOREACH_PT(MapPoint, size_)
+    nodes.resize(numNodes);
+    fpNodes.resize(numNodes);
+    unsigned idx = 0;
+    RTTR_FOREACH_PT(MapPoint, mapSize)
     {
-        const unsigned idx = gwb_.GetIdx(pt);
         nodes[idx].mapPt = pt;
         fpNodes[idx].lastVisited = 0;
         fpNodes[idx].mapPt = pt;
+        ++idx;
     }
 }
 
-void FreePathFinder::IncreaseCurrentVisit()
+void FreePathFinderContext::IncreaseCurrentVisit()
 {
     // if the counter reaches its maxium, tidy up
     if(currentVisit == std::numeric_limits<unsigned>::max())
@@ -58,12 +52,57 @@ void FreePathFinder::IncreaseCurrentVisit()
         currentVisit++;
 }
 
+FreePathFinder::FreePathFinder(const GameWorldBase& gwb) : gwb_(gwb), size_(0, 0) {}
+
+FreePathFinder::~FreePathFinder() = default;
+
+void FreePathFinder::Init(const MapExtent& mapSize)
+{
+    size_ = Extent(mapSize);
+    // Contexts are (re-)initialized on first use
+    contexts_.clear();
+}
+
+ContextPool<FreePathFinderContext>::Lease FreePathFinder::AcquireContext() const
+{
+    auto ctx = contexts_.acquire();
+    if(ctx->nodes.size() != prodOfComponents(size_))
+        ctx->Init(MapExtent(size_));
+    ctx->IncreaseCurrentVisit();
+    return ctx;
+}
+
+Direction FreePathFinder::GetStartDir(const MapPoint start, const bool randomRoute) const
+{
+    return randomRoute ? convertToDirection(gwb_.GetIdx(start) * gwb_.GetEvMgr().GetCurrentGF()) : Direction::West;
+}
+
+void FreePathFinder::StoreRoute(const FreePathNode& destNode, std::vector<Direction>* route, unsigned* length,
+                                Direction* firstDir)
+{
+    if(length)
+        *length = destNode.curDistance;
+    if(route)
+        route->resize(destNode.curDistance);
+
+    const FreePathNode* curNode = &destNode;
+    for(unsigned z = destNode.curDistance; z > 0; --z)
+    {
+        if(route)
+            (*route)[z - 1] = curNode->dir;
+        if(firstDir && z == 1)
+            *firstDir = curNode->dir;
+        curNode = curNode->prev;
+    }
+    RTTR_Assert(curNode && !curNode->prev);
+}
+
 /// Pathfinder ( A* ), O(v lg v) --> Normal terrain (ignoring roads) for road building and free walking jobs
 bool FreePathFinder::FindPathAlternatingConditions(const MapPoint start, const MapPoint dest, const bool randomRoute,
                                                    const unsigned maxLength, std::vector<Direction>* route,
                                                    unsigned* length, Direction* firstDir, FP_Node_OK_Callback IsNodeOK,
                                                    FP_Node_OK_Callback IsNodeOKAlternate,
-                                                   FP_Node_OK_Callback IsNodeToDestOk, const void* param)
+                                                   FP_Node_OK_Callback IsNodeToDestOk, const void* param) const
 {
     if(start == dest)
     {
@@ -82,8 +121,9 @@ bool FreePathFinder::FindPathAlternatingConditions(const MapPoint start, const M
         return true;
     }
 
-    // increase currentVisit, so we don't have to clear the visited-states at every run
-    IncreaseCurrentVisit();
+    const auto ctx = AcquireContext();
+    std::vector<NewNode>& nodes = ctx->nodes;
+    const unsigned currentVisit = ctx->currentVisit;
 
     std::list<PathfindingPoint> todo;
     const unsigned destId = gwb_.GetIdx(dest);
@@ -101,8 +141,7 @@ bool FreePathFinder::FindPathAlternatingConditions(const MapPoint start, const M
     // LOG.write(("pf: from %i, %i to %i, %i \n", x_start, y_start, x_dest, y_dest);
 
     // Start at random dir (so different jobs may use different roads)
-    const Direction startDir =
-      randomRoute ? convertToDirection(gwb_.GetIdx(start) * gwb_.GetEvMgr().GetCurrentGF()) : Direction::West;
+    const Direction startDir = GetStartDir(start, randomRoute);
 
     while(!todo.empty())
     {
@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include "pathfinding/ContextPool.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
 #include <vector>
 
 class GameWorldBase;
+struct FreePathFinderContext;
+struct FreePathNode;
 
 using FP_Node_OK_Callback = bool (*)(const GameWorldBase&, const MapPoint, const Direction, const void*);
 
@@ -16,14 +19,17 @@ using FP_Node_OK_Callback = bool (*)(const GameWorldBase&, const MapPoint, const
 // IsNodeToDestOk: Called for every point to check if this node is usable
 // IsNodeOk: Additionally called for every point but the destination
 
+/// All queries are const and use scratch memory leased from a pool, so they can run concurrently on a const world
 class FreePathFinder
 {
-    GameWorldBase& gwb_;
-    unsigned currentVisit;
+    const GameWorldBase& gwb_;
     Extent size_;
+    mutable ContextPool<FreePathFinderContext> contexts_;
 
 public:
-    FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0) {}
+    FreePathFinder(const GameWorldBase& gwb);
+    ~FreePathFinder();
+    /// Set the map size. Must not be called while queries are running
     void Init(const MapExtent& mapSize);
 
     /// Wegfindung in freiem Terrain - Template version. Users need to include FreePathFinderImpl.h
@@ -31,18 +37,33 @@ public:
     /// IsNodeToDestOk(MapPoint pt, unsigned char dirFromPrevPt)
     template<class TNodeChecker>
     bool FindPath(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength, std::vector<Direction>* route,
-                  unsigned* length, Direction* firstDir, const TNodeChecker& nodeChecker);
+                  unsigned* length, Direction* firstDir, const TNodeChecker& nodeChecker) const;
 
     bool FindPathAlternatingConditions(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength,
                                        std::vector<Direction>* route, unsigned* length, Direction* firstDir,
                                        FP_Node_OK_Callback IsNodeOK, FP_Node_OK_Callback IsNodeOKAlternate,
-                                       FP_Node_OK_Callback IsNodeToDestOk, const void* param);
+                                       FP_Node_OK_Callback IsNodeToDestOk, const void* param) const;
 
     /// Ermittelt, ob eine freie Route noch passierbar ist und gibt den Endpunkt der Route zurück
     template<class TNodeChecker>
     bool CheckRoute(MapPoint start, const std::vector<Direction>& route, unsigned pos, const TNodeChecker& nodeChecker,
                     MapPoint* dest) const;
 
+    /// Direction in which the search starts. Random routes start at a pseudo-random (but deterministic) direction
+    Direction GetStartDir(MapPoint start, bool randomRoute) const;
+
+    /// Number of scratch contexts currently not in use
+    size_t GetNumFreeContexts() const { return contexts_.getNumFreeContexts(); }
+
 private:
-    void IncreaseCurrentVisit();
+    /// Get scratch memory sized for the current map and prepared for a new query
+    ContextPool<FreePathFinderContext>::Lease AcquireContext() const;
+
+    template<class T_OpenList, class TNodeChecker>
+    bool FindPathAStar(T_OpenList& todo, FreePathFinderContext& ctx, MapPoint start, MapPoint dest, bool randomRoute,
+                       unsigned maxLength, std::vector<Direction>* route, unsigned* length, Direction* firstDir,
+                       const TNodeChecker& nodeChecker) const;
+    /// Return the route ending at the given node by following the prev-pointers back to the start node
+    static void StoreRoute(const FreePathNode& destNode, std::vector<Direction>* route, unsigned* length,
+                           Direction* firstDir);
 };
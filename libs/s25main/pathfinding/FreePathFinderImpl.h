@@ -8,13 +8,11 @@
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/NewNode.h"
 #include "pathfinding/OpenListBinaryHeap.h"
+#include "pathfinding/OpenListBucketQueue.h"
 #include "pathfinding/OpenListPrioQueue.h"
 #include "pathfinding/PathfindingPoint.h"
 #include "world/GameWorldBase.h"
 
-using FreePathNodes = std::vector<FreePathNode>;
-extern FreePathNodes fpNodes;
-
 struct NodePtrCmpGreater
 {
     bool operator()(const FreePathNode* const lhs, const FreePathNode* const rhs) const
@@ -29,25 +27,38 @@ struct NodePtrCmpGreater
     }
 };
 
-struct GetEstimatedDistance
-{
-    unsigned operator()(const FreePathNode& lhs) const { return lhs.estimatedDistance; }
-};
-
 // using QueueImpl = OpenListPrioQueue<NewNode2*, NodePtrCmpGreater>;
 using QueueImpl = OpenListBinaryHeap<FreePathNode, GetEstimatedDistance>;
 
 template<class TNodeChecker>
 bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool randomRoute, unsigned maxLength,
                               std::vector<Direction>* route, unsigned* length, Direction* firstDir,
-                              const TNodeChecker& nodeChecker)
+                              const TNodeChecker& nodeChecker) const
 {
     RTTR_Assert(start != dest);
 
-    // increase currentVisit, so we don't have to clear the visited-states at every run
-    IncreaseCurrentVisit();
-
+    const auto ctx = AcquireContext();
+    // The distance estimate is consistent, so A* finds a shortest route no matter how ties are broken.
+    // Hence only the route itself depends on the open list and we can use the faster bucket queue if it is not required
+    if(!route && !firstDir)
+    {
+        ctx->bucketQueue.clear();
+        return FindPathAStar(ctx->bucketQueue, *ctx, start, dest, randomRoute, maxLength, route, length, firstDir,
+                             nodeChecker);
+    }
     QueueImpl todo;
+    return FindPathAStar(todo, *ctx, start, dest, randomRoute, maxLength, route, length, firstDir, nodeChecker);
+}
+
+template<class T_OpenList, class TNodeChecker>
+bool FreePathFinder::FindPathAStar(T_OpenList& todo, FreePathFinderContext& ctx, const MapPoint start,
+                                   const MapPoint dest, bool randomRoute, unsigned maxLength,
+                                   std::vector<Direction>* route, unsigned* length, Direction* firstDir,
+                                   const TNodeChecker& nodeChecker) const
+{
+    std::vector<FreePathNode>& fpNodes = ctx.fpNodes;
+    const unsigned currentVisit = ctx.currentVisit;
+
     const unsigned startId = gwb_.GetIdx(start);
     const unsigned destId = gwb_.GetIdx(dest);
     FreePathNode& startNode = fpNodes[startId];
@@ -64,8 +75,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
 
     // Bei Zufälliger Richtung anfangen (damit man nicht immer denselben Weg geht, besonders für die Soldaten wichtig)
     // TODO confirm random: RANDOM.Rand(__FILE__, __LINE__, y_start * GetWidth() + x_start, 6);
-    const Direction startDir =
-      randomRoute ? convertToDirection(gwb_.GetIdx(start) * gwb_.GetEvMgr().GetCurrentGF()) : Direction::West;
+    const Direction startDir = GetStartDir(start, randomRoute);
 
     while(!todo.empty())
     {
@@ -77,24 +87,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
         {
             // Ziel erreicht!
             // Jeweils die einzelnen Angaben zurückgeben, falls gewünscht (Pointer übergeben)
-            if(length)
-                *length = best.curDistance;
-            if(route)
-                route->resize(best.curDistance);
-
-            FreePathNode* curNode = &best;
-            // Route rekonstruieren und ggf. die erste Richtung speichern, falls gewünscht
-            for(unsigned z = best.curDistance; z > 0; --z)
-            {
-                if(route)
-                    (*route)[z - 1] = curNode->dir;
-                if(firstDir && z == 1)
-                    *firstDir = curNode->dir;
-                curNode = curNode->prev;
-            }
-
-            RTTR_Assert(curNode == &startNode);
-
+            StoreRoute(best, route, length, firstDir);
             // Fertig, es wurde ein Pfad gefunden
             return true;
         }
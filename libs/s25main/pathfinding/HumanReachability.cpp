@@ -0,0 +1,234 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pathfinding/HumanReachability.h"
+#include "RttrForeachPt.h"
+#include "helpers/EnumRange.h"
+#include "helpers/containerUtils.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "world/World.h"
+#include <algorithm>
+
+HumanReachability::HumanReachability(const World& world) : world_(world) {}
+
+HumanReachability::~HumanReachability() = default;
+
+void HumanReachability::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isValid_ = false;
+    labels_.clear();
+    parents_.clear();
+}
+
+void HumanReachability::calcComponents() const
+{
+    // Marker for usable nodes which are not yet assigned to a component
+    constexpr unsigned UNLABELED = NO_COMPONENT - 1u;
+
+    const PathConditionHuman condition(world_);
+    labels_.assign(prodOfComponents(world_.GetSize()), NO_COMPONENT);
+    parents_.clear();
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        if(condition.IsNodeOk(pt))
+            labels_[world_.GetIdx(pt)] = UNLABELED;
+    }
+
+    std::vector<MapPoint> todo;
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        unsigned& label = labels_[world_.GetIdx(pt)];
+        if(label != UNLABELED)
+            continue;
+        const auto component = static_cast<unsigned>(parents_.size());
+        parents_.push_back(component);
+        label = component;
+        todo.push_back(pt);
+        while(!todo.empty())
+        {
+            const MapPoint curPt = todo.back();
+            todo.pop_back();
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint nb = world_.GetNeighbour(curPt, dir);
+                unsigned& nbLabel = labels_[world_.GetIdx(nb)];
+                if(nbLabel != UNLABELED || !condition.IsEdgeOk(curPt, dir))
+                    continue;
+                nbLabel = component;
+                todo.push_back(nb);
+            }
+        }
+    }
+    isValid_ = true;
+    ++numRecalculations_;
+}
+
+unsigned HumanReachability::findRoot(unsigned component) const
+{
+    while(parents_[component] != component)
+    {
+        // Path halving
+        parents_[component] = parents_[parents_[component]];
+        component = parents_[component];
+    }
+    return component;
+}
+
+unsigned HumanReachability::getComponent(const MapPoint pt) const
+{
+    const unsigned label = labels_[world_.GetIdx(pt)];
+    return (label == NO_COMPONENT) ? NO_COMPONENT : findRoot(label);
+}
+
+void HumanReachability::mergeComponents(unsigned component1, unsigned component2)
+{
+    component1 = findRoot(component1);
+    component2 = findRoot(component2);
+    if(component1 < component2)
+        parents_[component2] = component1;
+    else if(component2 < component1)
+        parents_[component1] = component2;
+}
+
+void HumanReachability::objectChanged(const MapPoint pt)
+{
+    update(pt, false);
+}
+
+void HumanReachability::roadChanged(const MapPoint pt)
+{
+    update(pt, true);
+}
+
+void HumanReachability::update(const MapPoint pt, const bool roadChanged)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Everything gets recalculated on the next query anyway
+    if(!isValid_)
+        return;
+
+    const PathConditionHuman condition(world_);
+    const unsigned oldComponent = getComponent(pt);
+    const bool isUsable = condition.IsNodeOk(pt);
+    // Objects only change the node, the edges depend on the terrain and roads only
+    if(!roadChanged && isUsable == (oldComponent != NO_COMPONENT))
+        return;
+
+    unsigned& label = labels_[world_.GetIdx(pt)];
+    if(isUsable)
+    {
+        if(label == NO_COMPONENT)
+        {
+            label = static_cast<unsigned>(parents_.size());
+            parents_.push_back(label);
+        }
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const unsigned nbComponent = getComponent(world_.GetNeighbour(pt, dir));
+            if(nbComponent != NO_COMPONENT && condition.IsEdgeOk(pt, dir))
+                mergeComponents(label, nbComponent);
+        }
+    } else
+        label = NO_COMPONENT;
+
+    // Removing the node or one of its edges might have split the component
+    if(oldComponent != NO_COMPONENT && !isLocallyConnected(pt, findRoot(oldComponent), roadChanged))
+        isValid_ = false;
+}
+
+bool HumanReachability::isLocallyConnected(const MapPoint pt, const unsigned component, const bool roadChanged) const
+{
+    const PathConditionHuman condition(world_);
+    // All points which might have been connected only via the point or a changed edge
+    std::vector<MapPoint> connectedPts;
+    if(getComponent(pt) == component)
+        connectedPts.push_back(pt);
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        const MapPoint nb = world_.GetNeighbour(pt, dir);
+        if(getComponent(nb) == component && (roadChanged || condition.IsEdgeOk(pt, dir)))
+            connectedPts.push_back(nb);
+    }
+    if(connectedPts.size() <= 1u)
+        return true;
+
+    std::vector<MapPoint> reachedPts{connectedPts.front()};
+    std::vector<MapPoint> todo{connectedPts.front()};
+    while(!todo.empty())
+    {
+        const MapPoint curPt = todo.back();
+        todo.pop_back();
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const MapPoint nb = world_.GetNeighbour(curPt, dir);
+            if(world_.CalcDistance(pt, nb) > LOCAL_SEARCH_RADIUS || helpers::contains(reachedPts, nb))
+                continue;
+            if(!condition.IsNodeOk(nb) || !condition.IsEdgeOk(curPt, dir))
+                continue;
+            reachedPts.push_back(nb);
+            todo.push_back(nb);
+        }
+    }
+    return std::all_of(connectedPts.begin(), connectedPts.end(),
+                       [&reachedPts](const MapPoint& curPt) { return helpers::contains(reachedPts, curPt); });
+}
+
+helpers::EnumArray<unsigned, Direction> HumanReachability::getNeighbourComponents(const MapPoint pt) const
+{
+    const PathConditionHuman condition(world_);
+    helpers::EnumArray<unsigned, Direction> components;
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        // Edges are symmetric, so this also works for reaching the point
+        components[dir] = condition.IsEdgeOk(pt, dir) ? getComponent(world_.GetNeighbour(pt, dir)) : NO_COMPONENT;
+    }
+    return components;
+}
+
+bool HumanReachability::mayBeReachable(const MapPoint start, const MapPoint dest) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++numQueries_;
+    if(start == dest)
+        return true;
+    if(!isValid_)
+        calcComponents();
+
+    // Start and destination themselves don't need to be usable, so a path must either be a direct step
+    // or lead through a component connected to both
+    const PathConditionHuman condition(world_);
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        if(world_.GetNeighbour(start, dir) == dest && condition.IsEdgeOk(start, dir))
+            return true;
+    }
+    const auto startComponents = getNeighbourComponents(start);
+    const auto destComponents = getNeighbourComponents(dest);
+    for(const unsigned component : startComponents)
+    {
+        if(component != NO_COMPONENT && helpers::contains(destComponents, component))
+            return true;
+    }
+    ++numRejected_;
+    return false;
+}
+
+uint64_t HumanReachability::getNumQueries() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numQueries_;
+}
+
+uint64_t HumanReachability::getNumRejected() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numRejected_;
+}
+
+unsigned HumanReachability::getNumRecalculations() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numRecalculations_;
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/EnumArray.h"
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+class World;
+
+/// Connected components of the nodes humans can walk on (see PathConditionHuman).
+/// Used to reject searches for human paths between points which are not connected at all before running the
+/// pathfinder.
+/// The components are calculated lazily and updated incrementally when objects or roads change:
+/// Newly connected components are merged. A blocked node or edge might split its component, which is checked in the
+/// surrounding area only. If that fails, all components are recalculated on the next query.
+/// So points in different components are never connected, but points in the same one might not be.
+/// All functions are thread-safe.
+class HumanReachability
+{
+public:
+    explicit HumanReachability(const World& world);
+    ~HumanReachability();
+
+    /// Drop all data, e.g. after the terrain was changed
+    void clear();
+    /// Update after the object at the point was set or removed
+    void objectChanged(MapPoint pt);
+    /// Update after a road starting at the point was set or removed
+    void roadChanged(MapPoint pt);
+
+    /// Return false if there is no human path (of any length) from start to dest.
+    /// If true is returned, there might still be none.
+    bool mayBeReachable(MapPoint start, MapPoint dest) const;
+
+    /// Number of calls to mayBeReachable
+    uint64_t getNumQueries() const;
+    /// Number of calls to mayBeReachable which returned false, i.e. pathfinder runs avoided
+    uint64_t getNumRejected() const;
+    /// Number of times all components were calculated
+    unsigned getNumRecalculations() const;
+
+private:
+    static constexpr unsigned NO_COMPONENT = std::numeric_limits<unsigned>::max();
+    /// Maximum distance from a changed point to search for a connection between its neighbours
+    static constexpr unsigned LOCAL_SEARCH_RADIUS = 4;
+
+    void calcComponents() const;
+    unsigned findRoot(unsigned component) const;
+    /// Return the component of the node or NO_COMPONENT if it cannot be walked on
+    unsigned getComponent(MapPoint pt) const;
+    void mergeComponents(unsigned component1, unsigned component2);
+    void update(MapPoint pt, bool roadChanged);
+    /// Check if the point (if usable) and its neighbours which were connected to it via the given component
+    /// are still connected in the area around the point
+    bool isLocallyConnected(MapPoint pt, unsigned component, bool roadChanged) const;
+    /// Return the components of the usable neighbours that can be reached from the point (NO_COMPONENT for others)
+    helpers::EnumArray<unsigned, Direction> getNeighbourComponents(MapPoint pt) const;
+
+    const World& world_;
+    mutable std::mutex mutex_;
+    mutable bool isValid_ = false;
+    /// Component label of each node or NO_COMPONENT if it cannot be walked on
+    mutable std::vector<unsigned> labels_;
+    /// Union-find structure of the component labels
+    mutable std::vector<unsigned> parents_;
+    mutable uint64_t numQueries_ = 0;
+    mutable uint64_t numRejected_ = 0;
+    mutable unsigned numRecalculations_ = 0;
+};
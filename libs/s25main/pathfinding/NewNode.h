@@ -5,8 +5,10 @@
 #pragma once
 
 #include "pathfinding/OpenListBinaryHeap.h"
+#include "pathfinding/OpenListBucketQueue.h"
 #include "pathfinding/PathfindingPoint.h"
 #include <set>
+#include <vector>
 
 /// Konstante für einen ungültigen Vorgängerknoten
 const unsigned INVALID_PREV = 0xFFFFFFFF;
@@ -48,3 +50,24 @@ struct FreePathNode : BinaryHeapPosMarker
     /// Direction used to reach this node
     Direction dir;
 };
+
+struct GetEstimatedDistance
+{
+    unsigned operator()(const FreePathNode& lhs) const { return lhs.estimatedDistance; }
+};
+
+/// Scratch memory of a single free pathfinding query. Nodes are indexed by the map index
+struct FreePathFinderContext
+{
+    std::vector<NewNode> nodes;
+    std::vector<FreePathNode> fpNodes;
+    /// Open list for searches not depending on the order of nodes with the same estimate. Kept to reuse its buckets
+    OpenListBucketQueue<FreePathNode, GetEstimatedDistance> bucketQueue;
+    /// Nodes with lastVisited == currentVisit were visited in the current query
+    unsigned currentVisit = 0;
+
+    /// Allocate and reset the nodes for the given map size
+    void Init(const MapExtent& mapSize);
+    /// Start a new query so we don't have to clear the visited-states at every run
+    void IncreaseCurrentVisit();
+};
@@ -13,8 +13,11 @@
 
 template<typename T, class T_GetKey>
 class OpenListBinaryHeap;
+template<typename T, class T_GetKey>
+class OpenListBucketQueue;
 
-/// Class used to store the position in the heap. Heap elements must inherit from this
+/// Class used to store the position in the heap (or the bucket in OpenListBucketQueue).
+/// Heap elements must inherit from this
 struct BinaryHeapPosMarker
 {
 private:
@@ -22,6 +25,8 @@ private:
 
     template<typename T, class T_GetKey>
     friend class OpenListBinaryHeap;
+    template<typename T, class T_GetKey>
+    friend class OpenListBucketQueue;
 };
 
 template<typename T, class T_GetKey>
@@ -0,0 +1,141 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include "pathfinding/OpenListBinaryHeap.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/// Open list with one bucket per key (Dial's algorithm) with the same interface as OpenListBinaryHeap.
+/// push and decreasedKey are O(1), pop is O(1) amortized if the keys mostly increase, e.g. the estimates of A* with a
+/// consistent distance estimate. Keys must be small as there is one bucket for every value up to the largest key.
+/// Ties are broken in a fixed order: Of all elements with the lowest key the one pushed (or decreased) last is
+/// returned.
+/// Elements must inherit from BinaryHeapPosMarker which stores the key under which they are in the list.
+/// Decreased elements are not removed from their old bucket but skipped when reaching it.
+template<typename T, class T_GetKey>
+class OpenListBucketQueue : T_GetKey
+{
+public:
+    using size_type = unsigned;
+    using value_type = T;
+    using key_type = unsigned;
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0u; }
+    /// Remove all elements. The buckets are kept to avoid reallocations when the list is reused
+    void clear();
+
+    T* top() const;
+    void push(T* newEl);
+    T* pop();
+    /// Move the element to its new (lower) key. If it was removed already, it is added again
+    void decreasedKey(T* el);
+    void rearrange(T* el) { decreasedKey(el); }
+
+private:
+    static key_type NoKey() { return std::numeric_limits<key_type>::max(); }
+    key_type GetKey(const T* el) const { return T_GetKey::operator()(*el); }
+    /// Key of the bucket containing the valid entry for the element or NoKey if not in the list
+    static key_type& GetQueuedKey(T* el) { return static_cast<BinaryHeapPosMarker*>(el)->pos; }
+    void addToBucket(T* el);
+    /// Advance to the first valid entry after the top element was removed
+    void skipOutdated();
+
+    std::vector<std::vector<T*>> buckets_;
+    /// The last entry of this bucket is the top element (if not empty). All elements have a key >= curKey_
+    key_type curKey_ = 0;
+    /// Number of buckets which may contain entries
+    size_type numUsedBuckets_ = 0;
+    size_type size_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation
+//////////////////////////////////////////////////////////////////////////
+
+template<typename T, class T_GetKey>
+void OpenListBucketQueue<T, T_GetKey>::clear()
+{
+    for(size_type i = 0; i < numUsedBuckets_; i++)
+        buckets_[i].clear();
+    numUsedBuckets_ = 0;
+    size_ = 0;
+    curKey_ = 0;
+}
+
+template<typename T, class T_GetKey>
+inline T* OpenListBucketQueue<T, T_GetKey>::top() const
+{
+    RTTR_Assert(!empty());
+    return buckets_[curKey_].back();
+}
+
+template<typename T, class T_GetKey>
+inline void OpenListBucketQueue<T, T_GetKey>::addToBucket(T* el)
+{
+    const key_type key = GetKey(el);
+    RTTR_Assert(key != NoKey());
+    if(key >= buckets_.size())
+        buckets_.resize(key + 1u);
+    numUsedBuckets_ = std::max(numUsedBuckets_, key + 1u);
+    buckets_[key].push_back(el);
+    GetQueuedKey(el) = key;
+    if(empty() || key < curKey_)
+        curKey_ = key;
+}
+
+template<typename T, class T_GetKey>
+inline void OpenListBucketQueue<T, T_GetKey>::push(T* newEl)
+{
+    addToBucket(newEl);
+    ++size_;
+}
+
+template<typename T, class T_GetKey>
+inline void OpenListBucketQueue<T, T_GetKey>::decreasedKey(T* el)
+{
+    const key_type oldKey = GetQueuedKey(el);
+    if(oldKey == NoKey())
+    {
+        push(el);
+        return;
+    }
+    RTTR_Assert(!empty());
+    RTTR_Assert(GetKey(el) <= oldKey);
+    if(GetKey(el) != oldKey)
+        addToBucket(el);
+}
+
+template<typename T, class T_GetKey>
+inline T* OpenListBucketQueue<T, T_GetKey>::pop()
+{
+    T* const result = top();
+    buckets_[curKey_].pop_back();
+    GetQueuedKey(result) = NoKey();
+    --size_;
+    skipOutdated();
+    return result;
+}
+
+template<typename T, class T_GetKey>
+inline void OpenListBucketQueue<T, T_GetKey>::skipOutdated()
+{
+    if(empty())
+        return;
+    while(true)
+    {
+        std::vector<T*>& bucket = buckets_[curKey_];
+        // Entries of elements which were decreased or removed already
+        while(!bucket.empty() && GetQueuedKey(bucket.back()) != curKey_)
+            bucket.pop_back();
+        if(!bucket.empty())
+            return;
+        ++curKey_;
+        RTTR_Assert(curKey_ < numUsedBuckets_);
+    }
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pathfinding/RehomingCache.h"
+#include "EventManager.h"
+#include "FindWhConditions.h"
+#include "GamePlayer.h"
+#include "buildings/nobBaseWarehouse.h"
+#include "helpers/EnumRange.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/RoadNetworks.h"
+#include "world/GameWorldBase.h"
+#include <algorithm>
+
+RehomingCache::RehomingCache(const GameWorldBase& world) : world_(world) {}
+
+RehomingCache::~RehomingCache() = default;
+
+void RehomingCache::clear()
+{
+    // Dropped on next use, as this is called for every changed object
+    curGF_ = NO_GF;
+}
+
+void RehomingCache::checkGF() const
+{
+    const unsigned gf = world_.GetEvMgr().GetCurrentGF();
+    if(gf == curGF_)
+        return;
+    curGF_ = gf;
+    humanDistances_.clear();
+    const unsigned numNodes = prodOfComponents(world_.GetSize());
+    if(visits_.size() != numNodes)
+    {
+        visits_.assign(numNodes, 0u);
+        curVisit_ = 0;
+    }
+}
+
+const RehomingCache::HumanDistances& RehomingCache::getHumanDistances(const MapPoint start,
+                                                                     const unsigned maxLength) const
+{
+    const std::pair<unsigned, unsigned> key(world_.GetIdx(start), maxLength);
+    const auto it = humanDistances_.find(key);
+    if(it != humanDistances_.end())
+        return it->second;
+
+    ++numHumanFloods_;
+    const unsigned visit = ++curVisit_;
+    const PathConditionHuman condition(world_);
+    HumanDistances& distances = humanDistances_[key];
+    distances.emplace_back(key.first, 0u);
+    visits_[key.first] = visit;
+    // Breadth-first search, so all nodes are first reached via a shortest path.
+    // As in the pathfinder every node can be a goal but only the start and usable nodes can be passed.
+    std::vector<MapPoint> curLayer{start}, nextLayer;
+    for(unsigned distance = 1; distance <= maxLength && !curLayer.empty(); distance++)
+    {
+        nextLayer.clear();
+        for(const MapPoint curPt : curLayer)
+        {
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint nb = world_.GetNeighbour(curPt, dir);
+                const unsigned nbIdx = world_.GetIdx(nb);
+                if(visits_[nbIdx] == visit || !condition.IsEdgeOk(curPt, dir))
+                    continue;
+                visits_[nbIdx] = visit;
+                distances.emplace_back(nbIdx, distance);
+                if(condition.IsNodeOk(nb))
+                    nextLayer.push_back(nb);
+            }
+        }
+        std::swap(curLayer, nextLayer);
+    }
+    std::sort(distances.begin(), distances.end());
+    return distances;
+}
+
+bool RehomingCache::findHumanPath(const MapPoint start, const MapPoint dest, const unsigned maxLength,
+                                  unsigned* const length) const
+{
+    RTTR_Assert(start != dest);
+    checkGF();
+    const HumanDistances& distances = getHumanDistances(start, maxLength);
+    const unsigned destIdx = world_.GetIdx(dest);
+    const auto it = std::lower_bound(distances.begin(), distances.end(), std::make_pair(destIdx, 0u));
+    if(it == distances.end() || it->first != destIdx)
+        return false;
+    if(length)
+        *length = it->second;
+    return true;
+}
+
+bool RehomingCache::hasWarehouseFor(const unsigned player, const noRoadNode& flag, const Job job) const
+{
+    const RoadNetworks& roadNetworks = world_.GetRoadNetworks();
+    const FW::AcceptsFigure isWarehouseGood(job);
+    bool needsSearch = false;
+    for(const nobBaseWarehouse* wh : world_.GetPlayer(player).GetBuildingRegister().GetStorehouses())
+    {
+        if(!isWarehouseGood(*wh) || roadNetworks.isUnreachable(flag, *wh))
+            continue;
+        // A warehouse in the same network can be reached, as its flag always leads to it
+        if(roadNetworks.isReachableOnLand(flag, *wh))
+            return true;
+        // Harbors may connect the network to others by ship and the boat roads can't be used
+        needsSearch = true;
+    }
+    return needsSearch && world_.GetPlayer(player).FindWarehouse(flag, isWarehouseGood, true, false) != nullptr;
+}
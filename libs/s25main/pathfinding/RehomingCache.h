@@ -0,0 +1,60 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/JobTypes.h"
+#include "gameTypes/MapCoordinates.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+class GameWorldBase;
+class noRoadNode;
+
+/// Shared searches for wandering figures looking for a way home, e.g. after a warehouse burned down.
+/// Instead of running the pathfinder for every candidate flag of every figure this calculates
+/// - the human path lengths to all points around a start point with one flood (shared by all figures at that point)
+/// - the warehouses reachable from a flag using the road networks of the world.
+///   Networks with a harbor or a boat road use the road pathfinder, as they may need ships or the boat road.
+/// The results are the same as from the pathfinders. They are kept for the current GF only and must be cleared
+/// when objects, roads or the terrain change.
+/// Not thread-safe, to be used by the game logic only.
+class RehomingCache
+{
+public:
+    explicit RehomingCache(const GameWorldBase& world);
+    ~RehomingCache();
+
+    /// Drop all cached data
+    void clear();
+
+    /// Same as GameWorldBase::FindHumanPath(start, dest, maxLength, false, length) != boost::none
+    bool findHumanPath(MapPoint start, MapPoint dest, unsigned maxLength, unsigned* length = nullptr) const;
+    /// Same as GamePlayer::FindWarehouse(flag, FW::AcceptsFigure(job), true, false) != nullptr for the player
+    bool hasWarehouseFor(unsigned player, const noRoadNode& flag, Job job) const;
+
+    /// Number of floods run for human paths since the start
+    unsigned getNumHumanFloods() const { return numHumanFloods_; }
+
+private:
+    /// (Node index, distance) of all nodes reached, sorted by the index
+    using HumanDistances = std::vector<std::pair<unsigned, unsigned>>;
+
+    static constexpr unsigned NO_GF = 0xFFFFFFFF;
+
+    /// Drop the data if it is from a previous GF or was cleared
+    void checkGF() const;
+    const HumanDistances& getHumanDistances(MapPoint start, unsigned maxLength) const;
+
+    const GameWorldBase& world_;
+    /// GF in which the data was calculated
+    mutable unsigned curGF_ = NO_GF;
+    /// Distances per start point index and maximum length
+    mutable std::map<std::pair<unsigned, unsigned>, HumanDistances> humanDistances_;
+    /// Visit marks for the floods
+    mutable std::vector<unsigned> visits_;
+    mutable unsigned curVisit_ = 0;
+    mutable unsigned numHumanFloods_ = 0;
+};
@@ -0,0 +1,112 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pathfinding/RoadNetworks.h"
+#include "RoadSegment.h"
+#include "helpers/EnumRange.h"
+#include "pathfinding/RoadPathFinder.h"
+#include "world/GameWorldBase.h"
+#include "nodeObjs/noRoadNode.h"
+
+RoadNetworks::RoadNetworks(const GameWorldBase& world) : world_(world) {}
+
+RoadNetworks::~RoadNetworks() = default;
+
+void RoadNetworks::clear()
+{
+    // Dropped on next use, as this is called for every changed road of a node
+    ++generation_;
+    numNetworks_ = HARBOR_NETWORK + 1;
+}
+
+unsigned RoadNetworks::calcNetwork(const noRoadNode& flag) const
+{
+    const unsigned network = numNetworks_++;
+    bool hasHarbor = false, hasBoatRoad = false;
+    floodedIdxs_.clear();
+    floodedIdxs_.push_back(world_.GetIdx(flag.GetPos()));
+    networks_[floodedIdxs_.back()] = std::make_pair(generation_, network);
+    std::vector<const noRoadNode*> todo{&flag};
+    while(!todo.empty())
+    {
+        const noRoadNode& curNode = *todo.back();
+        todo.pop_back();
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            // Same as the road pathfinder but including boat roads.
+            // Buildings can only be reached but not passed, except harbors which might have ship connections
+            const noRoadNode* neighbour = curNode.GetNeighbour(dir);
+            if(!neighbour)
+                continue;
+            if(curNode.GetRoute(dir)->GetRoadType() == RoadType::Water)
+                hasBoatRoad = true;
+            const GO_Type got = neighbour->GetGOT();
+            if(got != GO_Type::Flag)
+            {
+                if(got == GO_Type::NobHarborbuilding)
+                    hasHarbor = true;
+                continue;
+            }
+            std::pair<unsigned, unsigned>& nbEntry = networks_[world_.GetIdx(neighbour->GetPos())];
+            if(nbEntry.first == generation_)
+                continue;
+            nbEntry = std::make_pair(generation_, network);
+            floodedIdxs_.push_back(world_.GetIdx(neighbour->GetPos()));
+            todo.push_back(neighbour);
+        }
+    }
+    if(networksWithBoatRoads_.size() <= network)
+        networksWithBoatRoads_.resize(network + 1);
+    networksWithBoatRoads_[network] = hasBoatRoad;
+    if(!hasHarbor)
+        return network;
+    for(const unsigned idx : floodedIdxs_)
+        networks_[idx].second = HARBOR_NETWORK;
+    return HARBOR_NETWORK;
+}
+
+unsigned RoadNetworks::getNetwork(const noRoadNode& node) const
+{
+    const noRoadNode* flag = &node;
+    if(node.GetGOT() != GO_Type::Flag)
+    {
+        // A harbor can reach the other harbors by ship even without a flag
+        if(node.GetGOT() == GO_Type::NobHarborbuilding)
+            return HARBOR_NETWORK;
+        flag = node.GetNeighbour(Direction::SouthEast);
+        if(!flag || flag->GetGOT() != GO_Type::Flag)
+            return UNKNOWN_NETWORK;
+    }
+    const unsigned numNodes = prodOfComponents(world_.GetSize());
+    if(networks_.size() != numNodes)
+        networks_.assign(numNodes, std::make_pair(0u, UNKNOWN_NETWORK));
+    const std::pair<unsigned, unsigned>& entry = networks_[world_.GetIdx(flag->GetPos())];
+    if(entry.first == generation_)
+        return entry.second;
+    return calcNetwork(*flag);
+}
+
+bool RoadNetworks::isUnreachable(const noRoadNode& start, const noRoadNode& goal) const
+{
+    ++numQueries_;
+    const unsigned startNetwork = getNetwork(start);
+    if(startNetwork == UNKNOWN_NETWORK)
+        return false;
+    const unsigned goalNetwork = getNetwork(goal);
+    if(goalNetwork == UNKNOWN_NETWORK || goalNetwork == startNetwork)
+        return false;
+    ++numUnreachable_;
+    if(verify_ && world_.GetRoadPathFinder().PathExists(start, goal, true))
+        ++numMismatches_;
+    return true;
+}
+
+bool RoadNetworks::isReachableOnLand(const noRoadNode& start, const noRoadNode& goal) const
+{
+    const unsigned startNetwork = getNetwork(start);
+    // Harbors might need ships and a boat road might be the only connection
+    if(startNetwork == UNKNOWN_NETWORK || startNetwork == HARBOR_NETWORK || networksWithBoatRoads_[startNetwork])
+        return false;
+    return getNetwork(goal) == startNetwork;
+}
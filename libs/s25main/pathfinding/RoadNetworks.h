@@ -0,0 +1,70 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class GameWorldBase;
+class noRoadNode;
+
+/// Connected components of the road networks, i.e. the flags which can reach each other on roads.
+/// Used to skip road searches which must fail as start and goal are in different networks,
+/// e.g. all the warehouse searches redone for every road of a player after a new road was built.
+/// A building belongs to the network of its flag. Boat roads are included and all networks containing a harbor are
+/// treated as one as they may be connected by ships. So the networks are never smaller than what the road pathfinder
+/// can reach, and skipping a search only happens if it would fail anyway.
+/// The networks are calculated lazily per flag and dropped whenever a road node gets or loses a road.
+/// Not thread-safe, to be used by the game logic only.
+class RoadNetworks
+{
+public:
+    explicit RoadNetworks(const GameWorldBase& world);
+    ~RoadNetworks();
+
+    /// Drop all networks, e.g. after roads were built or destroyed
+    void clear();
+
+    /// Return true if there can't be a road path from start to goal.
+    /// Then RoadPathFinder::FindPath(start, goal, ...) fails for all parameters
+    bool isUnreachable(const noRoadNode& start, const noRoadNode& goal) const;
+    /// Return true if goal can be reached from start on roads without boat roads and ships.
+    /// Then RoadPathFinder::FindPath(start, goal, false) succeeds if the costs are not limited
+    bool isReachableOnLand(const noRoadNode& start, const noRoadNode& goal) const;
+
+    /// If enabled, the pathfinder is also run for every skipped search and wrongly skipped ones are counted
+    void setVerify(bool verify) { verify_ = verify; }
+
+    uint64_t getNumQueries() const { return numQueries_; }
+    /// Number of queries for which the search can be skipped
+    uint64_t getNumUnreachable() const { return numUnreachable_; }
+    /// Number of skipped searches for which a path exists (only counted if verification is enabled)
+    uint64_t getNumMismatches() const { return numMismatches_; }
+
+private:
+    /// Network of nodes not (yet) connected to a flag. Might reach anything
+    static constexpr unsigned UNKNOWN_NETWORK = 0;
+    /// Network used for all networks with a harbor
+    static constexpr unsigned HARBOR_NETWORK = 1;
+
+    /// Return the network of the node
+    unsigned getNetwork(const noRoadNode& node) const;
+    /// Flood the road network containing the flag and return its id
+    unsigned calcNetwork(const noRoadNode& flag) const;
+
+    const GameWorldBase& world_;
+    /// Generation and network for each flag. Only valid if the generation is the current one
+    mutable std::vector<std::pair<unsigned, unsigned>> networks_;
+    mutable unsigned generation_ = 1;
+    mutable unsigned numNetworks_ = HARBOR_NETWORK + 1;
+    /// For each network of the current generation whether it contains a boat road
+    mutable std::vector<bool> networksWithBoatRoads_;
+    mutable std::vector<unsigned> floodedIdxs_;
+    bool verify_ = false;
+    mutable uint64_t numQueries_ = 0;
+    mutable uint64_t numUnreachable_ = 0;
+    mutable uint64_t numMismatches_ = 0;
+};
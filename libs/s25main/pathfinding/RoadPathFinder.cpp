@@ -4,33 +4,54 @@
 
 #include "RoadPathFinder.h"
 #include "EventManager.h"
-#include "RttrForeachPt.h"
 #include "buildings/nobHarborBuilding.h"
-#include "pathfinding/OpenListPrioQueue.h"
+#include "pathfinding/OpenListBucketQueue.h"
 #include "pathfinding/OpenListVector.h"
 #include "world/GameWorldBase.h"
 #include "nodeObjs/noRoadNode.h"
 #include "gameData/GameConsts.h"
 #include "s25util/Log.h"
+#include <vector>
 
-/// Comparison operator for road nodes that returns true if lhs > rhs (descending order)
-struct RoadNodeComperatorGreater
+/// Pathfinding state of the road node at a map point
+struct RoadNodeState : BinaryHeapPosMarker
 {
-    bool operator()(const noRoadNode* const lhs, const noRoadNode* const rhs) const
-    {
-        if(lhs->estimate == rhs->estimate)
-        {
-            // Use a tie-breaker to get strict ordering
-            return (lhs->GetObjId() > rhs->GetObjId());
-        }
+    /// cost from start
+    unsigned cost;
+    /// distance to target
+    unsigned targetDistance;
+    /// estimated total distance (cost + distance)
+    unsigned estimate;
+    /// Node was visited if lastVisit == currentVisit of the context
+    unsigned lastVisit = 0;
+    const RoadNodeState* prev;
+    /// Road node this state currently belongs to. Only valid if visited
+    const noRoadNode* node;
+    /// Direction to previous node, includes SHIP_DIR
+    RoadPathDirection dir;
+};
 
-        return (lhs->estimate > rhs->estimate);
-    }
+struct GetRoadNodeEstimate
+{
+    unsigned operator()(const RoadNodeState& state) const { return state.estimate; }
 };
 
-using QueueImpl = OpenListPrioQueue<const noRoadNode*, RoadNodeComperatorGreater>;
-using VecImpl = OpenListVector<const noRoadNode*>;
-VecImpl todo;
+using VecImpl = OpenListVector<RoadNodeState*>;
+using BucketQueueImpl = OpenListBucketQueue<RoadNodeState, GetRoadNodeEstimate>;
+
+/// Scratch memory of a single road pathfinding query
+struct RoadPathFinderContext
+{
+    std::vector<RoadNodeState> nodes;
+    unsigned currentVisit = 0;
+    VecImpl todo;
+    /// Faster open list used when the order of nodes with the same estimate does not matter
+    BucketQueueImpl bucketQueue;
+};
+
+RoadPathFinder::RoadPathFinder(const GameWorldBase& gwb) : gwb_(gwb) {}
+
+RoadPathFinder::~RoadPathFinder() = default;
 
 // Namespace with all functors usable as additional cost functors
 namespace AdditonalCosts {
@@ -106,7 +127,7 @@ template<class T_AdditionalCosts, class T_SegmentConstraints>
 bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goal, const unsigned max,
                                   const T_AdditionalCosts addCosts, const T_SegmentConstraints isSegmentAllowed,
                                   unsigned* const length, RoadPathDirection* const firstDir,
-                                  MapPoint* const firstNodePos)
+                                  MapPoint* const firstNodePos) const
 {
     if(&start == &goal)
     {
@@ -125,61 +146,90 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         return true;
     }
 
-    // If the goal is a flag (unlikely) we have no goal building
-    // TODO(Replay): Change RoadPathFinder::FindPath to target flag instead of building for wares
-    const noRoadNode* goalBld = (goal.GetGOT() == GO_Type::Flag) ? nullptr : &goal;
-
+    const auto ctx = contexts_.acquire();
+    std::vector<RoadNodeState>& nodes = ctx->nodes;
+    if(nodes.size() != prodOfComponents(gwb_.GetSize()))
+    {
+        nodes.clear();
+        nodes.resize(prodOfComponents(gwb_.GetSize()));
+        ctx->currentVisit = 0;
+    }
     // Use a counter for the visited-states so we don't have to reset them on every invocation
-    currentVisit++;
+    ctx->currentVisit++;
     // if the counter reaches its maximum, tidy up
-    if(currentVisit == std::numeric_limits<unsigned>::max())
+    if(ctx->currentVisit == std::numeric_limits<unsigned>::max())
     {
-        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
-        {
-            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
-            if(node)
-                node->last_visit = 0;
-        }
-        currentVisit = 1;
+        for(RoadNodeState& node : nodes)
+            node.lastVisit = 0;
+        ctx->currentVisit = 1;
     }
 
-    // Add start node
-    todo.clear();
+    // The distance estimate is consistent (a road is never shorter than the distance between its flags and ship
+    // connections are much longer), so A* finds the cheapest path no matter how nodes with the same estimate are
+    // ordered. Only the chosen path among equally cheap ones depends on it, which the game logic requires to be
+    // the same as with the vector (replay compatibility). So use the faster bucket queue if the path is not required.
+    if(!firstDir && !firstNodePos)
+    {
+        ctx->bucketQueue.clear();
+        return FindPathAStar(ctx->bucketQueue, *ctx, start, goal, max, addCosts, isSegmentAllowed, length, firstDir,
+                             firstNodePos);
+    }
+    ctx->todo.clear();
+    return FindPathAStar(ctx->todo, *ctx, start, goal, max, addCosts, isSegmentAllowed, length, firstDir,
+                         firstNodePos);
+}
 
+template<class T_OpenList, class T_AdditionalCosts, class T_SegmentConstraints>
+bool RoadPathFinder::FindPathAStar(T_OpenList& todo, RoadPathFinderContext& ctx, const noRoadNode& start,
+                                   const noRoadNode& goal, const unsigned max, const T_AdditionalCosts addCosts,
+                                   const T_SegmentConstraints isSegmentAllowed, unsigned* const length,
+                                   RoadPathDirection* const firstDir, MapPoint* const firstNodePos) const
+{
+    // If the goal is a flag (unlikely) we have no goal building
+    // TODO(Replay): Change RoadPathFinder::FindPath to target flag instead of building for wares
+    const noRoadNode* goalBld = (goal.GetGOT() == GO_Type::Flag) ? nullptr : &goal;
+
+    std::vector<RoadNodeState>& nodes = ctx.nodes;
+    const unsigned currentVisit = ctx.currentVisit;
+
+    // Add start node
     const MapPoint goalPos = goal.GetPos();
-    start.targetDistance = gwb_.CalcDistance(start.GetPos(), goalPos);
-    start.estimate = start.targetDistance;
-    start.last_visit = currentVisit;
-    start.prev = nullptr;
-    start.cost = 0;
-    start.dir_ = RoadPathDirection::None;
+    RoadNodeState& startState = nodes[gwb_.GetIdx(start.GetPos())];
+    startState.targetDistance = gwb_.CalcDistance(start.GetPos(), goalPos);
+    startState.estimate = startState.targetDistance;
+    startState.lastVisit = currentVisit;
+    startState.prev = nullptr;
+    startState.node = &start;
+    startState.cost = 0;
+    startState.dir = RoadPathDirection::None;
 
-    todo.push(&start);
+    todo.push(&startState);
 
     while(!todo.empty())
     {
         // Get node with current least estimate
-        const noRoadNode& best = *todo.pop();
+        RoadNodeState& bestState = *todo.pop();
+        const noRoadNode& best = *bestState.node;
 
         // Reached goal
         if(&best == &goal)
         {
             if(length)
-                *length = best.cost;
+                *length = bestState.cost;
 
             // Backtrack to get the last node that is not the start node (has a prev node)
             // --> Next node from start on path
             if(firstDir || firstNodePos)
             {
-                const noRoadNode* firstNode = &best;
-                while(firstNode->prev != &start)
+                const RoadNodeState* firstNode = &bestState;
+                while(firstNode->prev != &startState)
                     firstNode = firstNode->prev;
 
                 if(firstDir)
-                    *firstDir = firstNode->dir_;
+                    *firstDir = firstNode->dir;
 
                 if(firstNodePos)
-                    *firstNodePos = firstNode->GetPos();
+                    *firstNodePos = firstNode->node->GetPos();
             }
 
             // Done, path found
@@ -187,7 +237,7 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         }
 
         const helpers::EnumArray<RoadSegment*, Direction> routes = best.getRoutes();
-        const noRoadNode* prevNode = best.prev;
+        const noRoadNode* prevNode = bestState.prev ? bestState.prev->node : nullptr;
 
         // Check paths in all directions
         for(const auto dir : helpers::EnumRange<Direction>{})
@@ -218,34 +268,37 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
             if(!isSegmentAllowed(*route))
                 continue;
 
-            const unsigned cost = best.cost + route->GetLength() + (neighbour != goalBld ? addCosts(best, dir) : 0);
+            const unsigned cost =
+              bestState.cost + route->GetLength() + (neighbour != goalBld ? addCosts(best, dir) : 0);
 
             if(cost > max)
                 continue;
 
+            RoadNodeState& nbState = nodes[gwb_.GetIdx(neighbour->GetPos())];
             // Was node already visited?
-            if(neighbour->last_visit == currentVisit)
+            if(nbState.lastVisit == currentVisit)
             {
                 // Update node if costs are lower
-                if(cost < neighbour->cost)
+                if(cost < nbState.cost)
                 {
-                    neighbour->cost = cost;
-                    neighbour->estimate = neighbour->targetDistance + cost;
-                    neighbour->prev = &best;
-                    neighbour->dir_ = toRoadPathDirection(dir);
-                    todo.rearrange(neighbour);
+                    nbState.cost = cost;
+                    nbState.estimate = nbState.targetDistance + cost;
+                    nbState.prev = &bestState;
+                    nbState.dir = toRoadPathDirection(dir);
+                    todo.rearrange(&nbState);
                 }
             } else
             {
                 // Not visited yet -> Add to list
-                neighbour->cost = cost;
-                neighbour->targetDistance = gwb_.CalcDistance(neighbour->GetPos(), goalPos);
-                neighbour->estimate = neighbour->targetDistance + cost;
-                neighbour->last_visit = currentVisit;
-                neighbour->prev = &best;
-                neighbour->dir_ = toRoadPathDirection(dir);
-
-                todo.push(neighbour);
+                nbState.cost = cost;
+                nbState.targetDistance = gwb_.CalcDistance(neighbour->GetPos(), goalPos);
+                nbState.estimate = nbState.targetDistance + cost;
+                nbState.lastVisit = currentVisit;
+                nbState.prev = &bestState;
+                nbState.node = neighbour;
+                nbState.dir = toRoadPathDirection(dir);
+
+                todo.push(&nbState);
             }
         }
 
@@ -254,35 +307,37 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
             continue;
         for(const auto& sc : static_cast<const nobHarborBuilding&>(best).GetShipConnections())
         {
-            unsigned cost = best.cost + sc.way_costs;
+            unsigned cost = bestState.cost + sc.way_costs;
 
             if(cost > max)
                 continue;
 
-            noRoadNode& dest = *sc.dest;
+            const noRoadNode& dest = *sc.dest;
+            RoadNodeState& destState = nodes[gwb_.GetIdx(dest.GetPos())];
             // Was node already visited?
-            if(dest.last_visit == currentVisit)
+            if(destState.lastVisit == currentVisit)
             {
                 // Update node if costs are lower
-                if(cost < dest.cost)
+                if(cost < destState.cost)
                 {
-                    dest.cost = cost;
-                    dest.estimate = dest.targetDistance + cost;
-                    dest.prev = &best;
-                    dest.dir_ = RoadPathDirection::Ship;
-                    todo.rearrange(&dest);
+                    destState.cost = cost;
+                    destState.estimate = destState.targetDistance + cost;
+                    destState.prev = &bestState;
+                    destState.dir = RoadPathDirection::Ship;
+                    todo.rearrange(&destState);
                 }
             } else
             {
                 // Not visited yet -> Add to list
-                dest.cost = cost;
-                dest.targetDistance = gwb_.CalcDistance(dest.GetPos(), goalPos);
-                dest.estimate = dest.targetDistance + cost;
-                dest.last_visit = currentVisit;
-                dest.prev = &best;
-                dest.dir_ = RoadPathDirection::Ship;
-
-                todo.push(&dest);
+                destState.cost = cost;
+                destState.targetDistance = gwb_.CalcDistance(dest.GetPos(), goalPos);
+                destState.estimate = destState.targetDistance + cost;
+                destState.lastVisit = currentVisit;
+                destState.prev = &bestState;
+                destState.node = &dest;
+                destState.dir = RoadPathDirection::Ship;
+
+                todo.push(&destState);
             }
         }
     }
@@ -293,7 +348,7 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
 
 bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, const bool wareMode, const unsigned max,
                               const RoadSegment* const forbidden, unsigned* const length,
-                              RoadPathDirection* const firstDir, MapPoint* const firstNodePos)
+                              RoadPathDirection* const firstDir, MapPoint* const firstNodePos) const
 {
     RTTR_Assert_Msg(length || firstDir || firstNodePos, "Use PathExists instead!");
 
@@ -320,7 +375,7 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
 }
 
 bool RoadPathFinder::PathExists(const noRoadNode& start, const noRoadNode& goal, const bool allowWaterRoads,
-                                const unsigned max, const RoadSegment* const forbidden)
+                                const unsigned max, const RoadSegment* const forbidden) const
 {
     if(allowWaterRoads)
     {
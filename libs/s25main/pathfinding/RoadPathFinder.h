@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "pathfinding/ContextPool.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/RoadPathDirection.h"
 #include <limits>
@@ -11,14 +12,19 @@
 class GameWorldBase;
 class noRoadNode;
 class RoadSegment;
+struct RoadPathFinderContext;
 
+/// Pathfinding on the road network.
+/// The per-node state is kept in scratch contexts leased from a pool (indexed by the map index of the road node),
+/// so queries do not modify the road nodes and can run concurrently on a const world
 class RoadPathFinder
 {
-    GameWorldBase& gwb_;
-    unsigned currentVisit;
+    const GameWorldBase& gwb_;
+    mutable ContextPool<RoadPathFinderContext> contexts_;
 
 public:
-    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0) {}
+    RoadPathFinder(const GameWorldBase& gwb);
+    ~RoadPathFinder();
 
     /// Calculates the best path from start to goal
     /// Outputs are only valid if true is returned!
@@ -33,7 +39,8 @@ public:
     /// @param firstNodePos If != nullptr will receive the position of the first node
     bool FindPath(const noRoadNode& start, const noRoadNode& goal, bool wareMode,
                   unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr,
-                  unsigned* length = nullptr, RoadPathDirection* firstDir = nullptr, MapPoint* firstNodePos = nullptr);
+                  unsigned* length = nullptr, RoadPathDirection* firstDir = nullptr,
+                  MapPoint* firstNodePos = nullptr) const;
 
     /// Checks if there is ANY path from start to goal
     ///
@@ -41,11 +48,15 @@ public:
     /// @param max Maximum costs allowed (Usually makes pathfinding faster)
     /// @param forbidden RoadSegment that will be ignored
     bool PathExists(const noRoadNode& start, const noRoadNode& goal, bool allowWaterRoads,
-                    unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr);
+                    unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr) const;
 
 private:
     template<class T_AdditionalCosts, class T_SegmentConstraints>
     bool FindPathImpl(const noRoadNode& start, const noRoadNode& goal, unsigned max, T_AdditionalCosts addCosts,
                       T_SegmentConstraints isSegmentAllowed, unsigned* length = nullptr,
-                      RoadPathDirection* firstDir = nullptr, MapPoint* firstNodePos = nullptr);
+                      RoadPathDirection* firstDir = nullptr, MapPoint* firstNodePos = nullptr) const;
+    template<class T_OpenList, class T_AdditionalCosts, class T_SegmentConstraints>
+    bool FindPathAStar(T_OpenList& todo, RoadPathFinderContext& ctx, const noRoadNode& start, const noRoadNode& goal,
+                       unsigned max, T_AdditionalCosts addCosts, T_SegmentConstraints isSegmentAllowed,
+                       unsigned* length, RoadPathDirection* firstDir, MapPoint* firstNodePos) const;
 };
@@ -0,0 +1,186 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pathfinding/ShipPathCache.h"
+#include "RttrForeachPt.h"
+#include "helpers/EnumRange.h"
+#include "helpers/containerUtils.h"
+#include "pathfinding/PathConditionShip.h"
+#include "world/World.h"
+#include <algorithm>
+
+ShipPathCache::ShipPathCache(const World& world) : world_(world) {}
+
+ShipPathCache::~ShipPathCache() = default;
+
+void ShipPathCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isInitialized_ = false;
+    seaPtIdx_.clear();
+    coastalPtToField_.clear();
+    distanceFields_.clear();
+    routes_.clear();
+}
+
+void ShipPathCache::init() const
+{
+    if(isInitialized_)
+        return;
+    const PathConditionShip shipPathChecker(world_);
+    seaPtIdx_.assign(prodOfComponents(world_.GetSize()), NO_IDX);
+    unsigned numSeaPts = 0;
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        if(shipPathChecker.IsNodeOk(pt))
+            seaPtIdx_[world_.GetIdx(pt)] = numSeaPts++;
+    }
+    numSeaPts_ = numSeaPts;
+
+    coastalPtToField_.clear();
+    distanceFields_.clear();
+    for(unsigned hbId = 1; hbId <= world_.GetNumHarborPoints(); hbId++)
+    {
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            if(!world_.GetSeaId(hbId, dir))
+                continue;
+            const unsigned coastIdx = world_.GetIdx(world_.GetNeighbour(world_.GetHarborPoint(hbId), dir));
+            if(coastalPtToField_.emplace(coastIdx, distanceFields_.size()).second)
+                distanceFields_.emplace_back();
+        }
+    }
+    isInitialized_ = true;
+}
+
+const ShipPathCache::DistanceField& ShipPathCache::getDistanceField(unsigned fieldIdx, const MapPoint dest) const
+{
+    DistanceField& field = distanceFields_[fieldIdx];
+    if(!field.isCalculated)
+    {
+        calcDistanceField(field, dest);
+        field.isCalculated = true;
+    }
+    return field;
+}
+
+void ShipPathCache::calcDistanceField(DistanceField& field, const MapPoint dest) const
+{
+    const PathConditionShip shipPathChecker(world_);
+    field.distances.assign(numSeaPts_, NO_DISTANCE);
+    // BFS starting at the destination. The edge condition is symmetric (water on both sides of the edge),
+    // so the distance from the destination is the distance to the destination.
+    // Only sea points can be passed, the start is handled in getDistance
+    std::vector<MapPoint> curLevel{dest}, nextLevel;
+    const unsigned destSeaIdx = seaPtIdx_[world_.GetIdx(dest)];
+    if(destSeaIdx != NO_IDX)
+        field.distances[destSeaIdx] = 0;
+    unsigned curDistance = 0;
+    while(!curLevel.empty())
+    {
+        if(curDistance + 1u >= NO_DISTANCE)
+        {
+            field.isInvalid = true;
+            field.distances.clear();
+            return;
+        }
+        for(const MapPoint pt : curLevel)
+        {
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint nb = world_.GetNeighbour(pt, dir);
+                const unsigned nbSeaIdx = seaPtIdx_[world_.GetIdx(nb)];
+                if(nbSeaIdx == NO_IDX || field.distances[nbSeaIdx] != NO_DISTANCE)
+                    continue;
+                if(!shipPathChecker.IsEdgeOk(pt, dir))
+                    continue;
+                field.distances[nbSeaIdx] = static_cast<Distance>(curDistance + 1u);
+                nextLevel.push_back(nb);
+            }
+        }
+        std::swap(curLevel, nextLevel);
+        nextLevel.clear();
+        ++curDistance;
+    }
+}
+
+boost::optional<unsigned> ShipPathCache::getDistance(const MapPoint start, const MapPoint dest) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    init();
+    const auto itField = coastalPtToField_.find(world_.GetIdx(dest));
+    if(itField == coastalPtToField_.end())
+        return boost::none;
+    const DistanceField& field = getDistanceField(itField->second, dest);
+    if(field.isInvalid)
+        return boost::none;
+    if(start == dest)
+        return 0u;
+
+    const unsigned startSeaIdx = seaPtIdx_[world_.GetIdx(start)];
+    if(startSeaIdx != NO_IDX)
+    {
+        const Distance distance = field.distances[startSeaIdx];
+        return (distance == NO_DISTANCE) ? NO_PATH : distance;
+    }
+    // The start point itself does not need to be a sea point (e.g. the coastal point of a harbor)
+    // so check which sea point (or the destination) we can reach first
+    const PathConditionShip shipPathChecker(world_);
+    unsigned bestDistance = NO_PATH;
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        if(!shipPathChecker.IsEdgeOk(start, dir))
+            continue;
+        const MapPoint nb = world_.GetNeighbour(start, dir);
+        if(nb == dest)
+            return 1u;
+        const unsigned nbSeaIdx = seaPtIdx_[world_.GetIdx(nb)];
+        if(nbSeaIdx != NO_IDX && field.distances[nbSeaIdx] != NO_DISTANCE)
+            bestDistance = std::min<unsigned>(bestDistance, field.distances[nbSeaIdx] + 1u);
+    }
+    return bestDistance;
+}
+
+uint64_t ShipPathCache::makeRouteKey(unsigned startIdx, unsigned destIdx, Direction startDir)
+{
+    return (static_cast<uint64_t>(startIdx) << 35) | (static_cast<uint64_t>(destIdx) << 3)
+           | static_cast<uint64_t>(startDir);
+}
+
+bool ShipPathCache::getRoute(const MapPoint start, const MapPoint dest, const Direction startDir,
+                             std::vector<Direction>& route) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = routes_.find(makeRouteKey(world_.GetIdx(start), world_.GetIdx(dest), startDir));
+    if(it == routes_.end())
+        return false;
+    route = it->second;
+    return true;
+}
+
+void ShipPathCache::addRoute(const MapPoint start, const MapPoint dest, const Direction startDir,
+                             const std::vector<Direction>& route)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    init();
+    const unsigned startIdx = world_.GetIdx(start);
+    const unsigned destIdx = world_.GetIdx(dest);
+    // Ships only start at arbitrary points after an interruption, so only harbor to harbor routes are worth caching
+    if(!helpers::contains(coastalPtToField_, startIdx) || !helpers::contains(coastalPtToField_, destIdx))
+        return;
+    routes_.emplace(makeRouteKey(startIdx, destIdx, startDir), route);
+}
+
+unsigned ShipPathCache::getNumDistanceFields() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::count_if(distanceFields_.begin(), distanceFields_.end(),
+                         [](const DistanceField& field) { return field.isCalculated; });
+}
+
+unsigned ShipPathCache::getNumRoutes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return routes_.size();
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class World;
+
+/// Precomputed data for ship pathfinding which only depends on the water terrain:
+/// - A distance field per harbor coastal point holding the length of the shortest ship path from every sea point
+/// - The routes between the coastal points of harbors as found by the pathfinder
+/// Both are computed lazily on first use and must be cleared when the terrain or the seas change.
+/// All functions are thread-safe.
+class ShipPathCache
+{
+public:
+    /// Distance returned if there is no path at all
+    static constexpr unsigned NO_PATH = std::numeric_limits<unsigned>::max();
+
+    explicit ShipPathCache(const World& world);
+    ~ShipPathCache();
+
+    /// Drop all precomputed data
+    void clear();
+
+    /// Return the length of the shortest ship path from start to dest or NO_PATH if there is none.
+    /// Returns boost::none if this is unknown, i.e. dest is not the coastal point of a harbor.
+    boost::optional<unsigned> getDistance(MapPoint start, MapPoint dest) const;
+
+    /// Get a cached route from start to dest when starting to search in startDir. Return false if not cached
+    bool getRoute(MapPoint start, MapPoint dest, Direction startDir, std::vector<Direction>& route) const;
+    /// Add a route found by the pathfinder. Only routes between harbor coastal points are stored
+    void addRoute(MapPoint start, MapPoint dest, Direction startDir, const std::vector<Direction>& route);
+
+    /// Number of distance fields computed so far
+    unsigned getNumDistanceFields() const;
+    /// Number of cached routes
+    unsigned getNumRoutes() const;
+
+private:
+    using Distance = uint16_t;
+    static constexpr Distance NO_DISTANCE = std::numeric_limits<Distance>::max();
+    static constexpr unsigned NO_IDX = std::numeric_limits<unsigned>::max();
+
+    struct DistanceField
+    {
+        bool isCalculated = false;
+        /// Could not be calculated (distances too large)
+        bool isInvalid = false;
+        /// Distance for each sea point (indexed by its sea point index)
+        std::vector<Distance> distances;
+    };
+
+    /// Collect sea points and harbor coastal points
+    void init() const;
+    const DistanceField& getDistanceField(unsigned fieldIdx, MapPoint dest) const;
+    void calcDistanceField(DistanceField& field, MapPoint dest) const;
+    static uint64_t makeRouteKey(unsigned startIdx, unsigned destIdx, Direction startDir);
+
+    const World& world_;
+    mutable std::mutex mutex_;
+    mutable bool isInitialized_ = false;
+    /// Index of each node into the distance fields or NO_IDX if it is not a sea point
+    mutable std::vector<unsigned> seaPtIdx_;
+    mutable unsigned numSeaPts_ = 0;
+    /// Index of the distance field for each harbor coastal point (key is the map index)
+    mutable std::unordered_map<unsigned, unsigned> coastalPtToField_;
+    mutable std::vector<DistanceField> distanceFields_;
+    std::unordered_map<uint64_t, std::vector<Direction>> routes_;
+};
@@ -23,9 +23,13 @@
 #include "notifications/BuildingNote.h"
 #include "notifications/ExpeditionNote.h"
 #include "notifications/NodeNote.h"
+#include "notifications/PlayerNodeNote.h"
 #include "notifications/RoadNote.h"
+#include "pathfinding/HumanReachability.h"
 #include "pathfinding/PathConditionHuman.h"
 #include "pathfinding/PathConditionRoad.h"
+#include "pathfinding/RehomingCache.h"
+#include "pathfinding/ShipPathCache.h"
 #include "postSystem/PostMsgWithBuilding.h"
 #include "world/MapGeometry.h"
 #include "world/TerritoryRegion.h"
@@ -406,6 +410,8 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
             continue;
 
         SetOwner(curMapPt, newOwner);
+        if(tradePathCache)
+            tradePathCache->nodeChanged(curMapPt);
         ptsWithChangedOwners.push_back(curMapPt);
         if(newOwner != 0)
             sizeChanges[newOwner - 1]++;
@@ -445,29 +451,35 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
         flag->DestroyRoad(dir);
     }
 
-    // Notify
-    for(const MapPoint& curMapPt : ptsWithChangedOwners)
-        GetNotifications().publish(NodeNote(NodeNote::Owner, curMapPt));
-
-    for(const MapPoint& pt : ptsToHandle)
     {
-        // BQ neu berechnen
-        RecalcBQ(pt);
-        // ggf den noch darüber, falls es eine Flagge war (kann ja ein Gebäude entstehen)
-        const MapPoint neighbourPt = GetNeighbour(pt, Direction::NorthWest);
-        if(GetNode(neighbourPt).bq != BuildingQuality::Nothing)
-            RecalcBQ(neighbourPt);
+        // Notify about the owner and BQ changes of all nodes at once
+        NotificationManager::Batch<NodeNote> nodeNotes(GetNotifications());
+        for(const MapPoint& curMapPt : ptsWithChangedOwners)
+            GetNotifications().publish(NodeNote(NodeNote::Owner, curMapPt));
+
+        for(const MapPoint& pt : ptsToHandle)
+        {
+            // BQ neu berechnen
+            RecalcBQ(pt);
+            // ggf den noch darüber, falls es eine Flagge war (kann ja ein Gebäude entstehen)
+            const MapPoint neighbourPt = GetNeighbour(pt, Direction::NorthWest);
+            if(GetNode(neighbourPt).bq != BuildingQuality::Nothing)
+                RecalcBQ(neighbourPt);
+        }
     }
 
     RecalcBorderStones(region.startPt, region.size);
 
-    // Recalc visibilities if building was destroyed
-    // Otherwise just set everything to visible
-    const unsigned visualRadius = militaryRadius + VISUALRANGE_MILITARY;
-    if(reason == TerritoryChangeReason::Destroyed)
-        RecalcVisibilitiesAroundPoint(building.GetPos(), visualRadius, building.GetPlayer(), &building);
-    else
-        MakeVisibleAroundPoint(building.GetPos(), visualRadius, building.GetPlayer());
+    {
+        NotificationManager::Batch<PlayerNodeNote> visibilityNotes(GetNotifications());
+        // Recalc visibilities if building was destroyed
+        // Otherwise just set everything to visible
+        const unsigned visualRadius = militaryRadius + VISUALRANGE_MILITARY;
+        if(reason == TerritoryChangeReason::Destroyed)
+            RecalcVisibilitiesAroundPoint(building.GetPos(), visualRadius, building.GetPlayer(), &building);
+        else
+            MakeVisibleAroundPoint(building.GetPos(), visualRadius, building.GetPlayer());
+    }
 
     // Notify players
     for(unsigned i = 0; i < GetNumPlayers(); ++i)
@@ -1422,6 +1434,12 @@ std::vector<unsigned> GameWorld::GetUnexploredHarborPoints(const unsigned hbIdTo
 
 MapNode& GameWorld::GetNodeWriteable(const MapPoint pt)
 {
+    // The terrain might be changed
+    humanReachability->clear();
+    rehomingCache->clear();
+    shipPathCache->clear();
+    if(tradePathCache)
+        tradePathCache->nodeChanged(pt);
     return GetNodeInt(pt);
 }
 
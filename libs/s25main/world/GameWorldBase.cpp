@@ -17,10 +17,17 @@
 #include "helpers/EnumRange.h"
 #include "helpers/containerUtils.h"
 #include "lua/LuaInterfaceGame.h"
+#include "notifications/BuildingNote.h"
 #include "notifications/NodeNote.h"
 #include "notifications/PlayerNodeNote.h"
 #include "pathfinding/FreePathFinder.h"
+#include "pathfinding/HumanReachability.h"
+#include "pathfinding/RehomingCache.h"
+#include "pathfinding/RoadNetworks.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/ShipPathCache.h"
+#include "world/PlayerObjectIndex.h"
+#include "world/WorldStateHash.h"
 #include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
@@ -28,9 +35,23 @@
 #include <utility>
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
-    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
-      gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr), gi(nullptr)
-{}
+    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)),
+      shipPathCache(std::make_unique<ShipPathCache>(*this)),
+      playerObjectIndex(std::make_unique<PlayerObjectIndex>(*this)), players(std::move(players)),
+      gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr), gi(nullptr),
+      humanReachability(std::make_unique<HumanReachability>(*this)),
+      rehomingCache(std::make_unique<RehomingCache>(*this)),
+      roadNetworks(std::make_unique<RoadNetworks>(*this)), stateHash(std::make_unique<WorldStateHash>(*this))
+{
+    // A captured building and its flag change the owner without being replaced
+    buildingNoteSub = notifications.subscribe<BuildingNote>([this](const BuildingNote& note) {
+        if(note.type != BuildingNote::Captured)
+            return;
+        playerObjectIndex->Update(note.pos, GetNode(note.pos).obj);
+        const MapPoint flagPos = GetNeighbour(note.pos, Direction::SouthEast);
+        playerObjectIndex->Update(flagPos, GetNode(flagPos).obj);
+    });
+}
 
 GameWorldBase::~GameWorldBase() = default;
 
@@ -39,12 +60,30 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     RTTR_Assert(GetDescription().terrain.size() > 0); // Must have game data initialized
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
+    shipPathCache->clear();
+    humanReachability->clear();
+    rehomingCache->clear();
+    roadNetworks->clear();
+    playerObjectIndex->Init(mapSize, GetNumPlayers());
+    stateHash->recalc();
 }
 
 void GameWorldBase::InitAfterLoad()
 {
+    // Terrain might have been changed since the seas were calculated
+    shipPathCache->clear();
+    humanReachability->clear();
+    rehomingCache->clear();
+    // Roads might have been added without notification when loading
+    roadNetworks->clear();
     RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
         RecalcBQ(pt);
+        // Objects might have been added without notification when loading
+        playerObjectIndex->Update(pt, GetNode(pt).obj);
+    }
+    // Loading bypasses the incremental updates
+    stateHash->recalc();
 }
 
 GamePlayer& GameWorldBase::GetPlayer(const unsigned id)
@@ -268,6 +307,44 @@ void GameWorldBase::AltitudeChanged(const MapPoint pt)
     GetNotifications().publish(NodeNote(NodeNote::Altitude, pt));
 }
 
+void GameWorldBase::SeasChanged()
+{
+    shipPathCache->clear();
+    // Usually caused by a terrain change
+    humanReachability->clear();
+    rehomingCache->clear();
+    if(tradePathCache)
+        tradePathCache->clear();
+}
+
+void GameWorldBase::NodeObjectChanged(const MapPoint pt)
+{
+    humanReachability->objectChanged(pt);
+    rehomingCache->clear();
+    playerObjectIndex->Update(pt, GetNode(pt).obj);
+    stateHash->objectChanged(pt, GetNode(pt).obj);
+    if(tradePathCache)
+        tradePathCache->nodeChanged(pt);
+}
+
+void GameWorldBase::RoadChanged(const MapPoint pt)
+{
+    humanReachability->roadChanged(pt);
+    rehomingCache->clear();
+    if(tradePathCache)
+        tradePathCache->nodeChanged(pt);
+}
+
+void GameWorldBase::OwnerChanged(const MapPoint pt, const unsigned char oldOwner)
+{
+    stateHash->ownerChanged(pt, oldOwner, GetNode(pt).owner);
+}
+
+void GameWorldBase::FigureChanged(const MapPoint pt, const noBase& figure)
+{
+    stateHash->figureChanged(pt, figure);
+}
+
 void GameWorldBase::RecalcBQAroundPoint(const MapPoint pt)
 {
     RecalcBQ(pt);
@@ -277,6 +354,7 @@ void GameWorldBase::RecalcBQAroundPoint(const MapPoint pt)
 
 void GameWorldBase::RecalcBQAroundPointBig(const MapPoint pt)
 {
+    NotificationManager::Batch<NodeNote> bqNotes(GetNotifications());
     // Point and radius 1
     RecalcBQAroundPoint(pt);
     // And radius 2
@@ -21,13 +21,19 @@ class FreePathFinder;
 class GameInterface;
 class GamePlayer;
 class GlobalGameSettings;
+class HumanReachability;
 class nobHarborBuilding;
 class noBuildingSite;
 class noFlag;
 class nofPassiveSoldier;
+class PlayerObjectIndex;
+class RehomingCache;
+class RoadNetworks;
 class RoadPathFinder;
+class ShipPathCache;
 class SoundManager;
 class TradePathCache;
+class WorldStateHash;
 
 constexpr Direction getOppositeDir(const RoadDir roadDir) noexcept
 {
@@ -52,8 +58,12 @@ class GameWorldBase : public World
 {
     std::unique_ptr<RoadPathFinder> roadPathFinder;
     std::unique_ptr<FreePathFinder> freePathFinder;
+    std::unique_ptr<ShipPathCache> shipPathCache;
+    std::unique_ptr<PlayerObjectIndex> playerObjectIndex;
     PostManager postManager;
     mutable NotificationManager notifications;
+    /// Updates the player object index on captured buildings
+    Subscription buildingNoteSub;
 
     std::vector<GamePlayer> players;
     const GlobalGameSettings& gameSettings;
@@ -67,6 +77,10 @@ protected:
     GameInterface* gi;
     std::unique_ptr<EconomyModeHandler> econHandler;
     std::unique_ptr<TradePathCache> tradePathCache;
+    std::unique_ptr<HumanReachability> humanReachability;
+    std::unique_ptr<RehomingCache> rehomingCache;
+    std::unique_ptr<RoadNetworks> roadNetworks;
+    std::unique_ptr<WorldStateHash> stateHash;
 
 public:
     GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em);
@@ -114,12 +128,24 @@ public:
                                                    std::vector<Direction>* route = nullptr) const;
     /// Find path for ships to a specific harbor and see. Return true on success
     bool FindShipPathToHarbor(MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route,
-                              unsigned* length);
+                              unsigned* length) const;
     /// Find path for ships with a limited distance. Return true on success
     bool FindShipPath(MapPoint start, MapPoint dest, unsigned maxDistance, std::vector<Direction>* route,
-                      unsigned* length);
-    RoadPathFinder& GetRoadPathFinder() const { return *roadPathFinder; }
-    FreePathFinder& GetFreePathFinder() const { return *freePathFinder; }
+                      unsigned* length) const;
+    /// The pathfinders only have const queries which are safe to run concurrently
+    const RoadPathFinder& GetRoadPathFinder() const { return *roadPathFinder; }
+    const FreePathFinder& GetFreePathFinder() const { return *freePathFinder; }
+    const ShipPathCache& GetShipPathCache() const { return *shipPathCache; }
+    const HumanReachability& GetHumanReachability() const { return *humanReachability; }
+    /// Searches shared by the wandering figures
+    const RehomingCache& GetRehomingCache() const { return *rehomingCache; }
+    /// Connected road networks, to be cleared when a road node gets or loses a road
+    RoadNetworks& GetRoadNetworks() { return *roadNetworks; }
+    const RoadNetworks& GetRoadNetworks() const { return *roadNetworks; }
+    WorldStateHash& GetStateHash() { return *stateHash; }
+    const WorldStateHash& GetStateHash() const { return *stateHash; }
+    /// Spatial index of the flags and buildings of each player
+    const PlayerObjectIndex& GetPlayerObjectIndex() const { return *playerObjectIndex; }
 
     /// Return flag that is on road at given point. dir will be set to the direction of the road from the returned flag
     /// prevDir (if set) will be skipped when searching for the road points
@@ -224,6 +250,12 @@ protected:
     void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) override;
     /// Called, when the altitude of a point was changed
     void AltitudeChanged(MapPoint pt) override;
+    /// Called when the seas were recalculated, e.g. after changing the terrain
+    void SeasChanged() override;
+    void NodeObjectChanged(MapPoint pt) override;
+    void RoadChanged(MapPoint pt) override;
+    void OwnerChanged(MapPoint pt, unsigned char oldOwner) override;
+    void FigureChanged(MapPoint pt, const noBase& figure) override;
 
 private:
     /// Returns the harbor ID of the next matching harbor in the given direction (0 = None)
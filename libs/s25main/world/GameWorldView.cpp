@@ -19,6 +19,7 @@
 #include "helpers/containerUtils.h"
 #include "helpers/toString.h"
 #include "ogl/FontStyle.h"
+#include "ogl/IRenderer.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
 #include "ogl/glSmartBitmap.h"
@@ -152,6 +153,9 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
     terrainRenderer.Draw(GetFirstPt(), GetLastPt(), gwv, water);
     glTranslatef(static_cast<GLfloat>(offset.x), static_cast<GLfloat>(offset.y), 0.0f);
 
+    // Most objects are drawn from a few packed textures, so collect them to reduce the number of draw calls
+    IRenderer& renderer = *VIDEODRIVER.GetRenderer();
+    renderer.BeginSpriteBatch();
     for(int y = firstPt.y; y <= lastPt.y; ++y)
     {
         // Figuren speichern, die in dieser Zeile gemalt werden müssen
@@ -201,6 +205,7 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
         for(auto& between_line : between_lines)
             between_line.obj.Draw(between_line.pos);
     }
+    renderer.EndSpriteBatch();
 
     if(show_names || show_productivity)
         DrawNameProductivityOverlay(terrainRenderer);
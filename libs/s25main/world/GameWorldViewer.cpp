@@ -48,9 +48,12 @@ void GameWorldViewer::InitVisualData()
     }
     evRoadConstruction =
       gwb.GetNotifications().subscribe<RoadNote>([this](const RoadNote& note) { RoadConstructionEnded(note); });
-    evBQChanged = gwb.GetNotifications().subscribe<NodeNote>([this](const NodeNote& note) {
-        if(note.type == NodeNote::BQ)
-            RecalcBQ(note.pos);
+    evBQChanged = gwb.GetNotifications().subscribeBatch<NodeNote>([this](const std::vector<NodeNote>& notes) {
+        for(const NodeNote& note : notes)
+        {
+            if(note.type == NodeNote::BQ)
+                RecalcBQ(note.pos);
+        }
     });
 }
 
@@ -66,10 +69,14 @@ void GameWorldViewer::InitTerrainRenderer()
         }
     });
     // And visibility changes
-    evVisibilityChanged = gwb.GetNotifications().subscribe<PlayerNodeNote>([this](const PlayerNodeNote& note) {
-        if(note.type == PlayerNodeNote::Visibility)
-            VisibilityChanged(note.pt, note.player);
-    });
+    evVisibilityChanged =
+      gwb.GetNotifications().subscribeBatch<PlayerNodeNote>([this](const std::vector<PlayerNodeNote>& notes) {
+          for(const PlayerNodeNote& note : notes)
+          {
+              if(note.type == PlayerNodeNote::Visibility)
+                  VisibilityChanged(note.pt, note.player);
+          }
+      });
 }
 
 SoundManager& GameWorldViewer::GetSoundMgr()
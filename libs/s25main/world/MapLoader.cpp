@@ -477,6 +477,7 @@ bool MapLoader::InitSeasAndHarbors(World& world, const std::vector<MapPoint>& ad
 
     // Calculate the neighbors and distances
     CalcHarborPosNeighbors(world);
+    world.SeasChanged();
 
     // Validate
     for(unsigned startHbId = 1; startHbId < world.harbor_pos.size(); ++startHbId)
@@ -5,13 +5,53 @@
 #include "world/MapSerializer.h"
 #include "CatapultStone.h"
 #include "Game.h"
+#include "RttrForeachPt.h"
 #include "SerializedGameData.h"
 #include "buildings/noBuildingSite.h"
+#include "helpers/EnumRange.h"
+#include "helpers/MaxEnumValue.h"
 #include "helpers/Range.h"
+#include "helpers/format.hpp"
 #include "lua/GameDataLoader.h"
 #include "world/GameWorldBase.h"
+#include "gameData/TerrainDesc.h"
 #include "s25util/warningSuppression.h"
 #include <mygettext/mygettext.h>
+#include <vector>
+
+namespace {
+/// Write the value of every node as one block read by SerializedGameData::PopBlock.
+/// The values are pushed directly to avoid copying them from a scratch buffer. Multi-byte values are big endian.
+template<typename T_Value, class T_GetValue>
+void pushPlane(SerializedGameData& sgd, const std::vector<MapNode>& nodes, T_GetValue&& getValue)
+{
+    sgd.PushUnsignedInt(nodes.size() * sizeof(T_Value));
+    for(const MapNode& node : nodes)
+        sgd.Push<T_Value>(getValue(node));
+}
+
+/// Read a block written by pushPlane directly from the buffer of sgd
+template<typename T_Value, class T_SetValue>
+void popPlane(SerializedGameData& sgd, std::vector<MapNode>& nodes, T_SetValue&& setValue)
+{
+    const uint8_t* data = sgd.PopBlock(nodes.size() * sizeof(T_Value));
+    for(MapNode& node : nodes)
+    {
+        uint32_t value = 0;
+        for(unsigned i = 0; i < sizeof(T_Value); i++)
+            value = (value << 8) | *data++;
+        setValue(node, static_cast<T_Value>(value));
+    }
+}
+
+template<typename T_Enum>
+T_Enum toEnum(const uint8_t value)
+{
+    if(value > helpers::MaxEnumValue_v<T_Enum>)
+        throw SerializedGameData::Error(helpers::format("Invalid value %1% in node plane", unsigned(value)));
+    return T_Enum(value);
+}
+} // namespace
 
 void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sgd)
 {
@@ -22,11 +62,7 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
     sgd.PushUnsignedInt(GameObject::GetObjIDCounter());
 
     // Alle Weltpunkte serialisieren
-    const unsigned numPlayers = world.GetNumPlayers();
-    for(const auto& node : world.nodes)
-    {
-        node.Serialize(sgd, numPlayers, world.GetDescription());
-    }
+    SerializeNodes(world, sgd);
 
     // Katapultsteine serialisieren
     sgd.PushObjectContainer(world.catapult_stones, true);
@@ -77,6 +113,109 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
     }
 }
 
+void MapSerializer::SerializeNodes(const GameWorldBase& world, SerializedGameData& sgd)
+{
+    const std::vector<MapNode>& nodes = world.nodes;
+    const unsigned numPlayers = world.GetNumPlayers();
+
+    for(const auto dir : helpers::enumRange<RoadDir>())
+        pushPlane<uint8_t>(sgd, nodes, [dir](const MapNode& node) { return rttr::enum_cast(node.roads[dir]); });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.altitude; });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.shadow; });
+    // Terrains are stored by name, so store all names once and the index for each node
+    const auto& terrains = world.GetDescription().terrain;
+    sgd.PushUnsignedChar(terrains.size());
+    for(unsigned i = 0; i < terrains.size(); i++)
+        sgd.PushString(terrains.get(DescIdx<TerrainDesc>(i)).name);
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.t1.value; });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.t2.value; });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.resources.getValue(); });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.reserved ? 1 : 0; });
+    pushPlane<uint8_t>(sgd, nodes, [](const MapNode& node) { return node.owner; });
+    for(const auto pos : helpers::enumRange<BorderStonePos>())
+        pushPlane<uint8_t>(sgd, nodes, [pos](const MapNode& node) { return node.boundary_stones[pos]; });
+    pushPlane<uint16_t>(sgd, nodes, [](const MapNode& node) { return node.seaId; });
+    pushPlane<uint32_t>(sgd, nodes, [](const MapNode& node) { return node.harborId; });
+    RTTR_Assert(numPlayers <= MAX_PLAYERS);
+    for(unsigned player = 0; player < numPlayers; player++)
+    {
+        pushPlane<uint8_t>(sgd, nodes,
+                           [player](const MapNode& node) { return rttr::enum_cast(node.fow[player].visibility); });
+    }
+
+    // Only nodes in FoW have further FoW data
+    for(const MapNode& node : nodes)
+    {
+        for(unsigned player = 0; player < numPlayers; player++)
+            node.fow[player].SerializeFogData(sgd);
+    }
+    for(const MapNode& node : nodes)
+    {
+        sgd.PushObject(node.obj);
+        sgd.PushObjectContainer(node.figures);
+    }
+}
+
+void MapSerializer::DeserializeNodes(GameWorldBase& world, SerializedGameData& sgd)
+{
+    std::vector<MapNode>& nodes = world.nodes;
+    const unsigned numPlayers = world.GetNumPlayers();
+
+    for(const auto dir : helpers::enumRange<RoadDir>())
+    {
+        popPlane<uint8_t>(sgd, nodes,
+                          [dir](MapNode& node, uint8_t value) { node.roads[dir] = toEnum<PointRoad>(value); });
+    }
+    popPlane<uint8_t>(sgd, nodes, [](MapNode& node, uint8_t value) { node.altitude = value; });
+    popPlane<uint8_t>(sgd, nodes, [](MapNode& node, uint8_t value) { node.shadow = value; });
+    std::vector<DescIdx<TerrainDesc>> terrains(sgd.PopUnsignedChar());
+    for(auto& terrain : terrains)
+    {
+        const std::string name = sgd.PopString();
+        terrain = world.GetDescription().terrain.getIndex(name);
+        if(!terrain)
+            throw SerializedGameData::Error("Terrain with name '" + name + "' not found");
+    }
+    const auto getTerrain = [&terrains](uint8_t value) {
+        if(value >= terrains.size())
+            throw SerializedGameData::Error(helpers::format("Invalid terrain index %1%", unsigned(value)));
+        return terrains[value];
+    };
+    popPlane<uint8_t>(sgd, nodes, [&getTerrain](MapNode& node, uint8_t value) { node.t1 = getTerrain(value); });
+    popPlane<uint8_t>(sgd, nodes, [&getTerrain](MapNode& node, uint8_t value) { node.t2 = getTerrain(value); });
+    popPlane<uint8_t>(sgd, nodes, [](MapNode& node, uint8_t value) { node.resources = Resource(value); });
+    popPlane<uint8_t>(sgd, nodes, [](MapNode& node, uint8_t value) { node.reserved = value != 0; });
+    popPlane<uint8_t>(sgd, nodes, [](MapNode& node, uint8_t value) { node.owner = value; });
+    for(const auto pos : helpers::enumRange<BorderStonePos>())
+        popPlane<uint8_t>(sgd, nodes, [pos](MapNode& node, uint8_t value) { node.boundary_stones[pos] = value; });
+    popPlane<uint16_t>(sgd, nodes, [](MapNode& node, uint16_t value) { node.seaId = value; });
+    popPlane<uint32_t>(sgd, nodes, [](MapNode& node, uint32_t value) { node.harborId = value; });
+    RTTR_Assert(numPlayers <= MAX_PLAYERS);
+    // Only the visibility is known until the FoW data is read
+    for(unsigned player = 0; player < numPlayers; player++)
+    {
+        popPlane<uint8_t>(sgd, nodes, [player](MapNode& node, uint8_t value) {
+            node.fow[player].visibility = toEnum<Visibility>(value);
+        });
+    }
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(world.GetNode(pt).harborId)
+            world.harbor_pos.push_back(HarborPos(pt));
+    }
+
+    for(MapNode& node : nodes)
+    {
+        for(unsigned player = 0; player < numPlayers; player++)
+            node.fow[player].Deserialize(sgd, node.fow[player].visibility);
+    }
+    for(MapNode& node : nodes)
+    {
+        node.obj = sgd.PopObject<noBase>();
+        sgd.PopObjectContainer(node.figures);
+    }
+}
+
 void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, Game& game,
                                 ILocalGameState& localgameState)
 {
@@ -102,29 +241,34 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
     world.Init(size, lt);
     GameObject::ResetCounters(sgd.PopUnsignedInt());
 
-    std::vector<DescIdx<TerrainDesc>> landscapeTerrains;
-    if(sgd.GetGameDataVersion() < 3)
-    {
-        // Assumes the order of the terrain in the description file is the same as in the prior RTTR versions
-        landscapeTerrains =
-          world.GetDescription().terrain.findAll([lt](const TerrainDesc& t) { return t.landscape == lt; });
-    }
     // Alle Weltpunkte
-    MapPoint curPos(0, 0);
-    const unsigned numPlayers = world.GetNumPlayers();
-    for(auto& node : world.nodes)
+    if(sgd.GetGameDataVersion() >= 12)
+        DeserializeNodes(world, sgd);
+    else
     {
-        node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains);
-        if(node.harborId)
+        std::vector<DescIdx<TerrainDesc>> landscapeTerrains;
+        if(sgd.GetGameDataVersion() < 3)
         {
-            HarborPos p(curPos);
-            world.harbor_pos.push_back(p);
+            // Assumes the order of the terrain in the description file is the same as in the prior RTTR versions
+            landscapeTerrains =
+              world.GetDescription().terrain.findAll([lt](const TerrainDesc& t) { return t.landscape == lt; });
         }
-        curPos.x++;
-        if(curPos.x >= world.GetWidth())
+        MapPoint curPos(0, 0);
+        const unsigned numPlayers = world.GetNumPlayers();
+        for(auto& node : world.nodes)
         {
-            curPos.x = 0;
-            curPos.y++;
+            node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains);
+            if(node.harborId)
+            {
+                HarborPos p(curPos);
+                world.harbor_pos.push_back(p);
+            }
+            curPos.x++;
+            if(curPos.x >= world.GetWidth())
+            {
+                curPos.x = 0;
+                curPos.y++;
+            }
         }
     }
 
@@ -14,4 +14,9 @@ class MapSerializer
 public:
     static void Serialize(const GameWorldBase& world, SerializedGameData& sgd);
     static void Deserialize(GameWorldBase& world, SerializedGameData& sgd, Game& game, ILocalGameState& localgameState);
+
+private:
+    /// Write the plain data of all nodes as one plane per field followed by the FoW data and objects of each node
+    static void SerializeNodes(const GameWorldBase& world, SerializedGameData& sgd);
+    static void DeserializeNodes(GameWorldBase& world, SerializedGameData& sgd);
 };
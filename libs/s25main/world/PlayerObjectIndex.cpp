@@ -0,0 +1,167 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/PlayerObjectIndex.h"
+#include "buildings/noBuilding.h"
+#include "helpers/containerUtils.h"
+#include "world/MapBase.h"
+#include "gameData/BuildingProperties.h"
+#include <algorithm>
+#include <cstdlib>
+
+PlayerObjectIndex::PlayerObjectIndex(const MapBase& world) : world_(world), numSquares_(MapExtent::all(0)) {}
+
+void PlayerObjectIndex::Init(const MapExtent& mapSize, const unsigned numPlayers)
+{
+    // Calculate size (rounding up)
+    numSquares_ = (mapSize + MapExtent::all(SQUARE_SIZE - 1)) / SQUARE_SIZE;
+    numPlayers_ = numPlayers;
+    squares_.clear();
+    squares_.resize(numPlayers * NUM_TYPES * prodOfComponents(numSquares_));
+    entries_.assign(prodOfComponents(mapSize), Entry());
+}
+
+void PlayerObjectIndex::Clear()
+{
+    squares_.clear();
+    entries_.clear();
+    numSquares_ = MapExtent::all(0);
+    numPlayers_ = 0;
+}
+
+std::vector<MapPoint>& PlayerObjectIndex::GetSquare(const unsigned player, const Type type, const MapPoint pt)
+{
+    const MapPoint squarePt = pt / SQUARE_SIZE;
+    const unsigned squareIdx = squarePt.y * numSquares_.x + squarePt.x;
+    return squares_[(player * NUM_TYPES + static_cast<unsigned>(type)) * prodOfComponents(numSquares_) + squareIdx];
+}
+
+const std::vector<MapPoint>& PlayerObjectIndex::GetSquare(const unsigned player, const Type type,
+                                                          const unsigned squareIdx) const
+{
+    return squares_[(player * NUM_TYPES + static_cast<unsigned>(type)) * prodOfComponents(numSquares_) + squareIdx];
+}
+
+void PlayerObjectIndex::Update(const MapPoint pt, const noBase* const obj)
+{
+    Entry& entry = entries_[world_.GetIdx(pt)];
+    if(entry.player != NO_PLAYER)
+    {
+        std::vector<MapPoint>& square = GetSquare(entry.player, entry.type, pt);
+        RTTR_Assert(helpers::contains(square, pt));
+        square.erase(helpers::find(square, pt));
+        entry.player = NO_PLAYER;
+    }
+    if(!obj)
+        return;
+    if(obj->GetType() == NodalObjectType::Flag)
+        entry.type = Type::Flag;
+    else if(obj->GetType() == NodalObjectType::Building)
+    {
+        const BuildingType bldType = static_cast<const noBuilding*>(obj)->GetBuildingType();
+        entry.type = BuildingProperties::IsWareHouse(bldType) ? Type::Warehouse : Type::Building;
+    } else
+        return;
+    const unsigned player = static_cast<const noRoadNode*>(obj)->GetPlayer();
+    RTTR_Assert(player < numPlayers_);
+    entry.player = static_cast<uint8_t>(player);
+    GetSquare(player, entry.type, pt).push_back(pt);
+}
+
+std::pair<unsigned, unsigned> PlayerObjectIndex::GetRingPos(const MapPoint center, const MapPoint pt) const
+{
+    const int width = world_.GetWidth();
+    const int height = world_.GetHeight();
+    // Use doubled x coordinates to get rid of the shift of every 2nd row.
+    // Then the neighbours are (+-2, 0) for E/W and (+-1, +-1) for the others
+    int dx = 2 * (pt.x - center.x) + (pt.y & 1) - (center.y & 1);
+    int dy = pt.y - center.y;
+    // Wrap around to the nearest representation. The height is even so the row parity doesn't change
+    if(dx > width)
+        dx -= 2 * width;
+    else if(dx <= -width)
+        dx += 2 * width;
+    if(dy > height / 2)
+        dy -= height;
+    else if(dy <= -height / 2)
+        dy += height;
+
+    const int r = std::abs(dy) + std::max(0, (std::abs(dx) - std::abs(dy)) / 2);
+    if(r == 0)
+        return {0u, 0u};
+    // The ring starts r steps to the west and then goes r steps in each direction starting with NE (clockwise)
+    int ringPos;
+    if(dy <= 0 && dy > -r && dx == -2 * r - dy)
+        ringPos = -dy; // NE
+    else if(dy == -r && dx < r)
+        ringPos = r + (dx + r) / 2; // E
+    else if(dy < 0 && dx - dy == 2 * r)
+        ringPos = 2 * r + (dy + r); // SE
+    else if(dy >= 0 && dy < r && dx + dy == 2 * r)
+        ringPos = 3 * r + dy; // SW
+    else if(dy == r && dx > -r)
+        ringPos = 4 * r + (r - dx) / 2; // W
+    else
+    {
+        RTTR_Assert(dy > 0 && dy - dx == 2 * r);
+        ringPos = 5 * r + (r - dy); // NW
+    }
+    return {static_cast<unsigned>(r), static_cast<unsigned>(ringPos)};
+}
+
+std::vector<MapPoint> PlayerObjectIndex::GetInRadius(const unsigned player, const Type type, const MapPoint pt,
+                                                     const unsigned radius, const unsigned maxResults) const
+{
+    RTTR_Assert(player < numPlayers_);
+    std::vector<MapPoint> result;
+    const MapExtent size = world_.GetSize();
+    // For large radii the points visited by GetPointsInRadius wrap around and might be visited multiple times.
+    // This is rare, so just use the same method then
+    if(radius * 2u >= std::min(size.x, size.y))
+    {
+        result = world_.GetMatchingPointsInRadius(pt, radius, [this, player, type](const MapPoint curPt) {
+            const Entry& entry = entries_[world_.GetIdx(curPt)];
+            return entry.player == player && entry.type == type;
+        });
+        if(maxResults > 0u && result.size() > maxResults)
+            result.resize(maxResults);
+        return result;
+    }
+
+    // Indices of the squares containing the coordinates in [center - radius, center + radius]
+    const auto getSquares = [radius](const int center, const int size) {
+        std::vector<unsigned> squares;
+        for(int coord = center - static_cast<int>(radius); coord <= center + static_cast<int>(radius); coord++)
+        {
+            const unsigned square = static_cast<unsigned>((coord + size) % size) / SQUARE_SIZE;
+            if(!helpers::contains(squares, square))
+                squares.push_back(square);
+        }
+        return squares;
+    };
+    // Collect candidates with their order in GetPointsInRadius
+    std::vector<std::pair<std::pair<unsigned, unsigned>, MapPoint>> candidates;
+    const std::vector<unsigned> squaresX = getSquares(pt.x, size.x);
+    const std::vector<unsigned> squaresY = getSquares(pt.y, size.y);
+    for(const unsigned sy : squaresY)
+    {
+        for(const unsigned sx : squaresX)
+        {
+            for(const MapPoint curPt : GetSquare(player, type, sy * numSquares_.x + sx))
+            {
+                const auto ringPos = GetRingPos(pt, curPt);
+                if(ringPos.first > 0u && ringPos.first <= radius)
+                    candidates.emplace_back(ringPos, curPt);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    if(maxResults > 0u && candidates.size() > maxResults)
+        candidates.resize(maxResults);
+    result.reserve(candidates.size());
+    for(const auto& candidate : candidates)
+        result.push_back(candidate.second);
+    return result;
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/MapCoordinates.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class MapBase;
+class noBase;
+
+/// Spatial index of the flags, warehouses and other finished buildings of each player.
+/// The positions are stored in squares of SQUARE_SIZE x SQUARE_SIZE nodes, so radius queries only need to check the
+/// objects in the squares covered by the radius instead of every node.
+class PlayerObjectIndex
+{
+public:
+    enum class Type : uint8_t
+    {
+        Flag,
+        Warehouse,
+        /// Any other finished building
+        Building
+    };
+
+    explicit PlayerObjectIndex(const MapBase& world);
+
+    void Init(const MapExtent& mapSize, unsigned numPlayers);
+    void Clear();
+    /// Register the object which is now at the point (nullptr for none) replacing the previous one
+    void Update(MapPoint pt, const noBase* obj);
+
+    /// Return the positions of the player's objects of the given type in the radius around pt (excluding pt itself).
+    /// The order is the same as returned by MapBase::GetPointsInRadius, i.e. ordered by distance.
+    /// If maxResults is not 0, only that many (nearest) positions are returned
+    std::vector<MapPoint> GetInRadius(unsigned player, Type type, MapPoint pt, unsigned radius,
+                                      unsigned maxResults = 0) const;
+
+private:
+    static constexpr MapCoord SQUARE_SIZE = 8;
+    static constexpr unsigned NUM_TYPES = 3;
+    static constexpr uint8_t NO_PLAYER = 0xFF;
+
+    struct Entry
+    {
+        uint8_t player = NO_PLAYER;
+        Type type = Type::Flag;
+    };
+
+    std::vector<MapPoint>& GetSquare(unsigned player, Type type, MapPoint pt);
+    const std::vector<MapPoint>& GetSquare(unsigned player, Type type, unsigned squareIdx) const;
+    /// Return the distance from center to pt and the position on the ring of that distance
+    /// in the order used by MapBase::GetPointsInRadius
+    std::pair<unsigned, unsigned> GetRingPos(MapPoint center, MapPoint pt) const;
+
+    const MapBase& world_;
+    MapExtent numSquares_;
+    unsigned numPlayers_ = 0;
+    /// Positions of the objects per player, type and square
+    std::vector<std::vector<MapPoint>> squares_;
+    /// Player and type of the object registered at each node
+    std::vector<Entry> entries_;
+};
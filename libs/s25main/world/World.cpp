@@ -101,12 +101,16 @@ noBase& World::AddFigureImpl(const MapPoint pt, std::unique_ptr<noBase> fig)
 
     noBase& result = *fig;
     figures.push_back(std::move(fig));
+    FigureChanged(pt, result);
     return result;
 }
 
 noBase* World::RemoveFigureImpl(const MapPoint pt, noBase& fig)
 {
-    return helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    noBase* result = helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    if(result)
+        FigureChanged(pt, *result);
+    return result;
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -132,6 +136,7 @@ void World::SetNO(const MapPoint pt, noBase* obj, const bool replace /* = false*
     RTTR_Assert(!dynamic_cast<noMovable*>(obj)); // It should be a static, non-movable object
 #endif
     GetNodeInt(pt).obj = obj;
+    NodeObjectChanged(pt);
 }
 
 void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
@@ -142,6 +147,7 @@ void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
         // Destroy may remove the NO already from the map or replace it (e.g. building -> fire)
         // So remove from map, then destroy and free
         GetNodeInt(pt).obj = nullptr;
+        NodeObjectChanged(pt);
         obj->Destroy();
         deletePtr(obj);
     } else
@@ -165,6 +171,15 @@ void World::ReduceResource(const MapPoint pt)
     GetNodeInt(pt).resources.setAmount(curAmount - 1u);
 }
 
+void World::SetOwner(const MapPoint pt, const unsigned char newOwner)
+{
+    const unsigned char oldOwner = GetNode(pt).owner;
+    if(oldOwner == newOwner)
+        return;
+    GetNodeInt(pt).owner = newOwner;
+    OwnerChanged(pt, oldOwner);
+}
+
 void World::SetReserved(const MapPoint pt, const bool reserved)
 {
     RTTR_Assert(GetNodeInt(pt).reserved != reserved);
@@ -460,6 +475,7 @@ unsigned short World::GetSeaFromCoastalPoint(const MapPoint pt) const
 void World::SetRoad(const MapPoint pt, RoadDir roadDir, PointRoad type)
 {
     GetNodeInt(pt).roads[roadDir] = type;
+    RoadChanged(pt);
 }
 
 bool World::SetBQ(const MapPoint pt, BuildingQuality bq)
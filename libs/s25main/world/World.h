@@ -121,7 +121,7 @@ public:
     GO_Type GetGOT(MapPoint pt) const;
     void ReduceResource(MapPoint pt);
     void SetResource(const MapPoint pt, Resource newResource) { GetNodeInt(pt).resources = newResource; }
-    void SetOwner(const MapPoint pt, unsigned char newOwner) { GetNodeInt(pt).owner = newOwner; }
+    void SetOwner(MapPoint pt, unsigned char newOwner);
     void SetReserved(MapPoint pt, bool reserved);
     /// Sets the visibility and fires a Visibility Changed event if different
     /// fowTime is only used if visibility gets changed to FoW
@@ -240,6 +240,16 @@ protected:
     virtual void AltitudeChanged(MapPoint pt) = 0;
     /// Notify derived classes of changed visibility
     virtual void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) = 0;
+    /// Notify derived classes that the seas and harbor positions were (re-)calculated
+    virtual void SeasChanged() {}
+    /// Notify derived classes that the object at the point was set or removed
+    virtual void NodeObjectChanged(MapPoint) {}
+    /// Notify derived classes that a road starting at the point was set or removed
+    virtual void RoadChanged(MapPoint) {}
+    /// Notify derived classes that the owner of the point was changed
+    virtual void OwnerChanged(MapPoint, unsigned char /*oldOwner*/) {}
+    /// Notify derived classes that the figure was added to or removed from the point
+    virtual void FigureChanged(MapPoint, const noBase&) {}
     /// Sets the road for the given (road) direction
     void SetRoad(MapPoint pt, RoadDir roadDir, PointRoad type);
     BoundaryStones& GetBoundaryStones(const MapPoint pt) { return GetNodeInt(pt).boundary_stones; }
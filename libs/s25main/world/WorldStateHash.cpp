@@ -0,0 +1,130 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/WorldStateHash.h"
+#include "GamePlayer.h"
+#include "RttrForeachPt.h"
+#include "enum_cast.hpp"
+#include "helpers/EnumRange.h"
+#include "world/GameWorldBase.h"
+#include "nodeObjs/noBase.h"
+#include "gameTypes/GO_Type.h"
+#include "gameTypes/Inventory.h"
+
+namespace {
+/// Pseudo-random 64 bit value for the given value (splitmix64 finalizer)
+constexpr uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+constexpr uint64_t mix(uint64_t key, uint64_t value)
+{
+    return mix(mix(key) ^ value);
+}
+/// Key of an element in the given part of the state
+constexpr uint64_t makeKey(WorldStateHash::Part part, unsigned idx)
+{
+    return (uint64_t(part) << 48) | idx;
+}
+uint64_t inventoryKey(unsigned player, bool isJob, unsigned idx)
+{
+    return makeKey(WorldStateHash::Part::Inventories, (player << 16) | (isJob ? 0x8000 : 0) | idx);
+}
+} // namespace
+
+WorldStateHash::WorldStateHash(const GameWorldBase& world) : world_(world)
+{
+    hashes_.fill(0);
+}
+
+void WorldStateHash::recalc()
+{
+    hashes_.fill(0);
+    objectHashes_.assign(prodOfComponents(world_.GetSize()), 0);
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        const unsigned idx = world_.GetIdx(pt);
+        const MapNode& node = world_.GetNode(pt);
+        ownerChanged(pt, 0, node.owner);
+        objectChanged(pt, node.obj);
+        for(const noBase& figure : world_.GetFigures(pt))
+            hash(Part::Figures) ^= figureHash(idx, figure);
+    }
+    for(unsigned player = 0; player < world_.GetNumPlayers(); player++)
+    {
+        const Inventory& inventory = world_.GetPlayer(player).GetInventory();
+        for(const auto good : helpers::enumRange<GoodType>())
+            inventoryChanged(player, good, 0, inventory[good]);
+        for(const auto job : helpers::enumRange<Job>())
+            inventoryChanged(player, job, 0, inventory[job]);
+    }
+}
+
+void WorldStateHash::ownerChanged(const MapPoint pt, const unsigned char oldOwner, const unsigned char newOwner)
+{
+    // No owner doesn't contribute, so the initial hash doesn't depend on the map size
+    const uint64_t key = makeKey(Part::Owners, world_.GetIdx(pt));
+    if(oldOwner)
+        hash(Part::Owners) ^= mix(key, oldOwner);
+    if(newOwner)
+        hash(Part::Owners) ^= mix(key, newOwner);
+}
+
+void WorldStateHash::objectChanged(const MapPoint pt, const noBase* obj)
+{
+    const unsigned idx = world_.GetIdx(pt);
+    // Objects might be set before the first recalc, e.g. while loading the map
+    if(idx >= objectHashes_.size())
+        return;
+    uint64_t& objectHash = objectHashes_[idx];
+    hash(Part::Objects) ^= objectHash;
+    objectHash = WorldStateHash::objectHash(idx, obj);
+    hash(Part::Objects) ^= objectHash;
+}
+
+void WorldStateHash::figureChanged(const MapPoint pt, const noBase& figure)
+{
+    hash(Part::Figures) ^= figureHash(world_.GetIdx(pt), figure);
+}
+
+void WorldStateHash::inventoryChanged(const unsigned player, const GoodType good, const unsigned oldCount,
+                                      const unsigned newCount)
+{
+    const uint64_t key = inventoryKey(player, false, rttr::enum_cast(good));
+    hash(Part::Inventories) ^= mix(key, oldCount) ^ mix(key, newCount);
+}
+
+void WorldStateHash::inventoryChanged(const unsigned player, const Job job, const unsigned oldCount,
+                                      const unsigned newCount)
+{
+    const uint64_t key = inventoryKey(player, true, rttr::enum_cast(job));
+    hash(Part::Inventories) ^= mix(key, oldCount) ^ mix(key, newCount);
+}
+
+const char* WorldStateHash::getName(const Part part)
+{
+    switch(part)
+    {
+        case Part::Owners: return "owners";
+        case Part::Objects: return "objects";
+        case Part::Figures: return "figures";
+        case Part::Inventories: return "inventories";
+    }
+    return "unknown";
+}
+
+uint64_t WorldStateHash::objectHash(const unsigned idx, const noBase* obj)
+{
+    if(!obj)
+        return 0;
+    return mix(makeKey(Part::Objects, idx), (uint64_t(rttr::enum_cast(obj->GetGOT())) << 32) | obj->GetObjId());
+}
+
+uint64_t WorldStateHash::figureHash(const unsigned idx, const noBase& figure)
+{
+    return mix(makeKey(Part::Figures, idx), (uint64_t(rttr::enum_cast(figure.GetGOT())) << 32) | figure.GetObjId());
+}
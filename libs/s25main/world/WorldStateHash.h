@@ -0,0 +1,59 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/GoodTypes.h"
+#include "gameTypes/JobTypes.h"
+#include "gameTypes/MapCoordinates.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class GameWorldBase;
+class noBase;
+
+/// Zobrist-style hash of the world state used to find the cause of asyncs.
+/// Every element of the state (e.g. the owner of a node or a figure on a node) contributes a pseudo-random value
+/// derived from its position and value. The contributions are combined by XOR, so a change is applied in constant
+/// time by removing the old and adding the new contribution. Each part of the state has its own hash so a difference
+/// can be attributed to it.
+class WorldStateHash
+{
+public:
+    enum class Part : uint8_t
+    {
+        Owners,
+        Objects,
+        Figures,
+        Inventories
+    };
+    static constexpr unsigned NUM_PARTS = 4;
+
+    explicit WorldStateHash(const GameWorldBase& world);
+
+    /// Recalculate all hashes from the state, e.g. after the world was loaded
+    void recalc();
+
+    void ownerChanged(MapPoint pt, unsigned char oldOwner, unsigned char newOwner);
+    /// The object at the point was set or removed
+    void objectChanged(MapPoint pt, const noBase* obj);
+    /// The figure was added to or removed from the point
+    void figureChanged(MapPoint pt, const noBase& figure);
+    void inventoryChanged(unsigned player, GoodType good, unsigned oldCount, unsigned newCount);
+    void inventoryChanged(unsigned player, Job job, unsigned oldCount, unsigned newCount);
+
+    uint64_t get(Part part) const { return hashes_[static_cast<unsigned>(part)]; }
+    static const char* getName(Part part);
+
+private:
+    uint64_t& hash(Part part) { return hashes_[static_cast<unsigned>(part)]; }
+    static uint64_t objectHash(unsigned idx, const noBase* obj);
+    static uint64_t figureHash(unsigned idx, const noBase& figure);
+
+    const GameWorldBase& world_;
+    std::array<uint64_t, NUM_PARTS> hashes_;
+    /// Contribution of the object at each node as the object is already replaced when notified
+    std::vector<uint64_t> objectHashes_;
+};
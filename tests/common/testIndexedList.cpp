@@ -0,0 +1,83 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/IndexedList.h"
+#include "rttr/test/random.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(IndexedListSuite)
+
+BOOST_AUTO_TEST_CASE(BehavesLikeList)
+{
+    std::vector<int> values(50);
+    helpers::IndexedList<int*> list;
+    std::list<int*> expected;
+    const auto checkEqual = [&]() {
+        BOOST_TEST_REQUIRE(list.size() == expected.size());
+        BOOST_TEST(list.empty() == expected.empty());
+        BOOST_TEST(std::equal(list.begin(), list.end(), expected.begin()));
+        for(const int& value : values)
+            BOOST_TEST(list.contains(&value) == (std::find(expected.begin(), expected.end(), &value) != expected.end()));
+    };
+    checkEqual();
+    for(int& value : values)
+    {
+        list.push_back(&value);
+        expected.push_back(&value);
+    }
+    checkEqual();
+    BOOST_TEST(list.front() == &values.front());
+
+    // Remove random elements and re-add some
+    for(unsigned i = 0; i < 100; i++)
+    {
+        int* value = &values[rttr::test::randomValue<size_t>(0u, values.size() - 1u)];
+        if(list.contains(value) && rttr::test::randomBool())
+        {
+            list.remove(value);
+            expected.remove(value);
+        } else if(!list.contains(value))
+        {
+            list.push_back(value);
+            expected.push_back(value);
+        }
+        checkEqual();
+    }
+    // Removing a missing element does nothing
+    int missing;
+    list.remove(&missing);
+    checkEqual();
+
+    // Erase every 2nd element while iterating
+    auto itExpected = expected.begin();
+    for(auto it = list.begin(); it != list.end();)
+    {
+        BOOST_TEST_REQUIRE((itExpected != expected.end()));
+        if(std::distance(list.begin(), it) % 2 == 0)
+        {
+            it = list.erase(it);
+            itExpected = expected.erase(itExpected);
+        } else
+        {
+            ++it;
+            ++itExpected;
+        }
+    }
+    checkEqual();
+
+    list.clear();
+    expected.clear();
+    checkEqual();
+    // Can be filled again
+    std::vector<int*> ptrs{&values[3], &values[1]};
+    std::copy(ptrs.begin(), ptrs.end(), std::back_inserter(list));
+    std::copy(ptrs.begin(), ptrs.end(), std::back_inserter(expected));
+    checkEqual();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "StatisticsHistory.h"
+#include "helpers/EnumRange.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+/// Some changing values with large jumps in both directions
+StatisticValues makeValues(unsigned player, unsigned row)
+{
+    StatisticValues values;
+    for(const auto type : helpers::enumRange<StatisticType>())
+        values[type] = (row % 7 == 3) ? 0xFFFFFFFFu - row : player * 1000 + row * static_cast<unsigned>(type);
+    return values;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(StatisticsHistorySuite)
+
+BOOST_AUTO_TEST_CASE(RecordAndRead)
+{
+    rttr::test::TmpFolder tmpFolder;
+    const bfs::path filePath = tmpFolder / "stats.bin";
+    const std::vector<std::string> playerNames = {"Player 1", "\"Quoted\", name"};
+    constexpr unsigned interval = 5;
+    constexpr unsigned numRows = 23;
+    {
+        // Small chunks to test multiple of them
+        StatisticsRecorder recorder(filePath, playerNames, interval, 10);
+        BOOST_TEST(!recorder.isDue(interval * 10 + 1));
+        for(unsigned row = 0; row < numRows; row++)
+        {
+            const unsigned gf = interval * (row + 100);
+            BOOST_TEST_REQUIRE(recorder.isDue(gf));
+            recorder.addRow(gf, {makeValues(0, row), makeValues(1, row)});
+        }
+    }
+
+    const StatisticsReader reader(filePath);
+    BOOST_TEST(reader.getInterval() == interval);
+    BOOST_TEST_REQUIRE(reader.getNumPlayers() == 2u);
+    BOOST_TEST(reader.getPlayerName(0) == playerNames[0]);
+    BOOST_TEST(reader.getPlayerName(1) == playerNames[1]);
+    BOOST_TEST_REQUIRE(reader.getNumRows() == numRows);
+    const std::vector<unsigned> gfs = reader.readGFs();
+    BOOST_TEST_REQUIRE(gfs.size() == numRows);
+    for(unsigned row = 0; row < numRows; row++)
+        BOOST_TEST(gfs[row] == interval * (row + 100));
+    for(unsigned player = 0; player < 2; player++)
+    {
+        for(const auto type : helpers::enumRange<StatisticType>())
+        {
+            BOOST_TEST_INFO_SCOPE("Player " << player << ", " << StatisticsReader::getName(type));
+            const std::vector<uint32_t> column = reader.readColumn(player, type);
+            BOOST_TEST_REQUIRE(column.size() == numRows);
+            for(unsigned row = 0; row < numRows; row++)
+                BOOST_TEST(column[row] == makeValues(player, row)[type]);
+        }
+    }
+
+    std::stringstream csv;
+    reader.exportCsv(csv);
+    std::string line;
+    BOOST_TEST_REQUIRE(std::getline(csv, line).good());
+    BOOST_TEST(line == "gf,player,name,country,buildings,inhabitants,merchandise,military,gold,productivity,vanquished,"
+                       "tournament");
+    BOOST_TEST_REQUIRE(std::getline(csv, line).good());
+    BOOST_TEST(line == "500,0,\"Player 1\",0,0,0,0,0,0,0,0,0");
+    BOOST_TEST_REQUIRE(std::getline(csv, line).good());
+    BOOST_TEST(line == "500,1,\"\"\"Quoted\"\", name\",1000,1000,1000,1000,1000,1000,1000,1000,1000");
+    unsigned numLines = 3;
+    while(std::getline(csv, line))
+        numLines++;
+    BOOST_TEST(numLines == 1 + numRows * 2);
+}
+
+BOOST_AUTO_TEST_CASE(GapsAndIncompleteChunks)
+{
+    rttr::test::TmpFolder tmpFolder;
+    const bfs::path filePath = tmpFolder / "stats.bin";
+    {
+        StatisticsRecorder recorder(filePath, {"P"}, 1);
+        recorder.addRow(0, {makeValues(0, 0)});
+        recorder.addRow(1, {makeValues(0, 1)});
+        // Rows of a loaded game continue later
+        recorder.addRow(50, {makeValues(0, 2)});
+        recorder.flush();
+        recorder.addRow(51, {makeValues(0, 3)});
+    }
+    {
+        const StatisticsReader reader(filePath);
+        BOOST_TEST(reader.readGFs() == std::vector<unsigned>({0, 1, 50, 51}), boost::test_tools::per_element());
+        BOOST_TEST(reader.readColumn(0, StatisticType::Gold)[3] == makeValues(0, 3)[StatisticType::Gold]);
+    }
+    // A chunk cut off when the game crashed is ignored
+    bfs::resize_file(filePath, bfs::file_size(filePath) - 3);
+    const StatisticsReader reader(filePath);
+    BOOST_TEST(reader.readGFs() == std::vector<unsigned>({0, 1, 50}), boost::test_tools::per_element());
+
+    BOOST_CHECK_THROW(StatisticsReader(tmpFolder / "missing.bin"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
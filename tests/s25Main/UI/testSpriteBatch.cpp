@@ -0,0 +1,162 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "PointOutput.h"
+#include "drivers/VideoDriverWrapper.h"
+#include "ogl/IRenderer.h"
+#include "ogl/glSmartBitmap.h"
+#include "uiHelper/uiHelpers.hpp"
+#include <libsiedler2/ArchivItem_Bitmap_Raw.h>
+#include <rttr/test/random.hpp>
+#include <rttr/test/stubFunction.hpp>
+#include <s25util/warningSuppression.h>
+#include <glad/glad.h>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
+
+namespace rttrOglMock3 {
+RTTR_IGNORE_DIAGNOSTIC("-Wmissing-declarations")
+
+const Point<float>* vertexPointer;
+std::vector<Point<float>> vertexCoords;
+std::vector<GLuint> boundTextures;
+GLuint curTexture;
+unsigned numDrawCalls;
+
+void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const void* pointer)
+{
+    vertexPointer = static_cast<const Point<float>*>(pointer);
+}
+
+void APIENTRY glBindTexture(GLenum, GLuint texture)
+{
+    curTexture = texture;
+}
+
+void APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    RTTR_Assert(mode == GL_QUADS);
+    ++numDrawCalls;
+    boundTextures.push_back(curTexture);
+    vertexCoords.insert(vertexCoords.end(), &vertexPointer[first], &vertexPointer[first + count]);
+}
+
+RTTR_POP_DIAGNOSTIC
+} // namespace rttrOglMock3
+
+namespace {
+struct SpriteBatchFixture : uiHelper::Fixture
+{
+    std::unique_ptr<libsiedler2::ArchivItem_Bitmap_Raw> bmp;
+    std::vector<std::unique_ptr<glSmartBitmap>> sprites;
+    IRenderer& renderer;
+
+    SpriteBatchFixture()
+        : bmp(std::make_unique<libsiedler2::ArchivItem_Bitmap_Raw>()), renderer(*VIDEODRIVER.GetRenderer())
+    {
+        bmp->init(10, 10, libsiedler2::TextureFormat::BGRA);
+        rttrOglMock3::vertexCoords.clear();
+        rttrOglMock3::boundTextures.clear();
+        rttrOglMock3::numDrawCalls = 0;
+        // Make sure no other texture is cached as bound
+        VIDEODRIVER.BindTexture(0);
+    }
+
+    glSmartBitmap& addSprite(unsigned texture)
+    {
+        sprites.push_back(std::make_unique<glSmartBitmap>());
+        sprites.back()->add(bmp.get());
+        sprites.back()->setSharedTexture(texture);
+        return *sprites.back();
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SpriteBatchSuite, SpriteBatchFixture)
+
+BOOST_AUTO_TEST_CASE(BatchesSpritesOfSameTexture)
+{
+    RTTR_STUB_FUNCTION(glVertexPointer, rttrOglMock3::glVertexPointer);
+    RTTR_STUB_FUNCTION(glBindTexture, rttrOglMock3::glBindTexture);
+    RTTR_STUB_FUNCTION(glDrawArrays, rttrOglMock3::glDrawArrays);
+
+    const unsigned numSprites = rttr::test::randomValue(2u, 20u);
+    std::vector<DrawPoint> positions;
+    for(unsigned i = 0; i < numSprites; i++)
+    {
+        addSprite(42);
+        positions.push_back(rttr::test::randomPoint<DrawPoint>(-100, 100));
+    }
+
+    // Unbatched: One draw call per sprite
+    for(unsigned i = 0; i < numSprites; i++)
+        sprites[i]->draw(positions[i]);
+    BOOST_TEST(rttrOglMock3::numDrawCalls == numSprites);
+    const auto unbatchedVertices = rttrOglMock3::vertexCoords;
+    BOOST_TEST(unbatchedVertices.size() == numSprites * 4u);
+
+    rttrOglMock3::vertexCoords.clear();
+    rttrOglMock3::boundTextures.clear();
+    rttrOglMock3::numDrawCalls = 0;
+    renderer.ResetSpriteStatistics();
+    renderer.BeginSpriteBatch();
+    for(unsigned i = 0; i < numSprites; i++)
+        sprites[i]->draw(positions[i]);
+    // Nothing drawn yet
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 0u);
+    renderer.EndSpriteBatch();
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 1u);
+    BOOST_TEST(renderer.GetNumSpriteDrawCalls() == 1u);
+    BOOST_TEST(rttrOglMock3::boundTextures == std::vector<GLuint>{42}, boost::test_tools::per_element());
+    // Same geometry as drawing them one by one
+    BOOST_TEST(rttrOglMock3::vertexCoords == unbatchedVertices, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(KeepsDrawOrder)
+{
+    RTTR_STUB_FUNCTION(glVertexPointer, rttrOglMock3::glVertexPointer);
+    RTTR_STUB_FUNCTION(glBindTexture, rttrOglMock3::glBindTexture);
+    RTTR_STUB_FUNCTION(glDrawArrays, rttrOglMock3::glDrawArrays);
+
+    addSprite(1);
+    addSprite(1);
+    addSprite(2);
+    addSprite(1);
+    renderer.BeginSpriteBatch();
+    for(auto& sprite : sprites)
+        sprite->draw(DrawPoint(0, 0));
+    renderer.EndSpriteBatch();
+    // Texture switches break the batch but keep the order
+    const std::vector<GLuint> expectedTextures{1, 2, 1};
+    BOOST_TEST(rttrOglMock3::boundTextures == expectedTextures, boost::test_tools::per_element());
+    BOOST_TEST(rttrOglMock3::vertexCoords.size() == 16u);
+}
+
+BOOST_AUTO_TEST_CASE(FlushAndNesting)
+{
+    RTTR_STUB_FUNCTION(glVertexPointer, rttrOglMock3::glVertexPointer);
+    RTTR_STUB_FUNCTION(glBindTexture, rttrOglMock3::glBindTexture);
+    RTTR_STUB_FUNCTION(glDrawArrays, rttrOglMock3::glDrawArrays);
+
+    glSmartBitmap& sprite = addSprite(1);
+    renderer.BeginSpriteBatch();
+    sprite.draw(DrawPoint(0, 0));
+    renderer.BeginSpriteBatch();
+    sprite.draw(DrawPoint(0, 0));
+    renderer.EndSpriteBatch();
+    // Inner end does not draw
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 0u);
+    renderer.FlushSprites();
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 1u);
+    BOOST_TEST(rttrOglMock3::vertexCoords.size() == 8u);
+    sprite.draw(DrawPoint(0, 0));
+    renderer.EndSpriteBatch();
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 2u);
+    // Nothing pending
+    renderer.FlushSprites();
+    BOOST_TEST(rttrOglMock3::numDrawCalls == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
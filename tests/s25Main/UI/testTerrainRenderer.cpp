@@ -45,3 +45,13 @@ BOOST_AUTO_TEST_CASE(TR_ConvertCoords)
     BOOST_TEST_REQUIRE(tr.ConvertCoords(Position(-10 * w + w / 2, -11 * h + h / 2), &offset) == MapPoint(w / 2, h / 2));
     BOOST_TEST_REQUIRE(offset == Position(-10 * w * TR_W, -11 * h * TR_H));
 }
+
+BOOST_AUTO_TEST_CASE(TR_Chunks)
+{
+    TerrainRenderer tr;
+    tr.Init(MapExtent(23, 32));
+    BOOST_TEST(tr.GetNumChunks() == Extent(1, 1));
+    tr.Init(MapExtent(TerrainRenderer::CHUNK_SIZE * 3 + 1, TerrainRenderer::CHUNK_SIZE * 2));
+    BOOST_TEST(tr.GetNumChunks() == Extent(4, 2));
+    BOOST_TEST(tr.GetNumChangedChunks() == 0u);
+}
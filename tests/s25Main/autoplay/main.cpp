@@ -5,12 +5,15 @@
 #define BOOST_TEST_MODULE RTTR_AutoplayTest
 #include "EventManager.h"
 #include "Game.h"
+#include "GameObjectPool.h"
 #include "GamePlayer.h"
 #include "Replay.h"
 #include "Timer.h"
 #include "helpers/chronoIO.h"
 #include "network/PlayerGameCommands.h"
 #include "ogl/glAllocator.h"
+#include "pathfinding/HumanReachability.h"
+#include "pathfinding/RoadNetworks.h"
 #include "random/Random.h"
 #include "random/randomIO.h"
 #include "variant.h"
@@ -72,6 +75,9 @@ static void playReplay(const boost::filesystem::path& replayPath)
     BOOST_TEST_REQUIRE(loader.Load(mapfile.filePath));
     gameWorld.SetupResources();
     gameWorld.InitAfterLoad();
+    // Check that all skipped warehouse searches would have failed
+    RoadNetworks& roadNetworks = gameWorld.GetRoadNetworks();
+    roadNetworks.setVerify(true);
 
     bool endOfReplay = false;
     auto nextGF = replay.ReadGF();
@@ -107,6 +113,14 @@ static void playReplay(const boost::filesystem::path& replayPath)
     } while(!endOfReplay);
     const auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(timer.getElapsed());
     std::cout << "Replay " << replayPath.filename() << " took " << helpers::withUnit(duration) << std::endl;
+    const HumanReachability& reachability = gameWorld.GetHumanReachability();
+    std::cout << "Human path searches avoided: " << reachability.getNumRejected() << " of "
+              << reachability.getNumQueries() << " (" << reachability.getNumRecalculations()
+              << " full recalculations)" << std::endl;
+    std::cout << "Road searches skipped: " << roadNetworks.getNumUnreachable() << " of "
+              << roadNetworks.getNumQueries() << std::endl;
+    BOOST_TEST(roadNetworks.getNumMismatches() == 0u);
+    GameObjectPool::get().printStatistics(std::cout);
 }
 
 BOOST_AUTO_TEST_CASE(Play200kReplay)
@@ -4,13 +4,19 @@
 
 #include "Game.h"
 #include "PlayerInfo.h"
+#include "helpers/EnumRange.h"
 #include "network/GameClient.h"
 #include "ogl/glAllocator.h"
+#include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/PathConditionShip.h"
 #include "world/MapLoader.h"
 #include "libsiedler2/libsiedler2.h"
 #include <rttr/test/Fixture.hpp>
 #include <benchmark/benchmark.h>
 #include <array>
+#include <limits>
+#include <string>
 #include <test/testConfig.h>
 #include <utility>
 
@@ -36,19 +42,29 @@ static void BM_PathFinding(benchmark::State& state)
     if(!loader.Load(rttr::test::rttrBaseDir / "data/RTTR/MAPS/NEW/AM_FANGDERZEIT.SWD"))
         state.SkipWithError("Map failed to load");
 
-    const auto& curValues = routes[static_cast<size_t>(state.range())];
-    state.SetLabel(std::get<0>(curValues));
+    const auto& curValues = routes[static_cast<size_t>(state.range(0))];
+    // Without requesting the route A* uses the bucket queue instead of the binary heap
+    const bool withRoute = state.range(1) != 0;
+    state.SetLabel(std::string(std::get<0>(curValues)) + (withRoute ? " Route" : " Length"));
     const MapPoint start = std::get<1>(curValues);
     const MapPoint goal = std::get<2>(curValues);
+    const FreePathFinder& pathFinder = world.GetFreePathFinder();
+    const unsigned maxLength = state.range(0) < 6 ? std::numeric_limits<unsigned>::max() : 600;
+    std::vector<Direction> route;
+    unsigned length;
 
     for(auto _ : state)
     {
-        const bool result = state.range() < 6 ? world.FindHumanPath(start, goal).has_value() :
-                                                world.FindShipPath(start, goal, 600, nullptr, nullptr);
+        const bool result =
+          state.range(0) < 6 ? pathFinder.FindPath(start, goal, false, maxLength, withRoute ? &route : nullptr,
+                                                   &length, nullptr, PathConditionHuman(world)) :
+                               pathFinder.FindPath(start, goal, false, maxLength, withRoute ? &route : nullptr,
+                                                   &length, nullptr, PathConditionShip(world));
         benchmark::DoNotOptimize(result);
     }
 }
-BENCHMARK(BM_PathFinding)->DenseRange(0, routes.size() - 1);
+BENCHMARK(BM_PathFinding)
+  ->ArgsProduct({benchmark::CreateDenseRange(0, routes.size() - 1, 1), {0, 1}});
 
 constexpr std::array<std::tuple<const char*, unsigned>, 3> maps = {
   {{"AM_FANGDERZEIT", 7}, {"TueranTuer", 2}, {"Suedameri", 5}}};
@@ -75,4 +91,103 @@ static void BM_BQ_Calculation(benchmark::State& state)
         benchmark::DoNotOptimize(world);
     }
 }
-BENCHMARK(BM_BQ_Calculation)->DenseRange(0, maps.size() - 1);
\ No newline at end of file
+BENCHMARK(BM_BQ_Calculation)->DenseRange(0, maps.size() - 1);
+
+namespace {
+/// Return the point with the longest route from start using a breadth-first search
+template<class T_Condition>
+MapPoint findFarthestPoint(const GameWorld& world, const MapPoint start, const T_Condition& condition)
+{
+    std::vector<bool> visited(prodOfComponents(world.GetSize()));
+    visited[world.GetIdx(start)] = true;
+    std::vector<MapPoint> curLayer{start}, nextLayer;
+    MapPoint farthestPt = start;
+    while(!curLayer.empty())
+    {
+        farthestPt = curLayer.front();
+        for(const MapPoint pt : curLayer)
+        {
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint nb = world.GetNeighbour(pt, dir);
+                if(visited[world.GetIdx(nb)] || !condition.IsNodeOk(nb) || !condition.IsEdgeOk(pt, dir))
+                    continue;
+                visited[world.GetIdx(nb)] = true;
+                nextLayer.push_back(nb);
+            }
+        }
+        std::swap(curLayer, nextLayer);
+        nextLayer.clear();
+    }
+    return farthestPt;
+}
+
+template<class T_Condition>
+void runLongPathFinding(benchmark::State& state, const GameWorld& world, const MapPoint startPt,
+                        const T_Condition& condition)
+{
+    // Roughly the 2 points farthest apart in the area reachable from the start point
+    const MapPoint start = findFarthestPoint(world, startPt, condition);
+    const MapPoint goal = findFarthestPoint(world, start, condition);
+    if(start == goal)
+    {
+        state.SkipWithError("No route found");
+        return;
+    }
+    unsigned length = 0;
+    for(auto _ : state)
+    {
+        const bool result = world.GetFreePathFinder().FindPath(start, goal, false, std::numeric_limits<unsigned>::max(),
+                                                               nullptr, &length, nullptr, condition);
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["Length"] = length;
+}
+} // namespace
+
+/// Long routes across the whole map for humans (arg 1 = 0) and ships (arg 1 = 1)
+static void BM_LongPathFinding(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+
+    const auto& curValues = maps[static_cast<size_t>(state.range(0))];
+    std::vector<PlayerInfo> players(std::get<1>(curValues));
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, players);
+    GameWorld& world = game->world_;
+    MapLoader loader(world);
+
+    const std::string curMap = std::get<0>(curValues);
+    const bool isShip = state.range(1) != 0;
+    state.SetLabel(curMap + (isShip ? " Ship" : " Human"));
+    if(!loader.Load(rttr::test::rttrBaseDir / ("data/RTTR/MAPS/NEW/" + curMap + ".SWD")))
+    {
+        state.SkipWithError(("Map " + curMap + " failed to load").c_str());
+        return;
+    }
+
+    if(!isShip)
+    {
+        const MapPoint hqFlagPos = world.GetNeighbour(loader.GetHQPos(0), Direction::SouthEast);
+        runLongPathFinding(state, world, hqFlagPos, PathConditionHuman(world));
+        return;
+    }
+    for(unsigned hbId = 1; hbId <= world.GetNumHarborPoints(); hbId++)
+    {
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            if(world.GetSeaId(hbId, dir))
+            {
+                const MapPoint coastalPt = world.GetNeighbour(world.GetHarborPoint(hbId), dir);
+                runLongPathFinding(state, world, coastalPt, PathConditionShip(world));
+                return;
+            }
+        }
+    }
+    state.SkipWithError("No harbors");
+}
+BENCHMARK(BM_LongPathFinding)
+  ->ArgsProduct({benchmark::CreateDenseRange(0, maps.size() - 1, 1), {0, 1}})
+  ->Unit(benchmark::kMillisecond);
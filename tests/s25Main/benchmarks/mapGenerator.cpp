@@ -0,0 +1,86 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "lua/GameDataLoader.h"
+#include "mapGenerator/Algorithms.h"
+#include "mapGenerator/RandomMap.h"
+#include "gameData/WorldDescription.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <test/testConfig.h>
+
+using namespace rttr::mapGenerator;
+
+static void BM_GenerateRandomMap(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    MapSettings settings;
+    settings.size = MapExtent::all(static_cast<MapCoord>(state.range(0)));
+    settings.style = static_cast<MapStyle>(state.range(1));
+    settings.numPlayers = 4;
+
+    for(auto _ : state)
+    {
+        // Same seed every time to generate the same map
+        RandomUtility rnd(42);
+        Map map = GenerateRandomMap(rnd, worldDesc, settings);
+        benchmark::DoNotOptimize(map.z);
+    }
+    state.SetItemsProcessed(state.iterations() * prodOfComponents(settings.size));
+}
+BENCHMARK(BM_GenerateRandomMap)
+  ->ArgsProduct({{256, 512, 1024}, {static_cast<int>(MapStyle::Land), static_cast<int>(MapStyle::Mixed)}})
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_SmoothHeightMap(benchmark::State& state)
+{
+    const MapExtent size = MapExtent::all(static_cast<MapCoord>(state.range(0)));
+    RandomUtility rnd(42);
+    NodeMapBase<uint8_t> initialZ;
+    initialZ.Resize(size);
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        initialZ[pt] = rnd.ByChance(5) ? 0xFF : 0;
+    }
+    for(auto _ : state)
+    {
+        NodeMapBase<uint8_t> z = initialZ;
+        SmoothHeightMap(z, ValueRange<uint8_t>(0, 200));
+        benchmark::DoNotOptimize(z);
+    }
+    state.SetItemsProcessed(state.iterations() * prodOfComponents(size));
+}
+BENCHMARK(BM_SmoothHeightMap)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_DistancesTo(benchmark::State& state)
+{
+    const MapExtent size = MapExtent::all(static_cast<MapCoord>(state.range(0)));
+    RandomUtility rnd(42);
+    std::vector<MapPoint> flaggedPoints;
+    for(unsigned i = 0; i < 16; i++)
+        flaggedPoints.push_back(rnd.Point(size));
+    for(auto _ : state)
+    {
+        auto distances = DistancesTo(flaggedPoints, size);
+        benchmark::DoNotOptimize(distances);
+    }
+    state.SetItemsProcessed(state.iterations() * prodOfComponents(size));
+}
+BENCHMARK(BM_DistancesTo)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_Collect(benchmark::State& state)
+{
+    const MapExtent size = MapExtent::all(static_cast<MapCoord>(state.range(0)));
+    NodeMapBase<uint8_t> nodes;
+    nodes.Resize(size, 1);
+    for(auto _ : state)
+    {
+        auto area = Collect(nodes, MapPoint(0, 0), [&nodes](const MapPoint& pt) { return nodes[pt] != 0; });
+        benchmark::DoNotOptimize(area);
+    }
+    state.SetItemsProcessed(state.iterations() * prodOfComponents(size));
+}
+BENCHMARK(BM_Collect)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
@@ -6,6 +6,7 @@
 #include "PlayerInfo.h"
 #include "network/GameClient.h"
 #include "pathfinding/OpenListBinaryHeap.h"
+#include "pathfinding/OpenListBucketQueue.h"
 #include "rttr/test/random.hpp"
 #include "s25util/warningSuppression.h"
 #include <benchmark/benchmark.h>
@@ -21,7 +22,8 @@ struct NodeGetKey
 {
     constexpr auto operator()(const DummyNode& el) const { return el.key; }
 };
-using OpenList = OpenListBinaryHeap<DummyNode, NodeGetKey>;
+using BinaryHeap = OpenListBinaryHeap<DummyNode, NodeGetKey>;
+using BucketQueue = OpenListBucketQueue<DummyNode, NodeGetKey>;
 
 auto getRandomNodes(size_t numElements, unsigned maxValue = 512)
 {
@@ -32,14 +34,17 @@ auto getRandomNodes(size_t numElements, unsigned maxValue = 512)
 }
 } // namespace
 
+template<class T_OpenList>
 static void BM_PushElements(benchmark::State& state)
 {
     const auto numElements = static_cast<size_t>(state.range(0));
+    // Reuse the list like the pathfinders do
+    T_OpenList list;
     for(auto _ : state)
     {
         state.PauseTiming();
         auto nodes = getRandomNodes(numElements);
-        OpenList list;
+        list.clear();
         state.ResumeTiming();
         for(auto& node : nodes)
             list.push(&node);
@@ -47,16 +52,20 @@ static void BM_PushElements(benchmark::State& state)
     }
     state.SetItemsProcessed(state.iterations() * state.range(0));
 }
-BENCHMARK(BM_PushElements)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+BENCHMARK_TEMPLATE(BM_PushElements, BinaryHeap)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+BENCHMARK_TEMPLATE(BM_PushElements, BucketQueue)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
 
+template<class T_OpenList>
 static void BM_PopElements(benchmark::State& state)
 {
     const auto numElements = static_cast<size_t>(state.range(0));
+    // Reuse the list like the pathfinders do
+    T_OpenList list;
     for(auto _ : state)
     {
         state.PauseTiming();
         auto nodes = getRandomNodes(numElements);
-        OpenList list;
+        list.clear();
         for(auto& node : nodes)
             list.push(&node);
         benchmark::DoNotOptimize(list);
@@ -70,17 +79,21 @@ static void BM_PopElements(benchmark::State& state)
     }
     state.SetItemsProcessed(state.iterations() * state.range(0));
 }
-BENCHMARK(BM_PopElements)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+BENCHMARK_TEMPLATE(BM_PopElements, BinaryHeap)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+BENCHMARK_TEMPLATE(BM_PopElements, BucketQueue)->Arg(3)->Arg(5)->Arg(7)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
 
+template<class T_OpenList>
 static void BM_PushPopElements(benchmark::State& state)
 {
     const auto numElements = static_cast<size_t>(state.range(0));
     const auto numOperations = static_cast<size_t>(state.range(1));
+    // Reuse the list like the pathfinders do
+    T_OpenList list;
     for(auto _ : state)
     {
         state.PauseTiming();
         auto nodes = getRandomNodes(numElements, numElements / 3u); // Force duplicates
-        OpenList list;
+        list.clear();
         for(auto& node : nodes)
             list.push(&node);
         benchmark::DoNotOptimize(list);
@@ -97,4 +110,7 @@ static void BM_PushPopElements(benchmark::State& state)
     }
     state.SetItemsProcessed(state.iterations() * numOperations * 2);
 }
-BENCHMARK(BM_PushPopElements)->ArgsProduct({{3, 5, 7, 10, 20, 30, 40, 70}, {5, 7, 15, 20, 50, 200, 600}});
+BENCHMARK_TEMPLATE(BM_PushPopElements, BinaryHeap)
+  ->ArgsProduct({{3, 5, 7, 10, 20, 30, 40, 70}, {5, 7, 15, 20, 50, 200, 600}});
+BENCHMARK_TEMPLATE(BM_PushPopElements, BucketQueue)
+  ->ArgsProduct({{3, 5, 7, 10, 20, 30, 40, 70}, {5, 7, 15, 20, 50, 200, 600}});
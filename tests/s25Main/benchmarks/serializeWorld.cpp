@@ -0,0 +1,101 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "ILocalGameState.h"
+#include "PlayerInfo.h"
+#include "SerializedGameData.h"
+#include "lua/GameDataLoader.h"
+#include "mapGenerator/RandomMap.h"
+#include "ogl/glAllocator.h"
+#include "world/MapLoader.h"
+#include "gameData/WorldDescription.h"
+#include "libsiedler2/Archiv.h"
+#include "libsiedler2/ArchivItem_Map.h"
+#include "libsiedler2/libsiedler2.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+struct LocalGameState : ILocalGameState
+{
+    unsigned GetPlayerId() const override { return 0; }
+    bool IsHost() const override { return true; }
+    std::string FormatGFTime(unsigned) const override { return ""; }
+    void SystemChat(const std::string&) override {}
+};
+
+std::vector<PlayerInfo> createPlayers()
+{
+    std::vector<PlayerInfo> players(2);
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    return players;
+}
+
+/// Create a game on a generated 1024x1024 map
+std::shared_ptr<Game> loadGame(benchmark::State& state)
+{
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    rttr::mapGenerator::MapSettings settings;
+    settings.size = MapExtent::all(1024);
+    // Same seed every time to generate the same map
+    rttr::mapGenerator::RandomUtility rnd(42);
+    libsiedler2::Archiv archiv = rttr::mapGenerator::GenerateRandomMap(rnd, worldDesc, settings).CreateArchiv();
+
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, createPlayers());
+    MapLoader loader(game->world_);
+    const auto& map = *static_cast<libsiedler2::ArchivItem_Map*>(archiv[0]);
+    if(!loader.Load(map, game->world_.GetGGS().exploration) || !loader.PlaceHQs(false))
+        state.SkipWithError("Map failed to load");
+    return game;
+}
+} // namespace
+
+/// Snapshot of a game on a big map, dominated by the nodes of the map
+static void BM_SaveWorld(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+    const auto game = loadGame(state);
+    unsigned length = 0;
+    for(auto _ : state)
+    {
+        SerializedGameData sgd;
+        sgd.MakeSnapshot(*game);
+        benchmark::DoNotOptimize(sgd.GetData());
+        length = sgd.GetLength();
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_SaveWorld);
+
+static void BM_LoadWorld(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+    const auto savedGame = loadGame(state);
+    LocalGameState localGameState;
+    unsigned length = 0;
+    for(auto _ : state)
+    {
+        // Reading consumes the snapshot, so take a new one for every iteration
+        state.PauseTiming();
+        SerializedGameData sgd;
+        sgd.MakeSnapshot(*savedGame);
+        length = sgd.GetLength();
+        auto game = std::make_shared<Game>(GlobalGameSettings(), 0, createPlayers());
+        state.ResumeTiming();
+        sgd.ReadSnapshot(*game, localGameState);
+        state.PauseTiming();
+        game.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_LoadWorld);
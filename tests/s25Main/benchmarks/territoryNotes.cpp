@@ -0,0 +1,67 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "ai/aijh/AIPlayerJH.h"
+#include "notifications/NodeNote.h"
+#include "ogl/glAllocator.h"
+#include "world/MapLoader.h"
+#include "libsiedler2/libsiedler2.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <test/testConfig.h>
+#include <vector>
+
+/// Notifications sent for a territory change, i.e. an owner and a BQ note for every node of the changed area
+/// received by the AI and another subscriber, either published one by one or as a batch
+static void BM_TerritoryNotes(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+
+    std::vector<PlayerInfo> players(2);
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, players);
+    GameWorld& world = game->world_;
+    MapLoader loader(world);
+    if(!loader.Load(rttr::test::rttrBaseDir / "data/RTTR/MAPS/NEW/AM_FANGDERZEIT.SWD"))
+        state.SkipWithError("Map failed to load");
+
+    // Territory of a large military building
+    const auto areaSize = static_cast<MapCoord>(state.range(0));
+    const bool batched = state.range(1) != 0;
+    state.SetLabel(batched ? "Batched" : "Single");
+    const Position origin(10, 10);
+    NotificationManager& notifications = world.GetNotifications();
+    std::vector<MapPoint> bqsToUpdate;
+    const Subscription aiSub = AIJH::recordBQsToUpdate(world, bqsToUpdate);
+    unsigned numNotes = 0;
+    const Subscription countSub = notifications.subscribeBatch<NodeNote>(
+      [&numNotes](const std::vector<NodeNote>& notes) { numNotes += notes.size(); });
+
+    const auto publishNotes = [&]() {
+        RTTR_FOREACH_PT(MapPoint, MapExtent::all(areaSize))
+        {
+            const MapPoint curPt = world.MakeMapPoint(Position(pt) + origin);
+            notifications.publish(NodeNote(NodeNote::Owner, curPt));
+            notifications.publish(NodeNote(NodeNote::BQ, curPt));
+        }
+    };
+    for(auto _ : state)
+    {
+        if(batched)
+        {
+            NotificationManager::Batch<NodeNote> batch(notifications);
+            publishNotes();
+        } else
+            publishNotes();
+        benchmark::DoNotOptimize(bqsToUpdate.data());
+        bqsToUpdate.clear();
+    }
+    state.counters["notes"] = benchmark::Counter(numNotes, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TerritoryNotes)->ArgsProduct({{16, 32, 64}, {0, 1}});
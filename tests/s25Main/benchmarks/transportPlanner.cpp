@@ -0,0 +1,106 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "Replay.h"
+#include "addons/const_addons.h"
+#include "network/PlayerGameCommands.h"
+#include "random/Random.h"
+#include "variant.h"
+#include "world/GameWorld.h"
+#include "world/MapLoader.h"
+#include "gameTypes/MapInfo.h"
+#include "gameData/GameConsts.h"
+#include "s25util/tmpFile.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <test/testConfig.h>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+/// Number of GFs to run from the start of the replay
+constexpr unsigned NUM_GFS = 30000;
+
+unsigned getNumGoods(const GameWorld& world)
+{
+    unsigned result = 0;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+    {
+        const GamePlayer& player = world.GetPlayer(i);
+        if(player.isUsed())
+        {
+            const auto& goods = player.GetInventory().goods;
+            result = std::accumulate(goods.begin(), goods.end(), result);
+        }
+    }
+    return result;
+}
+
+/// Run the start of the 200k GF replay (7 AIs) with the transport planner setting given as the argument.
+/// The commands of the replay are executed even though the game diverges from the recorded one once the planner is
+/// enabled, so the AIs still build their economies.
+/// Reports the goods gained per (game) minute as the throughput of the economy
+void BM_TransportPlanner(benchmark::State& state)
+{
+    rttr::test::Fixture fixture;
+    const boost::filesystem::path replayPath = rttr::test::rttrBaseDir / "tests" / "testData" / "200kGFs.rpl";
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        Replay replay;
+        MapInfo mapInfo;
+        if(!replay.LoadHeader(replayPath) || !replay.LoadGameData(mapInfo))
+            throw std::runtime_error("Could not load replay");
+        TmpFile mapfile;
+        mapfile.close();
+        if(!mapInfo.mapData.DecompressToFile(mapfile.filePath))
+            throw std::runtime_error("Could not decompress map");
+        std::vector<PlayerInfo> players;
+        for(unsigned i = 0; i < replay.GetNumPlayers(); i++)
+            players.emplace_back(replay.GetPlayer(i));
+        replay.ggs.setSelection(AddonId::TRANSPORT_PLANNER, static_cast<unsigned>(state.range(0)));
+        Game game(replay.ggs, /*startGF*/ 0, players);
+        RANDOM.Init(replay.getSeed());
+        GameWorld& world = game.world_;
+        for(unsigned i = 0; i < world.GetNumPlayers(); ++i)
+            world.GetPlayer(i).MakeStartPacts();
+        MapLoader loader(world);
+        if(!loader.Load(mapfile.filePath))
+            throw std::runtime_error("Could not load map");
+        world.SetupResources();
+        world.InitAfterLoad();
+        const unsigned startGoods = getNumGoods(world);
+        auto nextGF = replay.ReadGF();
+        state.ResumeTiming();
+
+        for(unsigned gf = 0; gf < NUM_GFS; gf++)
+        {
+            while(nextGF && *nextGF == game.em_->GetCurrentGF())
+            {
+                const auto cmd = replay.ReadCommand();
+                if(const auto* gameCmd = get_if<Replay::GameCommand>(&cmd))
+                {
+                    for(const gc::GameCommandPtr& gc : gameCmd->cmds.gcs)
+                        gc->Execute(world, gameCmd->player);
+                }
+                nextGF = replay.ReadGF();
+            }
+            game.RunGF();
+        }
+
+        state.PauseTiming();
+        const auto gameTime = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<60>>>(
+          NUM_GFS * SPEED_GF_LENGTHS[referenceSpeed]);
+        state.counters["goods_per_min"] =
+          (static_cast<double>(getNumGoods(world)) - static_cast<double>(startGoods)) / gameTime.count();
+        state.ResumeTiming();
+    }
+}
+} // namespace
+
+BENCHMARK(BM_TransportPlanner)->DenseRange(0, 3)->Iterations(1)->Unit(benchmark::kSecond);
@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "PointOutput.h"
+#include "TerrainRenderer.h"
 #include "uiHelper/uiHelpers.hpp"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/terrainHelpers.h"
 #include "world/GameWorldView.h"
 #include "world/GameWorldViewer.h"
 #include "gameData/MapConsts.h"
@@ -107,4 +109,23 @@ BOOST_FIXTURE_TEST_CASE(GetsCorrectMaxHeight, EmptyWorldFixture1P)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(CalculatesWaterPercentageOfVisibleNodes, EmptyWorldFixture1P)
+{
+    BOOST_TEST(TerrainRenderer::GetWaterPercentage(Position(0, 0), Position(3, 3), world) == 0u);
+
+    const DescIdx<TerrainDesc> water = GetWaterTerrain(world.GetDescription());
+    for(const MapPoint pt : {MapPoint(2, 2), MapPoint(3, 2), MapPoint(2, 3), MapPoint(3, 3)})
+    {
+        MapNode& node = world.GetNodeWriteable(pt);
+        node.t1 = node.t2 = water;
+    }
+    // 8 of 32 triangles
+    BOOST_TEST(TerrainRenderer::GetWaterPercentage(Position(0, 0), Position(3, 3), world) == 25u);
+    BOOST_TEST(TerrainRenderer::GetWaterPercentage(Position(2, 2), Position(3, 3), world) == 100u);
+    // Wrapping around the map border, only (2, 2) is water: 2 of 32 triangles
+    BOOST_TEST(TerrainRenderer::GetWaterPercentage(Position(-1, -1), Position(2, 2), world) == 6u);
+    // Water outside the view but in the same drawing chunk does not count
+    BOOST_TEST(TerrainRenderer::GetWaterPercentage(Position(6, 6), Position(9, 9), world) == 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "IngameMinimap.h"
+#include "RectOutput.h"
+#include "RttrForeachPt.h"
+#include "uiHelper/uiHelpers.hpp"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/WorldFixture.h"
+#include "world/GameWorldViewer.h"
+#include <rttr/test/stubFunction.hpp>
+#include <s25util/warningSuppression.h>
+#include <glad/glad.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace rttrOglMock4 {
+RTTR_IGNORE_DIAGNOSTIC("-Wmissing-declarations")
+
+std::vector<Rect> uploadedRects;
+
+void APIENTRY glTexSubImage2D(GLenum, GLint, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum,
+                              GLenum, const void*)
+{
+    uploadedRects.emplace_back(xoffset, yoffset, width, height);
+}
+
+RTTR_POP_DIAGNOSTIC
+} // namespace rttrOglMock4
+
+BOOST_AUTO_TEST_SUITE(IngameMinimapTests)
+
+namespace {
+using EmptyWorldFixture1P = WorldFixture<CreateEmptyWorld, 1, 64, 64>;
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(UploadsOnlyDirtyRects, EmptyWorldFixture1P)
+{
+    uiHelper::initGUITests();
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    GameWorldViewer gwv(0, world);
+    IngameMinimap minimap(gwv);
+    const Rect drawRect(0, 0, 100, 100);
+    // Create the texture
+    minimap.Draw(drawRect);
+    rttrOglMock4::uploadedRects.clear();
+
+    // Nodes in the same tile are combined
+    minimap.UpdateNode(MapPoint(1, 1));
+    minimap.UpdateNode(MapPoint(3, 2));
+    minimap.UpdateNode(MapPoint(3, 2));
+    minimap.UpdateNode(MapPoint(40, 40));
+    BOOST_TEST(minimap.GetNumDirtyRects() == 2u);
+    minimap.Draw(drawRect);
+    BOOST_TEST(minimap.GetNumDirtyRects() == 0u);
+    // 2 pixels per node, odd rows shifted by 1 pixel
+    const std::vector<Rect> expectedRects{Rect(2, 1, 7, 2), Rect(80, 40, 2, 1)};
+    BOOST_TEST(rttrOglMock4::uploadedRects == expectedRects, boost::test_tools::per_element());
+
+    // Nothing changed -> No upload
+    rttrOglMock4::uploadedRects.clear();
+    minimap.Draw(drawRect);
+    BOOST_TEST(rttrOglMock4::uploadedRects.empty());
+
+    // Repeated updates of the same node count once and don't cause a full recreation
+    for(unsigned i = 0; i < prodOfComponents(world.GetSize()); i++)
+        minimap.UpdateNode(MapPoint(6, 6));
+    minimap.Draw(drawRect);
+    const std::vector<Rect> expectedSingleRect{Rect(12, 6, 2, 1)};
+    BOOST_TEST(rttrOglMock4::uploadedRects == expectedSingleRect, boost::test_tools::per_element());
+
+    // Too many nodes -> Full recreation instead of partial uploads
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        minimap.UpdateNode(pt);
+    }
+    minimap.Draw(drawRect);
+    BOOST_TEST(minimap.GetNumDirtyRects() == 0u);
+    BOOST_TEST(rttrOglMock4::uploadedRects.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(TogglesRecompositeLayers, EmptyWorldFixture1P)
+{
+    uiHelper::initGUITests();
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    GameWorldViewer gwv(0, world);
+    IngameMinimap minimap(gwv);
+    minimap.Draw(Rect(0, 0, 100, 100));
+    rttrOglMock4::uploadedRects.clear();
+
+    // Only the HQ is affected
+    minimap.ToggleHouses();
+    BOOST_TEST_REQUIRE(rttrOglMock4::uploadedRects.size() == 1u);
+    const Rect hqRect = rttrOglMock4::uploadedRects[0];
+    BOOST_TEST(hqRect.getSize().x <= 3u);
+    minimap.ToggleHouses();
+    BOOST_TEST_REQUIRE(rttrOglMock4::uploadedRects.size() == 2u);
+    BOOST_TEST(rttrOglMock4::uploadedRects[1] == hqRect);
+
+    // No roads at all
+    minimap.ToggleRoads();
+    BOOST_TEST(rttrOglMock4::uploadedRects.size() == 2u);
+    minimap.ToggleRoads();
+
+    // Territory is everywhere around the HQ
+    minimap.ToggleTerritory();
+    BOOST_TEST_REQUIRE(rttrOglMock4::uploadedRects.size() == 3u);
+    BOOST_TEST(rttrOglMock4::uploadedRects[2].getSize().x > hqRect.getSize().x);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
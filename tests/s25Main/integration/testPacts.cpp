@@ -261,4 +261,31 @@ BOOST_FIXTURE_TEST_CASE(SuggestNewPactAfterExpiration, PactCreatedFixture,
     CheckPactState(world, 1, 2, PactType::NonAgressionPact, PactState::Accepted);
 }
 
+BOOST_FIXTURE_TEST_CASE(ExpiredPactsFoundByBothPlayers, PactCreatedFixture,
+                        *utf::depends_on("PactTestSuite/MakePactTest"))
+{
+    GamePlayer& player1 = world.GetPlayer(1);
+    GamePlayer& player2 = world.GetPlayer(2);
+    for(unsigned i = 0; i < duration; i++)
+    {
+        BOOST_TEST_REQUIRE(player1.FindExpiredPacts().empty());
+        em.ExecuteNextGF();
+    }
+    // Both players find the expired pact before any of them cancels it
+    const std::vector<GamePlayer::ExpiredPact> expired1 = player1.FindExpiredPacts();
+    const std::vector<GamePlayer::ExpiredPact> expired2 = player2.FindExpiredPacts();
+    BOOST_TEST_REQUIRE(expired1.size() == 1u);
+    BOOST_TEST(expired1[0].otherPlayer == 2u);
+    BOOST_TEST(expired1[0].pact == PactType::NonAgressionPact);
+    BOOST_TEST_REQUIRE(expired2.size() == 1u);
+    BOOST_TEST(expired2[0].otherPlayer == 1u);
+    BOOST_TEST(world.GetPlayer(0).FindExpiredPacts().empty());
+    // Only the first one cancels it
+    player1.CancelExpiredPacts(expired1);
+    CheckPactState(world, 1, 2, PactType::NonAgressionPact, PactState::None);
+    player2.CancelExpiredPacts(expired2);
+    CheckPactState(world, 1, 2, PactType::NonAgressionPact, PactState::None);
+    BOOST_TEST(player2.FindExpiredPacts().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
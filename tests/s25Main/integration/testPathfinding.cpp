@@ -2,17 +2,32 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "FindWhConditions.h"
+#include "GamePlayer.h"
+#include "PointOutput.h"
 #include "RttrForeachPt.h"
 #include "helpers/OptionalIO.h"
+#include "helpers/containerUtils.h"
+#include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/HumanReachability.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "pathfinding/RehomingCache.h"
+#include "pathfinding/RoadNetworks.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/WorldWithGCExecution.h"
 #include "worldFixtures/terrainHelpers.h"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noGranite.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameData/GameConsts.h"
+#include <rttr/test/random.hpp>
 #include <rttr/test/testHelpers.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/test/unit_test.hpp>
+#include <limits>
+#include <thread>
 #include <vector>
 
 // Tests are designed to check for every possible direction and terrain distribution
@@ -247,11 +262,317 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     std::vector<MapPoint> surroundingPts2;
     for(unsigned i = 0; i < 12; i++)
         surroundingPts2.push_back(world.GetNeighbour2(startPt, i));
+    const HumanReachability& reachability = world.GetHumanReachability();
+    const uint64_t numRejected = reachability.getNumRejected();
     for(const MapPoint& pt : surroundingPts2)
         BOOST_TEST_REQUIRE(!world.FindHumanPath(startPt, pt));
+    // Detected without searching
+    BOOST_TEST(reachability.getNumRejected() == numRejected + surroundingPts2.size());
     // Allow left exit
     world.DestroyNO(surroundingPts[0]);
     BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, surroundingPts2[0]));
 }
 
+BOOST_FIXTURE_TEST_CASE(LengthQueriesFindShortestRoutes, WorldFixtureEmpty0P)
+{
+    // Random obstacles: Granite and water
+    const DescIdx<TerrainDesc> tWater = GetWaterTerrain(world.GetDescription());
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(rttr::test::randomValue(0, 5) == 0)
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+        else if(rttr::test::randomValue(0, 3) == 0)
+            world.GetNodeWriteable(pt).t1 = tWater;
+    }
+
+    const FreePathFinder& pathFinder = world.GetFreePathFinder();
+    const PathConditionHuman condition(world);
+    unsigned numRoutes = 0;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        const MapPoint dest = world.MakeMapPoint(pt + rttr::test::randomPoint<Position>(-6, 6));
+        if(dest == pt)
+            continue;
+        BOOST_TEST_INFO("From " << pt << " to " << dest);
+        const bool randomRoute = rttr::test::randomBool();
+        const unsigned maxLength = rttr::test::randomValue(5u, 20u);
+        // Without a route a different open list is used
+        unsigned length = 0;
+        const bool routeFound =
+          pathFinder.FindPath(pt, dest, randomRoute, maxLength, nullptr, &length, nullptr, condition);
+        std::vector<Direction> route;
+        BOOST_TEST_REQUIRE(pathFinder.FindPath(pt, dest, randomRoute, maxLength, &route, nullptr, nullptr, condition)
+                           == routeFound);
+        if(!routeFound)
+            continue;
+        numRoutes++;
+        BOOST_TEST(route.size() == length);
+    }
+    BOOST_TEST(numRoutes > 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReachabilityRejectsOnlyUnconnectedPoints, WorldFixtureEmpty0P)
+{
+    const DescIdx<TerrainDesc> tWater = GetWaterTerrain(world.GetDescription());
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(rttr::test::randomValue(0, 3) == 0)
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+        else if(rttr::test::randomValue(0, 5) == 0)
+            world.GetNodeWriteable(pt).t1 = tWater;
+    }
+
+    const HumanReachability& reachability = world.GetHumanReachability();
+    const FreePathFinder& pathFinder = world.GetFreePathFinder();
+    const PathConditionHuman condition(world);
+    for(unsigned i = 0; i < 500; i++)
+    {
+        // Add or remove an obstacle which might connect or separate areas
+        const MapPoint pt = world.MakeMapPoint(rttr::test::randomPoint<Position>(0, 1000));
+        if(world.GetNode(pt).obj)
+            world.DestroyNO(pt);
+        else
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+
+        const MapPoint start = world.MakeMapPoint(rttr::test::randomPoint<Position>(0, 1000));
+        const MapPoint dest = world.MakeMapPoint(rttr::test::randomPoint<Position>(0, 1000));
+        BOOST_TEST_INFO("From " << start << " to " << dest);
+        const bool pathExists = pathFinder.FindPath(start, dest, false, std::numeric_limits<unsigned>::max(), nullptr,
+                                                    nullptr, nullptr, condition);
+        if(pathExists)
+            BOOST_TEST_REQUIRE(reachability.mayBeReachable(start, dest));
+        BOOST_TEST_REQUIRE((world.FindHumanPath(start, dest) != boost::none) == pathExists);
+    }
+    BOOST_TEST(reachability.getNumQueries() > 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(RehomingCacheFindsSameHumanPaths, WorldFixtureEmpty0P)
+{
+    const DescIdx<TerrainDesc> tWater = GetWaterTerrain(world.GetDescription());
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(rttr::test::randomValue(0, 3) == 0)
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+        else if(rttr::test::randomValue(0, 5) == 0)
+            world.GetNodeWriteable(pt).t1 = tWater;
+    }
+
+    const RehomingCache& cache = world.GetRehomingCache();
+    for(unsigned i = 0; i < 20; i++)
+    {
+        const MapPoint start = world.MakeMapPoint(rttr::test::randomPoint<Position>(0, 1000));
+        const unsigned maxLength = rttr::test::randomValue(1u, 12u);
+        const unsigned numFloods = cache.getNumHumanFloods();
+        for(const MapPoint dest : world.GetPointsInRadius(start, maxLength + 2))
+        {
+            BOOST_TEST_INFO("From " << start << " to " << dest << " max " << maxLength);
+            unsigned expectedLength = 0, length = 0;
+            const bool pathExists = world.FindHumanPath(start, dest, maxLength, false, &expectedLength) != boost::none;
+            BOOST_TEST_REQUIRE(cache.findHumanPath(start, dest, maxLength, &length) == pathExists);
+            if(pathExists)
+                BOOST_TEST_REQUIRE(length == expectedLength);
+        }
+        // All searches from the same point are done at once
+        BOOST_TEST(cache.getNumHumanFloods() <= numFloods + 1u);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(RehomingCacheFindsSameWarehouses, WorldWithGCExecution1P)
+{
+    const GamePlayer& player = world.GetPlayer(curPlayer);
+    const RehomingCache& cache = world.GetRehomingCache();
+    // Returns the number of flags and jobs for which a warehouse was found
+    const auto checkFlags = [&]() {
+        unsigned numFound = 0;
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            const auto* flag = world.GetSpecObj<noFlag>(pt);
+            if(!flag)
+                continue;
+            for(const Job job : {Job::Helper, Job::Woodcutter})
+            {
+                BOOST_TEST_INFO("Flag " << pt << " job " << job);
+                const bool expected = player.FindWarehouse(*flag, FW::AcceptsFigure(job), true, false) != nullptr;
+                BOOST_TEST(cache.hasWarehouseFor(curPlayer, *flag, job) == expected);
+                numFound += expected ? 1 : 0;
+            }
+        }
+        return numFound;
+    };
+
+    // HQ flag connected to another flag and 2 unconnected flags next to it
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint flagPos = world.MakeMapPoint(hqFlagPos + Position(2, 0));
+    const MapPoint unconnectedFlagPos = world.MakeMapPoint(flagPos + Position(2, 0));
+    this->BuildRoad(hqFlagPos, false, std::vector<Direction>(2, Direction::East));
+    this->SetFlag(unconnectedFlagPos);
+    this->BuildRoad(unconnectedFlagPos, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST(checkFlags() == 4u);
+
+    this->SetInventorySetting(hqPos, Job::Woodcutter, EInventorySetting::Stop);
+    BOOST_TEST(checkFlags() == 2u);
+
+    this->BuildRoad(flagPos, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST(checkFlags() == 4u);
+
+    this->DestroyRoad(hqFlagPos, Direction::East);
+    BOOST_TEST(checkFlags() == 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadNetworksOnlySkipUnreachableSearches, WorldWithGCExecution1P)
+{
+    const RoadNetworks& networks = world.GetRoadNetworks();
+    const RoadPathFinder& roadPF = world.GetRoadPathFinder();
+    // Returns the number of node pairs for which the search is skipped
+    const auto checkNodes = [&]() {
+        std::vector<const noRoadNode*> nodes;
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            if(world.GetSpecObj<noRoadNode>(pt))
+                nodes.push_back(world.GetSpecObj<noRoadNode>(pt));
+        }
+        unsigned numUnreachable = 0;
+        for(const noRoadNode* start : nodes)
+        {
+            for(const noRoadNode* goal : nodes)
+            {
+                if(start == goal)
+                    continue;
+                BOOST_TEST_INFO("From " << start->GetPos() << " to " << goal->GetPos());
+                const bool found = roadPF.PathExists(*start, *goal, true);
+                if(networks.isUnreachable(*start, *goal))
+                {
+                    BOOST_TEST(!found);
+                    numUnreachable++;
+                }
+            }
+        }
+        return numUnreachable;
+    };
+
+    // HQ flag connected to another flag and a woodcutter at an unconnected road next to it
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint flagPos = world.MakeMapPoint(hqFlagPos + Position(2, 0));
+    const MapPoint unconnectedFlagPos = world.MakeMapPoint(flagPos + Position(2, 0));
+    this->BuildRoad(hqFlagPos, false, std::vector<Direction>(2, Direction::East));
+    this->SetFlag(unconnectedFlagPos);
+    this->BuildRoad(unconnectedFlagPos, false, std::vector<Direction>(2, Direction::East));
+    const MapPoint endFlagPos = world.MakeMapPoint(unconnectedFlagPos + Position(2, 0));
+    this->SetBuildingSite(world.GetNeighbour(endFlagPos, Direction::NorthWest), BuildingType::Woodcutter);
+    // 3 nodes (HQ and 2 flags) and 3 nodes (2 flags and the site)
+    BOOST_TEST(checkNodes() == 2u * 3u * 3u);
+    const GamePlayer& player = world.GetPlayer(curPlayer);
+    const auto* site = world.GetSpecObj<noRoadNode>(world.GetNeighbour(endFlagPos, Direction::NorthWest));
+    BOOST_TEST_REQUIRE(site);
+    BOOST_TEST(!player.FindWarehouse(*site, FW::NoCondition(), false, false));
+
+    this->BuildRoad(flagPos, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST(checkNodes() == 0u);
+    BOOST_TEST(player.FindWarehouse(*site, FW::NoCondition(), false, false));
+
+    this->DestroyRoad(flagPos, Direction::East);
+    BOOST_TEST(checkNodes() == 2u * 3u * 3u);
+    BOOST_TEST(!player.FindWarehouse(*site, FW::NoCondition(), false, false));
+}
+
+namespace {
+struct PathQueryResult
+{
+    helpers::OptionalEnum<Direction> humanDir;
+    unsigned humanLength = 0;
+    bool roadPathExists = false;
+    unsigned roadLength = 0;
+    RoadPathDirection roadDir = RoadPathDirection::None;
+    MapPoint roadFirstPt;
+
+    bool operator==(const PathQueryResult& rhs) const
+    {
+        return humanDir == rhs.humanDir && humanLength == rhs.humanLength && roadPathExists == rhs.roadPathExists
+               && roadLength == rhs.roadLength && roadDir == rhs.roadDir && roadFirstPt == rhs.roadFirstPt;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(ConcurrentQueries, WorldWithGCExecution1P)
+{
+    // Line of flags connected by roads starting at the HQ flag
+    std::vector<const noRoadNode*> flags;
+    MapPoint flagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    flags.push_back(world.GetSpecObj<noFlag>(flagPos));
+    for(unsigned i = 0; i < 2; i++)
+    {
+        this->BuildRoad(flagPos, false, std::vector<Direction>(2, Direction::East));
+        flagPos = world.MakeMapPoint(flagPos + Position(2, 0));
+        flags.push_back(world.GetSpecObj<noFlag>(flagPos));
+        BOOST_TEST_REQUIRE(flags.back());
+    }
+    flags.push_back(world.GetSpecObj<noRoadNode>(hqPos));
+
+    const GameWorldBase& constWorld = world;
+    const auto runQuery = [&constWorld](const MapPoint start, const MapPoint dest, const noRoadNode& startNode,
+                                        const noRoadNode& goalNode) {
+        PathQueryResult result;
+        if(start != dest)
+            result.humanDir = constWorld.FindHumanPath(start, dest, 100, false, &result.humanLength);
+        if(&startNode != &goalNode)
+        {
+            const RoadPathFinder& roadPF = constWorld.GetRoadPathFinder();
+            result.roadPathExists = roadPF.PathExists(startNode, goalNode, false);
+            roadPF.FindPath(startNode, goalNode, false, std::numeric_limits<unsigned>::max(), nullptr,
+                            &result.roadLength, &result.roadDir, &result.roadFirstPt);
+        }
+        return result;
+    };
+
+    struct Query
+    {
+        MapPoint start, dest;
+        const noRoadNode *startNode, *goalNode;
+    };
+    std::vector<Query> queries;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        const MapPoint dest = world.MakeMapPoint(pt + Position(5, 3));
+        queries.push_back(Query{pt, dest, flags[queries.size() % flags.size()],
+                                flags[(queries.size() / flags.size()) % flags.size()]});
+    }
+
+    std::vector<PathQueryResult> expected;
+    for(const Query& q : queries)
+        expected.push_back(runQuery(q.start, q.dest, *q.startNode, *q.goalNode));
+    // Sanity check that we actually found paths
+    BOOST_TEST_REQUIRE(helpers::contains_if(expected, [](const auto& r) { return r.roadPathExists; }));
+    BOOST_TEST_REQUIRE(helpers::contains_if(expected, [](const auto& r) { return !!r.humanDir; }));
+
+    constexpr unsigned numThreads = 4;
+    std::vector<std::vector<PathQueryResult>> results(numThreads);
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            // Each thread starts at a different query to have different queries run at the same time
+            for(unsigned i = 0; i < queries.size(); i++)
+            {
+                const Query& q = queries[(i + t * queries.size() / numThreads) % queries.size()];
+                results[t].push_back(runQuery(q.start, q.dest, *q.startNode, *q.goalNode));
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+        thread.join();
+
+    for(unsigned t = 0; t < numThreads; t++)
+    {
+        for(unsigned i = 0; i < queries.size(); i++)
+        {
+            const unsigned queryIdx = (i + t * queries.size() / numThreads) % queries.size();
+            BOOST_TEST_INFO("Thread " << t << " query " << queryIdx);
+            BOOST_TEST((results[t][i] == expected[queryIdx]));
+        }
+    }
+    // Scratch memory is returned to the pool and reused
+    BOOST_TEST(world.GetFreePathFinder().GetNumFreeContexts() >= 1u);
+    BOOST_TEST(world.GetFreePathFinder().GetNumFreeContexts() <= numThreads);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,17 +2,25 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "FindWhConditions.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
+#include "RttrForeachPt.h"
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobHarborBuilding.h"
 #include "buildings/nobShipYard.h"
 #include "factories/BuildingFactory.h"
+#include "helpers/containerUtils.h"
 #include "pathfinding/FindPathForRoad.h"
+#include "pathfinding/FreePathFinderImpl.h"
+#include "pathfinding/PathConditionShip.h"
+#include "pathfinding/RehomingCache.h"
+#include "pathfinding/ShipPathCache.h"
 #include "postSystem/PostBox.h"
 #include "postSystem/ShipPostMsg.h"
 #include "worldFixtures/SeaWorldWithGCExecution.h"
 #include "worldFixtures/initGameRNG.hpp"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noShip.h"
 #include "gameTypes/GameTypesOutput.h"
 #include <boost/test/unit_test.hpp>
@@ -633,4 +641,92 @@ BOOST_FIXTURE_TEST_CASE(HarborDestroyed, ShipAndHarborsReadyFixture<1>)
     BOOST_TEST_REQUIRE(ship.GetTargetHarbor() == 1u);
 }
 
+BOOST_FIXTURE_TEST_CASE(RehomingCacheFindsWarehouseOverseas, ShipAndHarborsReadyFixture<1>)
+{
+    const GamePlayer& player = world.GetPlayer(curPlayer);
+    const RehomingCache& cache = world.GetRehomingCache();
+    const MapPoint hb1Pos = world.GetHarborPoint(1);
+    const MapPoint hb2Pos = world.GetHarborPoint(2);
+    const auto* flag = world.GetSpecObj<noFlag>(world.GetNeighbour(hb1Pos, Direction::SouthEast));
+    BOOST_TEST_REQUIRE(flag);
+
+    // Only the 2nd harbor accepts woodcutters which can only be reached by ship
+    SetInventorySetting(player.GetHQPos(), Job::Woodcutter, EInventorySetting::Stop);
+    SetInventorySetting(hb1Pos, Job::Woodcutter, EInventorySetting::Stop);
+    BOOST_TEST_REQUIRE(player.FindWarehouse(*flag, FW::AcceptsFigure(Job::Woodcutter), true, false)
+                       == world.GetSpecObj<nobBaseWarehouse>(hb2Pos));
+    BOOST_TEST(cache.hasWarehouseFor(curPlayer, *flag, Job::Woodcutter));
+
+    SetInventorySetting(hb2Pos, Job::Woodcutter, EInventorySetting::Stop);
+    BOOST_TEST_REQUIRE(!player.FindWarehouse(*flag, FW::AcceptsFigure(Job::Woodcutter), true, false));
+    BOOST_TEST(!cache.hasWarehouseFor(curPlayer, *flag, Job::Woodcutter));
+}
+
+BOOST_FIXTURE_TEST_CASE(ShipPathCacheMatchesPathfinder, SeaWorldWithGCExecution<>)
+{
+    const ShipPathCache& cache = world.GetShipPathCache();
+    std::vector<MapPoint> coastalPts;
+    for(unsigned hbId = 1; hbId <= world.GetNumHarborPoints(); hbId++)
+    {
+        for(unsigned seaId = 1; seaId <= world.GetNumSeas(); seaId++)
+        {
+            if(world.IsHarborAtSea(hbId, seaId) && !helpers::contains(coastalPts, world.GetCoastalPoint(hbId, seaId)))
+                coastalPts.push_back(world.GetCoastalPoint(hbId, seaId));
+        }
+    }
+    BOOST_TEST_REQUIRE(coastalPts.size() >= 8u);
+    // Start at coastal points, some sea points and some land points
+    std::vector<MapPoint> startPts = coastalPts;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(world.GetIdx(pt) % 37u == 0u)
+            startPts.push_back(pt);
+    }
+
+    for(unsigned run = 0; run < 2; run++)
+    {
+        for(const MapPoint dest : coastalPts)
+        {
+            for(const MapPoint start : startPts)
+            {
+                if(start == dest)
+                    continue;
+                std::vector<Direction> expectedRoute;
+                unsigned expectedLength = 0;
+                const bool expectedFound = world.GetFreePathFinder().FindPath(
+                  start, dest, true, 10000, &expectedRoute, &expectedLength, nullptr, PathConditionShip(world));
+                BOOST_TEST_INFO("Start " << start << " dest " << dest << " run " << run);
+                const boost::optional<unsigned> distance = cache.getDistance(start, dest);
+                BOOST_TEST_REQUIRE(distance);
+                BOOST_TEST(*distance == (expectedFound ? expectedLength : ShipPathCache::NO_PATH));
+
+                std::vector<Direction> route;
+                unsigned length = 0;
+                BOOST_TEST_REQUIRE(world.FindShipPath(start, dest, 10000, &route, &length) == expectedFound);
+                if(!expectedFound)
+                    continue;
+                BOOST_TEST(length == expectedLength);
+                BOOST_TEST(route == expectedRoute, boost::test_tools::per_element());
+                length = 0;
+                BOOST_TEST(world.FindShipPath(start, dest, expectedLength, nullptr, &length));
+                BOOST_TEST(length == expectedLength);
+                BOOST_TEST(!world.FindShipPath(start, dest, expectedLength - 1u, &route, nullptr));
+            }
+        }
+        BOOST_TEST(cache.getNumDistanceFields() == coastalPts.size());
+        // Routes between harbors are cached
+        BOOST_TEST(cache.getNumRoutes() > 0u);
+        BOOST_TEST(cache.getNumRoutes() <= coastalPts.size() * coastalPts.size());
+        // Next run with another start direction for the random routes
+        em.ExecuteNextGF();
+    }
+    // Unknown destination
+    BOOST_TEST(!cache.getDistance(coastalPts[0], world.GetHarborPoint(1)));
+
+    // Writing a node drops all data as the terrain might change
+    world.GetNodeWriteable(coastalPts[0]);
+    BOOST_TEST(cache.getNumDistanceFields() == 0u);
+    BOOST_TEST(cache.getNumRoutes() == 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
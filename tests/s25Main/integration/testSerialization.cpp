@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GameCommands.h"
+#include "GameDataIndex.h"
 #include "GameEvent.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
@@ -631,6 +632,83 @@ BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
 
         CheckReplayCmds(loadReplay, cmds);
     }
+
+    // Commands can be read without loading the game data of the savegame
+    Replay loadReplay;
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath));
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap, SaveGameDataToLoad::HeaderSettingsAndIndex));
+    BOOST_TEST(newMap.savegame->sgd.GetLength() == 0u);
+    BOOST_TEST(!newMap.savegame->sgd.GetIndex().empty());
+    CheckReplayCmds(loadReplay, cmds);
+}
+
+BOOST_FIXTURE_TEST_CASE(SavegameIndex, RandWorldFixture)
+{
+    for(unsigned i = 0; i < 100; i++)
+        em.ExecuteNextGF();
+
+    Savegame save;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save.AddPlayer(world.GetPlayer(i));
+    save.ggs = ggs;
+    save.start_gf = em.GetCurrentGF();
+    save.sgd.MakeSnapshot(*game);
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    BOOST_TEST_REQUIRE(save.Save(tmpFile.filePath, "MapTitle"));
+
+    Savegame loadSave;
+    BOOST_TEST_REQUIRE(loadSave.Load(tmpFile.filePath, SaveGameDataToLoad::HeaderSettingsAndIndex));
+    BOOST_TEST(loadSave.sgd.GetLength() == 0u);
+    const GameDataIndex& index = loadSave.sgd.GetIndex();
+
+    // Sections cover the game data after the header
+    BOOST_TEST_REQUIRE(index.sections.size() == 2u + world.GetNumPlayers());
+    BOOST_TEST((index.sections[0].type == GameDataIndex::SectionType::World));
+    BOOST_TEST((index.sections[1].type == GameDataIndex::SectionType::Events));
+    for(unsigned i = 1; i < index.sections.size(); i++)
+        BOOST_TEST(index.sections[i].offset == index.sections[i - 1].offset + index.sections[i - 1].size);
+    BOOST_TEST(index.sections.back().offset + index.sections.back().size == save.sgd.GetLength());
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+    {
+        BOOST_TEST((index.sections[2 + i].type == GameDataIndex::SectionType::Player));
+        BOOST_TEST(index.sections[2 + i].player == i);
+    }
+
+    unsigned numObjects = 0, objectsSize = 0;
+    for(const GameDataIndex::ObjectStats& stats : index.objects)
+    {
+        numObjects += stats.count;
+        objectsSize += stats.size;
+    }
+    // "Nothing" nodeObj does not get serialized
+    BOOST_TEST(numObjects + 1u == GameObject::GetNumObjs());
+    BOOST_TEST(objectsSize < save.sgd.GetLength());
+
+    const std::vector<const GameEvent*> events = em.GetEvents();
+    BOOST_TEST_REQUIRE(index.events.size() == events.size());
+    for(unsigned i = 0; i < events.size(); i++)
+    {
+        BOOST_TEST(index.events[i].instanceId == events[i]->GetInstanceId());
+        BOOST_TEST(index.events[i].GetTargetGF() == events[i]->GetTargetGF());
+        BOOST_TEST(index.events[i].id == events[i]->id);
+        BOOST_TEST(index.events[i].objId == events[i]->obj->GetObjId());
+    }
+
+    BOOST_TEST_REQUIRE(index.inventories.size() == world.GetNumPlayers());
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+    {
+        const Inventory& inventory = world.GetPlayer(i).GetInventory();
+        BOOST_TEST(index.inventories[i].goods == inventory.goods, boost::test_tools::per_element());
+        BOOST_TEST(index.inventories[i].people == inventory.people, boost::test_tools::per_element());
+    }
+
+    // Loading everything also loads the index
+    BOOST_TEST_REQUIRE(loadSave.Load(tmpFile.filePath, SaveGameDataToLoad::All));
+    BOOST_TEST(loadSave.sgd.GetLength() == save.sgd.GetLength());
+    BOOST_TEST(loadSave.sgd.GetIndex().events.size() == events.size());
 }
 
 BOOST_FIXTURE_TEST_CASE(SerializeHunter, EmptyWorldFixture1P)
@@ -670,6 +748,48 @@ BOOST_FIXTURE_TEST_CASE(SerializeHunter, EmptyWorldFixture1P)
                                   sgd2.GetData() + sgd2.GetLength());
 }
 
+BOOST_FIXTURE_TEST_CASE(SerializeNodePlanes, EmptyWorldFixture1P)
+{
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const MapPoint changedPt = world.MakeMapPoint(hqPos + Position(5, 3));
+    world.ChangeAltitude(changedPt, 17);
+    world.SetResource(changedPt, Resource(ResourceType::Gold, 5));
+    world.SetReserved(changedPt, true);
+    // FoW nodes with and without an object
+    world.SetVisibility(hqPos, 0, Visibility::FogOfWar, 42);
+    world.SetVisibility(changedPt, 0, Visibility::FogOfWar, 43);
+    SerializedGameData sgd;
+    sgd.MakeSnapshot(*game);
+
+    const auto hqFowRoads = world.GetNode(hqPos).fow[0].roads;
+    const auto hqFowBoundaryStones = world.GetNode(hqPos).fow[0].boundary_stones;
+
+    MockLocalGameState lgs;
+    em.Clear();
+    world.Unload();
+    sgd.ReadSnapshot(*game, lgs);
+    const MapNode& changedNode = world.GetNode(changedPt);
+    BOOST_TEST(changedNode.altitude == 17u);
+    BOOST_TEST(changedNode.resources == Resource(ResourceType::Gold, 5));
+    BOOST_TEST(changedNode.reserved);
+    BOOST_TEST(changedNode.fow[0].visibility == Visibility::FogOfWar);
+    BOOST_TEST(changedNode.fow[0].last_update_time == 43u);
+    BOOST_TEST(changedNode.fow[0].object == nullptr);
+    const FoWNode& hqFow = world.GetNode(hqPos).fow[0];
+    BOOST_TEST(hqFow.visibility == Visibility::FogOfWar);
+    BOOST_TEST(hqFow.last_update_time == 42u);
+    BOOST_TEST(hqFow.object != nullptr);
+    BOOST_TEST(hqFow.roads == hqFowRoads, boost::test_tools::per_element());
+    BOOST_TEST(hqFow.boundary_stones == hqFowBoundaryStones, boost::test_tools::per_element());
+    BOOST_TEST(world.GetSpecObj<nobBaseWarehouse>(hqPos));
+
+    // Serialize again and compare data
+    SerializedGameData sgd2;
+    sgd2.MakeSnapshot(*game);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sgd.GetData(), sgd.GetData() + sgd.GetLength(), sgd2.GetData(),
+                                  sgd2.GetData() + sgd2.GetLength());
+}
+
 BOOST_AUTO_TEST_CASE(SerializeGameMessageChat)
 {
     const GameMessage_Chat msg(rttr::test::randomValue(0u, 10u), rttr::test::randomEnum<ChatDestination>(), "Hello");
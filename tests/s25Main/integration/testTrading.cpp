@@ -6,6 +6,7 @@
 #include "TradePathCache.h"
 #include "addons/const_addons.h"
 #include "buildings/nobBaseWarehouse.h"
+#include "nodeObjs/noGranite.h"
 #include "postSystem/PostBox.h"
 #include "postSystem/PostMsgWithBuilding.h"
 #include "worldFixtures/WorldWithGCExecution.h"
@@ -15,6 +16,7 @@
 #include <rttr/test/LogAccessor.hpp>
 #include <boost/test/unit_test.hpp>
 #include <variant.h>
+#include <limits>
 
 struct TradeFixture : public WorldWithGCExecution3P
 {
@@ -365,21 +367,55 @@ BOOST_AUTO_TEST_CASE(GetWarehousesForTrading)
               TradePath(MapPoint(2, 2), MapPoint(5, 1), {Direction::East, Direction::East, Direction::NorthEast}), 2);
             BOOST_TEST(cache.size() == oldCacheSize + 2u);
 
-            // Add a few more until the cache is full
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(3, 2), std::vector<Direction>(1, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(4, 2), std::vector<Direction>(2, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(5, 2), std::vector<Direction>(3, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(6, 2), std::vector<Direction>(4, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(7, 2), std::vector<Direction>(5, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(8, 2), std::vector<Direction>(6, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(9, 2), std::vector<Direction>(7, Direction::East)), 0);
-            cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(10, 2), std::vector<Direction>(8, Direction::East)), 0);
-            BOOST_TEST(cache.size() == 10u);
-            // Cache is full so this replaces the oldest entry
+            // Add more until the cache is full
+            RTTR_FOREACH_PT(MapPoint, world.GetSize())
+            {
+                if(cache.size() < cache.getMaxSize())
+                    cache.addEntry(TradePath(pt, world.GetNeighbour(pt, Direction::East), {Direction::East}), 0);
+            }
+            BOOST_TEST_REQUIRE(cache.size() == cache.getMaxSize());
+            // Cache is full so this replaces the least recently used entry
             cache.addEntry(TradePath(MapPoint(2, 2), MapPoint(11, 2), std::vector<Direction>(9, Direction::East)), 0);
-            BOOST_TEST(cache.size() == 10u);
+            BOOST_TEST(cache.size() == cache.getMaxSize());
         }
     }
 }
 
+BOOST_AUTO_TEST_CASE(TradePathCacheInvalidation)
+{
+    TradePathCache& cache = world.GetTradePathCache();
+    cache.clear();
+    const MapPoint startFlag = world.GetNeighbour(players[0]->GetHQPos(), Direction::SouthEast);
+    const MapPoint goalFlag = world.GetNeighbour(players[1]->GetHQPos(), Direction::SouthEast);
+    const uint64_t numHits = cache.getNumHits();
+    const uint64_t numMisses = cache.getNumMisses();
+    BOOST_TEST(cache.pathExists(startFlag, goalFlag, 0));
+    BOOST_TEST(cache.getNumMisses() == numMisses + 1u);
+    // The allied player can use the path in the other direction
+    BOOST_TEST(cache.pathExists(goalFlag, startFlag, 1));
+    BOOST_TEST(cache.getNumHits() == numHits + 1u);
+    BOOST_TEST(cache.size() == 1u);
+
+    // Block a point in the middle of the (same) route
+    std::vector<Direction> route;
+    BOOST_TEST_REQUIRE(
+      world.FindTradePath(startFlag, goalFlag, 0, std::numeric_limits<unsigned>::max(), false, &route));
+    BOOST_TEST_REQUIRE(route.size() > 2u);
+    MapPoint middlePt = startFlag;
+    for(unsigned i = 0; i < route.size() / 2; i++)
+        middlePt = world.GetNeighbour(middlePt, route[i]);
+    BOOST_TEST_REQUIRE(!world.GetNode(middlePt).obj);
+    const uint64_t numInvalidations = cache.getNumInvalidations();
+    world.SetNO(middlePt, new noGranite(GraniteType::One, 1));
+    BOOST_TEST(cache.size() == 0u);
+    BOOST_TEST(cache.getNumInvalidations() == numInvalidations + 1u);
+    BOOST_TEST(cache.pathExists(startFlag, goalFlag, 0));
+    BOOST_TEST(cache.getNumMisses() == numMisses + 2u);
+    // The new route avoids the point, so removing the object there keeps it
+    world.DestroyNO(middlePt);
+    BOOST_TEST(cache.size() == 1u);
+    BOOST_TEST(cache.pathExists(startFlag, goalFlag, 0));
+    BOOST_TEST(cache.getNumHits() == numHits + 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
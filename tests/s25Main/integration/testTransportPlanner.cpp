@@ -0,0 +1,109 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GamePlayer.h"
+#include "TransportPlanner.h"
+#include "Ware.h"
+#include "buildings/nobUsual.h"
+#include "factories/BuildingFactory.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noFlag.h"
+#include <rttr/test/random.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(TransportPlannerSuite)
+
+BOOST_AUTO_TEST_CASE(SolveAssignmentFindsMinimum)
+{
+    BOOST_TEST(TransportPlanner::SolveAssignment({}).empty());
+    BOOST_TEST(TransportPlanner::SolveAssignment({{5}}) == std::vector<unsigned>{0});
+    const std::vector<unsigned> swapped = TransportPlanner::SolveAssignment({{10, 1}, {1, 10}});
+    BOOST_TEST(swapped == (std::vector<unsigned>{1, 0}), boost::test_tools::per_element());
+
+    for(unsigned n = 2; n <= 6; n++)
+    {
+        std::vector<std::vector<unsigned>> costs(n, std::vector<unsigned>(n));
+        for(auto& row : costs)
+        {
+            for(unsigned& cost : row)
+                cost = rttr::test::randomValue(0u, 100u);
+        }
+        const auto calcCosts = [&costs](const std::vector<unsigned>& assignment) {
+            unsigned sum = 0;
+            for(unsigned i = 0; i < assignment.size(); i++)
+                sum += costs[i][assignment[i]];
+            return sum;
+        };
+        // Compare with all permutations
+        std::vector<unsigned> permutation(n);
+        std::iota(permutation.begin(), permutation.end(), 0u);
+        unsigned bestCosts = calcCosts(permutation);
+        while(std::next_permutation(permutation.begin(), permutation.end()))
+            bestCosts = std::min(bestCosts, calcCosts(permutation));
+
+        std::vector<unsigned> assignment = TransportPlanner::SolveAssignment(costs);
+        BOOST_TEST_REQUIRE(assignment.size() == n);
+        BOOST_TEST(calcCosts(assignment) == bestCosts);
+        std::sort(assignment.begin(), assignment.end());
+        BOOST_TEST(std::adjacent_find(assignment.begin(), assignment.end()) == assignment.end());
+    }
+}
+
+using TransportPlannerFixture = WorldWithGCExecution<1, 24, 20>;
+BOOST_FIXTURE_TEST_CASE(PlannerSwapsCrossingWares, TransportPlannerFixture)
+{
+    GamePlayer& player = world.GetPlayer(curPlayer);
+    // Line of flags starting at the HQ flag with a mill at the 2nd and 4th flag
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    std::vector<noFlag*> flags(1, world.GetSpecObj<noFlag>(hqFlagPos));
+    for(unsigned i = 0; i < 3; i++)
+    {
+        this->BuildRoad(flags.back()->GetPos(), false, std::vector<Direction>(2, Direction::East));
+        flags.push_back(world.GetSpecObj<noFlag>(world.MakeMapPoint(flags.back()->GetPos() + Position(2, 0))));
+        BOOST_TEST_REQUIRE(flags.back());
+    }
+    auto* millNear = dynamic_cast<nobUsual*>(BuildingFactory::CreateBuilding(
+      world, BuildingType::Mill, world.GetNeighbour(flags[1]->GetPos(), Direction::NorthWest), curPlayer,
+      Nation::Romans));
+    auto* millFar = dynamic_cast<nobUsual*>(BuildingFactory::CreateBuilding(
+      world, BuildingType::Mill, world.GetNeighbour(flags[3]->GetPos(), Direction::NorthWest), curPlayer,
+      Nation::Romans));
+    BOOST_TEST_REQUIRE(millNear);
+    BOOST_TEST_REQUIRE(millFar);
+
+    const auto addWare = [&](noFlag& flag, nobUsual& goal) {
+        auto ware = std::make_unique<Ware>(GoodType::Grain, &goal, &flag);
+        Ware* result = ware.get();
+        ware->WaitAtFlag(&flag);
+        ware->RecalcRoute();
+        flag.AddWare(std::move(ware));
+        player.IncreaseInventoryWare(GoodType::Grain, 1);
+        return result;
+    };
+    // The ware at the HQ flag goes to the far mill passing the near one,
+    // the other one goes back to the near mill although the far mill is next to it
+    Ware* wareHq = addWare(*flags[0], *millFar);
+    Ware* wareMiddle = addWare(*flags[2], *millNear);
+    BOOST_TEST_REQUIRE((wareHq->GetNextDir() == RoadPathDirection::East));
+    BOOST_TEST_REQUIRE((wareMiddle->GetNextDir() == RoadPathDirection::West));
+
+    BOOST_TEST(player.PlanWareTransports() == 2u);
+    BOOST_TEST(wareHq->GetGoal() == millNear);
+    BOOST_TEST(wareMiddle->GetGoal() == millFar);
+    BOOST_TEST((wareHq->GetNextDir() == RoadPathDirection::East));
+    BOOST_TEST((wareMiddle->GetNextDir() == RoadPathDirection::East));
+    // Both mills still expect a ware
+    BOOST_TEST(millNear->AreThereAnyOrderedWares());
+    BOOST_TEST(millFar->AreThereAnyOrderedWares());
+
+    // Nothing to improve anymore
+    BOOST_TEST(player.PlanWareTransports() == 0u);
+    BOOST_TEST(wareHq->GetGoal() == millNear);
+    BOOST_TEST(wareMiddle->GetGoal() == millFar);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
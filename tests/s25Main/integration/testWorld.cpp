@@ -12,9 +12,13 @@
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/MockLocalGameState.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/WorldWithGCExecution.h"
 #include "worldFixtures/terrainHelpers.h"
 #include "world/MapLoader.h"
+#include "world/PlayerObjectIndex.h"
+#include "world/WorldStateHash.h"
 #include "nodeObjs/noBase.h"
+#include "nodeObjs/noFlag.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "libsiedler2/ArchivItem_Map.h"
 #include "libsiedler2/ArchivItem_Map_Header.h"
@@ -22,6 +26,7 @@
 #include "s25util/tmpFile.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/test/unit_test.hpp>
+#include <array>
 #include <vector>
 
 struct MapTestFixture
@@ -73,6 +78,7 @@ struct LoadWorldAndS2MapCreator : MapTestFixture
 using WorldLoadedWithS2MapFixture = WorldFixture<LoadWorldAndS2MapCreator>;
 using WorldLoaded1PFixture = WorldFixture<LoadWorldFromFileCreator, 1>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
+using WorldFixtureEmpty2P = WorldFixture<CreateEmptyWorld, 2>;
 } // namespace
 
 BOOST_FIXTURE_TEST_CASE(LoadWorld, WorldFixture<UninitializedWorldCreator>)
@@ -236,6 +242,105 @@ BOOST_FIXTURE_TEST_CASE(NONothingOnEmptyNode, WorldFixtureEmpty1P)
     BOOST_TEST(world.GetGOT(emptySpot) == GO_Type::Nothing);
 }
 
+BOOST_FIXTURE_TEST_CASE(PlayerObjectIndexMatchesPointsInRadius, WorldFixtureEmpty2P)
+{
+    const PlayerObjectIndex& index = world.GetPlayerObjectIndex();
+    const auto checkIndex = [this, &index]() {
+        for(unsigned player = 0; player < world.GetNumPlayers(); player++)
+        {
+            const auto isOwnFlag = [this, player](const MapPoint pt) {
+                const auto* flag = world.GetSpecObj<noFlag>(pt);
+                return flag && flag->GetPlayer() == player;
+            };
+            const auto isOwnHQ = [this, player](const MapPoint pt) { return pt == world.GetPlayer(player).GetHQPos(); };
+            RTTR_FOREACH_PT(MapPoint, world.GetSize())
+            {
+                for(const unsigned radius : {1u, 5u, 12u})
+                {
+                    BOOST_TEST_REQUIRE(index.GetInRadius(player, PlayerObjectIndex::Type::Flag, pt, radius)
+                                       == world.GetMatchingPointsInRadius(pt, radius, isOwnFlag));
+                    BOOST_TEST_REQUIRE(index.GetInRadius(player, PlayerObjectIndex::Type::Flag, pt, radius, 3)
+                                       == world.GetMatchingPointsInRadius<3>(pt, radius, isOwnFlag));
+                    BOOST_TEST_REQUIRE(index.GetInRadius(player, PlayerObjectIndex::Type::Warehouse, pt, radius)
+                                       == world.GetMatchingPointsInRadius(pt, radius, isOwnHQ));
+                }
+            }
+        }
+    };
+    // HQs and their flags only
+    checkIndex();
+
+    // Place as many flags as possible
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(world.GetNode(pt).owner)
+            world.SetFlag(pt, world.GetNode(pt).owner - 1);
+    }
+    checkIndex();
+
+    // Remove some again but keep the HQs
+    unsigned i = 0;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        const auto* flag = world.GetSpecObj<noFlag>(pt);
+        if(!flag || world.GetNeighbour(world.GetPlayer(flag->GetPlayer()).GetHQPos(), Direction::SouthEast) == pt)
+            continue;
+        if(i++ % 3 == 0)
+            world.DestroyFlag(pt, flag->GetPlayer());
+    }
+    checkIndex();
+}
+
+BOOST_FIXTURE_TEST_CASE(StateHashIsUpdatedIncrementally, WorldWithGCExecution2P)
+{
+    WorldStateHash& stateHash = world.GetStateHash();
+    using Part = WorldStateHash::Part;
+    const auto getHashes = [&stateHash]() {
+        return std::array<uint64_t, WorldStateHash::NUM_PARTS>{
+          stateHash.get(Part::Owners), stateHash.get(Part::Objects), stateHash.get(Part::Figures),
+          stateHash.get(Part::Inventories)};
+    };
+    // The incremental hashes must be the same as when calculated from scratch
+    const auto checkRecalc = [&]() {
+        const auto hashes = getHashes();
+        stateHash.recalc();
+        BOOST_TEST(getHashes() == hashes, boost::test_tools::per_element());
+        return hashes;
+    };
+    const auto initialHashes = checkRecalc();
+
+    // Owner changes are reverted by restoring the owner
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint pt = world.MakeMapPoint(hqFlagPos + Position(0, 3));
+    const unsigned char owner = world.GetNode(pt).owner;
+    world.SetOwner(pt, owner + 1);
+    BOOST_TEST(stateHash.get(Part::Owners) != initialHashes[0]);
+    world.SetOwner(pt, owner);
+    BOOST_TEST(stateHash.get(Part::Owners) == initialHashes[0]);
+    // Same for inventories
+    GamePlayer& player = world.GetPlayer(curPlayer);
+    player.IncreaseInventoryWare(GoodType::Boards, 2);
+    player.DecreaseInventoryJob(Job::Helper, 1);
+    checkRecalc();
+    BOOST_TEST(stateHash.get(Part::Inventories) != initialHashes[3]);
+    player.DecreaseInventoryWare(GoodType::Boards, 2);
+    player.IncreaseInventoryJob(Job::Helper, 1);
+    BOOST_TEST(stateHash.get(Part::Inventories) == initialHashes[3]);
+
+    // Let carriers walk on a road and a building be constructed
+    this->BuildRoad(hqFlagPos, false, std::vector<Direction>(4, Direction::East));
+    const MapPoint flagPos = world.MakeMapPoint(hqFlagPos + Position(4, 0));
+    this->SetBuildingSite(world.GetNeighbour(flagPos, Direction::NorthWest), BuildingType::Woodcutter);
+    const auto changedHashes = checkRecalc();
+    BOOST_TEST(changedHashes[1] != initialHashes[1]);
+    BOOST_TEST(changedHashes[2] == initialHashes[2]);
+    RTTR_SKIP_GFS(100);
+    const auto walkingHashes = checkRecalc();
+    BOOST_TEST(walkingHashes[2] != initialHashes[2]);
+    RTTR_SKIP_GFS(2000);
+    checkRecalc();
+}
+
 BOOST_FIXTURE_TEST_CASE(LoadLua, WorldFixture<UninitializedWorldCreator>)
 {
     MapLoader loader(world);
@@ -782,6 +782,52 @@ BOOST_AUTO_TEST_CASE(WorldEvents)
     BOOST_TEST_REQUIRE(getLog() == (resFmt % 2 % pt3 % "Water" % 5).str());
 }
 
+BOOST_AUTO_TEST_CASE(HandlersAreTrackedAndTimed)
+{
+    using Handler = LuaInterfaceGame::Handler;
+    LuaInterfaceGame& lua = world.GetLua();
+    const LuaInterfaceGame::HandlerStats& stats = lua.GetHandlerStats(Handler::GameFrame);
+    BOOST_TEST(!lua.HasHandler(Handler::GameFrame));
+    lua.EventGameFrame(0);
+    BOOST_TEST(stats.numCalls == 0u);
+
+    executeLua("function onGameFrame(gf)\n  rttr:Log('gf: '..gf)\nend");
+    BOOST_TEST(lua.HasHandler(Handler::GameFrame));
+    BOOST_TEST(!lua.HasHandler(Handler::Start));
+    clearLog();
+    lua.EventGameFrame(1);
+    BOOST_TEST(getLog() == "gf: 1\n");
+    // Handlers can be replaced...
+    executeLua("onGameFrame = function(gf) rttr:Log('new gf: '..gf) end");
+    lua.EventGameFrame(2);
+    BOOST_TEST(getLog() == "new gf: 2\n");
+    BOOST_TEST(stats.numCalls == 2u);
+    BOOST_TEST((stats.maxTime <= stats.totalTime));
+    // ... removed ...
+    executeLua("onGameFrame = nil");
+    lua.EventGameFrame(3);
+    BOOST_TEST(!lua.HasHandler(Handler::GameFrame));
+    BOOST_TEST(getLog().empty());
+    // ... and defined again
+    executeLua("function onGameFrame(gf)\n  rttr:Log('again gf: '..gf)\nend");
+    lua.EventGameFrame(4);
+    BOOST_TEST(getLog() == "again gf: 4\n");
+    BOOST_TEST(stats.numCalls == 3u);
+
+    // Handlers exceeding the budget are aborted
+    lua.SetInstructionBudget(10000);
+    executeLua("function onGameFrame(gf)\n  for i = 1, 1000000 do end\nend");
+    BOOST_CHECK_THROW(lua.EventGameFrame(5), LuaExecutionError);
+    // The budget is per call
+    executeLua("function onGameFrame(gf)\n  for i = 1, 1000 do end\n  rttr:Log('gf: '..gf)\nend");
+    clearLog();
+    lua.EventGameFrame(6);
+    lua.EventGameFrame(7);
+    BOOST_TEST(getLog() == "gf: 6\ngf: 7\n");
+    lua.SetInstructionBudget(0);
+    BOOST_TEST(stats.numCalls == 6u);
+}
+
 BOOST_AUTO_TEST_CASE(onOccupied)
 {
     executeLua("occupied = {}\n\
@@ -5,7 +5,9 @@
 #include "PointOutput.h"
 #include "helpers/containerUtils.h"
 #include "mapGenerator/Algorithms.h"
+#include "rttr/test/random.hpp"
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <set>
 
 using namespace rttr::mapGenerator;
@@ -52,6 +54,31 @@ BOOST_AUTO_TEST_CASE(UpdateDistances_updates_enqueued_elements_correctly)
     }
 }
 
+BOOST_AUTO_TEST_CASE(UpdateDistances_handles_different_initial_distances)
+{
+    MapExtent size(8, 8);
+    const MapPoint first(1, 1), second(5, 5);
+    NodeMapBase<unsigned> distances;
+    distances.Resize(size, unsigned(-1));
+    std::queue<MapPoint> queue;
+    queue.push(first);
+    queue.push(second);
+    distances[first] = 0;
+    distances[second] = 1;
+
+    UpdateDistances(distances, queue);
+
+    BOOST_TEST_REQUIRE(queue.empty());
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        if(pt == first || pt == second)
+            continue;
+        const unsigned expected =
+          std::min(distances.CalcDistance(pt, first), distances.CalcDistance(pt, second) + 1);
+        BOOST_TEST_REQUIRE(distances[pt] == expected);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(Smooth_keeps_homogenous_map_unchanged)
 {
     NodeMapBase<int> nodes;
@@ -97,6 +124,43 @@ BOOST_AUTO_TEST_CASE(Smooth_interpolates_values_around_peak)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Smooth_matches_smoothing_with_points_in_radius)
+{
+    // Odd height and last one is smaller than the radius
+    for(const MapExtent size :
+        {MapExtent(32, 16), MapExtent(30, 18), MapExtent(8, 6), MapExtent(16, 9), MapExtent(2, 4)})
+    {
+        NodeMapBase<int> nodes;
+        nodes.Resize(size);
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            nodes[pt] = rttr::test::randomValue(0, 1000);
+        }
+        const unsigned radius = 3;
+        const unsigned iterations = 2;
+
+        NodeMapBase<int> expected = nodes;
+        for(unsigned i = 0; i < iterations; ++i)
+        {
+            const NodeMapBase<int> previous = expected;
+            RTTR_FOREACH_PT(MapPoint, size)
+            {
+                const auto points = previous.GetPointsInRadiusWithCenter(pt, radius);
+                int sum = 0;
+                for(const MapPoint& p : points)
+                    sum += previous[p];
+                expected[pt] = static_cast<int>(round(static_cast<double>(sum) / points.size()));
+            }
+        }
+
+        Smooth(iterations, radius, nodes);
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            BOOST_TEST_REQUIRE(nodes[pt] == expected[pt], "At " << pt << " of " << size);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(Scale_updates_minimum_and_maximum_values_correctly)
 {
     MapExtent size(16, 8);
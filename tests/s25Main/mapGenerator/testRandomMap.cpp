@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "PointOutput.h"
+#include "RttrForeachPt.h"
 #include "commonDefines.h"
 #include "lua/GameDataLoader.h"
 #include "mapGenerator/RandomMap.h"
@@ -13,6 +14,7 @@
 #include "rttr/test/TmpFolder.hpp"
 #include "rttr/test/random.hpp"
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 
 using namespace rttr::mapGenerator;
 
@@ -174,4 +176,48 @@ BOOST_AUTO_TEST_CASE(GenerateRandomMap_returns_valid_mapfile_with_max_players)
     }
 }
 
+BOOST_AUTO_TEST_CASE(GenerateRandomMap_is_deterministic_for_seed)
+{
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    MapSettings settings;
+    settings.size = getRandomMapSize(64, 80);
+    settings.style = MapStyle::Mixed;
+
+    RandomUtility rnd1(42);
+    RandomUtility rnd2(42);
+    const Map map1 = GenerateRandomMap(rnd1, worldDesc, settings);
+    const Map map2 = GenerateRandomMap(rnd2, worldDesc, settings);
+    BOOST_TEST(std::equal(map1.z.begin(), map1.z.end(), map2.z.begin()));
+    BOOST_TEST(std::equal(map1.objectTypes.begin(), map1.objectTypes.end(), map2.objectTypes.begin()));
+    BOOST_TEST(std::equal(map1.resources.begin(), map1.resources.end(), map2.resources.begin()));
+    BOOST_TEST(map1.hqPositions == map2.hqPositions, boost::test_tools::per_element());
+    RTTR_FOREACH_PT(MapPoint, settings.size)
+    {
+        BOOST_TEST_REQUIRE((map1.getTextures()[pt].rsu == map2.getTextures()[pt].rsu));
+        BOOST_TEST_REQUIRE((map1.getTextures()[pt].lsd == map2.getTextures()[pt].lsd));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GenerateRandomMap_reports_progress_and_can_be_canceled)
+{
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    MapSettings settings;
+    settings.size = getRandomMapSize(32, 32);
+    settings.style = MapStyle::Land;
+
+    std::vector<unsigned> reported;
+    GeneratorProgress progress([&reported](unsigned percentage) { reported.push_back(percentage); });
+    RandomUtility rnd(0);
+    GenerateRandomMap(rnd, worldDesc, settings, &progress);
+    BOOST_TEST_REQUIRE(reported.size() > 2u);
+    BOOST_TEST(std::is_sorted(reported.begin(), reported.end()));
+    BOOST_TEST(reported.back() <= 100u);
+
+    // Cancel after the first step
+    GeneratorProgress cancelingProgress([&cancelingProgress](unsigned) { cancelingProgress.cancel(); });
+    BOOST_CHECK_THROW(GenerateRandomMap(rnd, worldDesc, settings, &cancelingProgress), GenerationCanceled);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
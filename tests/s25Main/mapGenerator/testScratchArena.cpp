@@ -0,0 +1,73 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mapGenerator/ScratchArena.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace rttr::mapGenerator;
+
+BOOST_AUTO_TEST_SUITE(ScratchArenaTests)
+
+BOOST_AUTO_TEST_CASE(VisitPlane_resets_visited_nodes)
+{
+    VisitPlane visited;
+    visited.Reset(MapExtent(4, 2));
+    BOOST_TEST(!visited.IsVisited(3));
+    BOOST_TEST(visited.Visit(3));
+    BOOST_TEST(visited.IsVisited(3));
+    BOOST_TEST(!visited.Visit(3));
+    BOOST_TEST(!visited.IsVisited(7));
+
+    visited.Reset(MapExtent(4, 2));
+    BOOST_TEST(!visited.IsVisited(3));
+    BOOST_TEST(visited.Visit(3));
+    // Different size
+    visited.Reset(MapExtent(8, 2));
+    for(unsigned i = 0; i < 16; i++)
+        BOOST_TEST_REQUIRE(!visited.IsVisited(i));
+}
+
+BOOST_AUTO_TEST_CASE(RingQueue_is_fifo_when_growing_and_wrapping)
+{
+    RingQueue<unsigned> queue;
+    BOOST_TEST(queue.empty());
+    unsigned nextPushed = 0, nextPopped = 0;
+    // Interleave pushes and pops so head wraps around while the buffer grows
+    for(unsigned round = 0; round < 10; round++)
+    {
+        for(unsigned i = 0; i < 50 + round * 10; i++)
+            queue.push(nextPushed++);
+        for(unsigned i = 0; i < 40; i++)
+        {
+            BOOST_TEST_REQUIRE(queue.front() == nextPopped++);
+            queue.pop();
+        }
+        BOOST_TEST_REQUIRE(queue.size() == nextPushed - nextPopped);
+    }
+    while(!queue.empty())
+    {
+        BOOST_TEST_REQUIRE(queue.front() == nextPopped++);
+        queue.pop();
+    }
+    BOOST_TEST(nextPopped == nextPushed);
+    queue.push(42);
+    queue.clear();
+    BOOST_TEST(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Acquire_uses_separate_arena_when_nested)
+{
+    ScratchArena* outerArena;
+    {
+        auto outer = ScratchArena::Acquire();
+        outerArena = &*outer;
+        auto inner = ScratchArena::Acquire();
+        BOOST_TEST(&*inner != outerArena);
+    }
+    // Released again -> Same arena is reused
+    auto lease = ScratchArena::Acquire();
+    BOOST_TEST(&*lease == outerArena);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
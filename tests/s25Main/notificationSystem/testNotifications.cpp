@@ -8,6 +8,7 @@
 #include "notifications/notifications.h"
 #include "testNoteFunctions.h"
 #include <boost/test/unit_test.hpp>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -265,4 +266,91 @@ BOOST_AUTO_TEST_CASE(ThrowDuringPublish)
     BOOST_TEST(called2 == 1);
 }
 
+BOOST_AUTO_TEST_CASE(PublishBatches)
+{
+    NotificationManager mgr;
+    std::vector<int> values;
+    std::vector<size_t> batchSizes;
+    const auto sub1 = mgr.subscribe<IntNote>([&values](const IntNote& note) { values.push_back(note.value); });
+    const auto sub2 = mgr.subscribeBatch<IntNote>([&batchSizes](const std::vector<IntNote>& notes) {
+        BOOST_TEST_REQUIRE(!notes.empty());
+        batchSizes.push_back(notes.size());
+    });
+
+    // Single notes are passed as batches of 1 note
+    mgr.publish(IntNote{1});
+    BOOST_TEST(values == std::vector<int>({1}), boost::test_tools::per_element());
+    BOOST_TEST(batchSizes == std::vector<size_t>({1}), boost::test_tools::per_element());
+    mgr.publishBatch(std::vector<IntNote>{IntNote{2}, IntNote{3}});
+    // Empty batches are not published
+    mgr.publishBatch(std::vector<IntNote>());
+    BOOST_TEST(values == std::vector<int>({1, 2, 3}), boost::test_tools::per_element());
+    BOOST_TEST(batchSizes == std::vector<size_t>({1, 2}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(PublishSingleNotesFromBatchCallbacks)
+{
+    NotificationManager mgr;
+    std::vector<int> values;
+    const auto sub = mgr.subscribeBatch<IntNote>([&](const std::vector<IntNote>& notes) {
+        BOOST_TEST_REQUIRE(notes.size() == 1u);
+        const int value = notes.front().value;
+        // The nested note must not replace the one of the outer call
+        if(value < 3)
+            mgr.publish(IntNote{value + 1});
+        BOOST_TEST_REQUIRE(notes.size() == 1u);
+        BOOST_TEST(notes.front().value == value);
+        values.push_back(value);
+    });
+    mgr.publish(IntNote{1});
+    BOOST_TEST(values == std::vector<int>({3, 2, 1}), boost::test_tools::per_element());
+    mgr.publish(IntNote{5});
+    BOOST_TEST(values == std::vector<int>({3, 2, 1, 5}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(CollectNotesInBatch)
+{
+    NotificationManager mgr;
+    std::vector<int> values;
+    std::vector<size_t> batchSizes;
+    std::vector<std::string> strings;
+    const auto sub1 = mgr.subscribe<IntNote>([&values](const IntNote& note) { values.push_back(note.value); });
+    const auto sub2 = mgr.subscribeBatch<IntNote>([&](const std::vector<IntNote>& notes) {
+        batchSizes.push_back(notes.size());
+        // Notes published by callbacks are delivered directly
+        if(notes.size() > 1)
+            mgr.publish(IntNote{42});
+    });
+    const auto sub3 = mgr.subscribe<StringNote>([&strings](const StringNote& note) { strings.push_back(note.value); });
+    {
+        NotificationManager::Batch<IntNote> batch(mgr);
+        mgr.publish(IntNote{1});
+        {
+            // Merged into the outer batch
+            NotificationManager::Batch<IntNote> innerBatch(mgr);
+            mgr.publishBatch(std::vector<IntNote>{IntNote{2}, IntNote{3}});
+        }
+        // Other note types are not affected
+        mgr.publish(StringNote{"Test"});
+        BOOST_TEST(strings.size() == 1u);
+        BOOST_TEST(values.empty());
+        BOOST_TEST(batchSizes.empty());
+    }
+    BOOST_TEST(values == std::vector<int>({1, 2, 3, 42}), boost::test_tools::per_element());
+    BOOST_TEST(batchSizes == std::vector<size_t>({3, 1}), boost::test_tools::per_element());
+
+    // Notes are dropped if the batch is left due to an exception
+    values.clear();
+    try
+    {
+        NotificationManager::Batch<IntNote> batch(mgr);
+        mgr.publish(IntNote{1});
+        throw std::runtime_error("Something went wrong");
+    } catch(const std::runtime_error&)
+    {}
+    BOOST_TEST(values.empty());
+    mgr.publish(IntNote{2});
+    BOOST_TEST(values == std::vector<int>({2}), boost::test_tools::per_element());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
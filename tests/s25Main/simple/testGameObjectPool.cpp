@@ -0,0 +1,67 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameObjectPool.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(GameObjectPoolSuite)
+
+BOOST_AUTO_TEST_CASE(ReusesMemoryOfSameSize)
+{
+    GameObjectPool pool;
+    BOOST_TEST(pool.getStatistics().empty());
+
+    constexpr size_t step = GameObjectPool::SIZE_STEP;
+    constexpr size_t objSize = (40 + step - 1) / step * step;
+    constexpr size_t objsPerSlab = GameObjectPool::MIN_SLAB_SIZE / objSize;
+    // Many objects of the same size end up in few slabs and are aligned
+    std::vector<void*> objs;
+    for(unsigned i = 0; i < 1000; i++)
+    {
+        objs.push_back(pool.allocate(40));
+        BOOST_TEST(reinterpret_cast<uintptr_t>(objs.back()) % step == 0u);
+    }
+    BOOST_TEST(std::set<void*>(objs.begin(), objs.end()).size() == objs.size());
+    auto stats = pool.getStatistics();
+    BOOST_TEST_REQUIRE(stats.size() == 1u);
+    BOOST_TEST(stats[0].objSize == objSize);
+    BOOST_TEST(stats[0].numAllocations == 1000u);
+    BOOST_TEST(stats[0].numAlive == 1000u);
+    BOOST_TEST(stats[0].numSlabs == (1000u + objsPerSlab - 1u) / objsPerSlab);
+
+    // Freed memory is used by the next object of a similar size
+    pool.deallocate(objs[10], 40);
+    BOOST_TEST(pool.allocate(33) == objs[10]);
+    // Other sizes use other memory
+    void* otherSize = pool.allocate(64);
+    BOOST_TEST(std::set<void*>(objs.begin(), objs.end()).count(otherSize) == 0u);
+    pool.deallocate(otherSize, 64);
+
+    for(void* obj : objs)
+        pool.deallocate(obj, 40);
+    stats = pool.getStatistics();
+    BOOST_TEST_REQUIRE(stats.size() == 2u);
+    BOOST_TEST(stats[0].numAllocations == 1001u);
+    BOOST_TEST(stats[0].numAlive == 0u);
+    BOOST_TEST(stats[0].maxAlive == 1000u);
+    BOOST_TEST(stats[1].objSize == 64u);
+    BOOST_TEST(stats[1].numAlive == 0u);
+
+    // Large objects are not pooled
+    void* largeObj = pool.allocate(GameObjectPool::MAX_POOLED_SIZE + 1);
+    BOOST_TEST(largeObj);
+    pool.deallocate(largeObj, GameObjectPool::MAX_POOLED_SIZE + 1);
+    BOOST_TEST(pool.getStatistics().size() == 2u);
+
+    std::stringstream s;
+    pool.printStatistics(s);
+    BOOST_TEST(s.str().find(std::to_string(objSize) + ": 1001, 0, 1000, ") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
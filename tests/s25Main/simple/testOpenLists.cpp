@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "pathfinding/OpenListBinaryHeap.h"
+#include "pathfinding/OpenListBucketQueue.h"
 #include <rttr/test/random.hpp>
 #include <boost/test/unit_test.hpp>
 #include <algorithm>
@@ -23,6 +24,7 @@ struct ListGetKey
 };
 
 using OpenListBase = OpenListBinaryHeap<ListEl, ListGetKey>;
+using BucketQueue = OpenListBucketQueue<ListEl, ListGetKey>;
 
 class OpenList : public OpenListBase
 {
@@ -179,4 +181,75 @@ BOOST_AUTO_TEST_CASE(RearrangeMakesTheHeapValidAgain)
     BOOST_TEST(list.empty());
 }
 
+BOOST_AUTO_TEST_CASE(BucketQueuePopsLowestElementFirst)
+{
+    BucketQueue list;
+    // Second run checks that the list can be reused
+    for(unsigned run = 0; run < 2; run++)
+    {
+        list.clear();
+        BOOST_TEST_REQUIRE(list.empty());
+
+        // Random vector with some duplicate elements
+        auto elements = getRandomVector(rttr::test::randomValue(30u, 70u), 20);
+        std::multiset<unsigned> keys;
+        for(unsigned i = 0; i < elements.size(); ++i)
+        {
+            list.push(&elements[i]);
+            keys.insert(elements[i].key);
+            BOOST_TEST(list.size() == i + 1u);
+            BOOST_TEST(list.top()->key == *keys.begin());
+        }
+        // Decrease some keys
+        for(auto& el : elements)
+        {
+            if(el.key == 0u || rttr::test::randomBool())
+                continue;
+            keys.erase(keys.find(el.key));
+            el.key = rttr::test::randomValue(0u, el.key - 1u);
+            keys.insert(el.key);
+            list.rearrange(&el);
+            BOOST_TEST(list.top()->key == *keys.begin());
+        }
+        BOOST_TEST(list.size() == elements.size());
+
+        for(unsigned i = 0; i < elements.size(); ++i)
+        {
+            BOOST_TEST_REQUIRE(!list.empty());
+            const auto* el = list.top();
+            const auto* elPop = list.pop();
+            BOOST_TEST(elPop == el);
+            BOOST_TEST(elPop->key == *keys.begin());
+            keys.erase(keys.begin());
+        }
+        BOOST_TEST(list.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BucketQueueReturnsLastAddedOfSameKey)
+{
+    std::vector<ListEl> elements{ListEl(3), ListEl(1), ListEl(3), ListEl(1), ListEl(2), ListEl(3)};
+    BucketQueue list;
+    for(auto& el : elements)
+        list.push(&el);
+    // Decreasing an element adds it after all others with the same key
+    elements[5].key = 1;
+    list.decreasedKey(&elements[5]);
+    const std::vector<const ListEl*> expected{&elements[5], &elements[3], &elements[1],
+                                              &elements[4], &elements[2], &elements[0]};
+    std::vector<const ListEl*> result;
+    while(!list.empty())
+        result.push_back(list.pop());
+    BOOST_TEST(result == expected, boost::test_tools::per_element());
+
+    // Removed elements can be added again, also with a lower key than the last one returned
+    elements[0].key = 0;
+    list.decreasedKey(&elements[0]);
+    list.push(&elements[1]);
+    BOOST_TEST(list.size() == 2u);
+    BOOST_TEST(list.pop() == &elements[0]);
+    BOOST_TEST(list.pop() == &elements[1]);
+    BOOST_TEST(list.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
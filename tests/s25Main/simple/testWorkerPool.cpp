@@ -0,0 +1,59 @@
+// Copyright (C) 2005 - 2025 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "WorkerPool.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(WorkerPoolSuite)
+
+BOOST_AUTO_TEST_CASE(RunsEachTaskOnce)
+{
+    for(const unsigned numThreads : {1u, 2u, 4u, 0u})
+    {
+        WorkerPool pool(numThreads);
+        BOOST_TEST(pool.getNumThreads() >= 1u);
+        // Reuse the pool for multiple runs of different sizes
+        for(const unsigned numTasks : {0u, 1u, 3u, 100u, 7u})
+        {
+            BOOST_TEST_INFO_SCOPE(numThreads << " threads, " << numTasks << " tasks");
+            std::vector<unsigned> numCalls(numTasks, 0);
+            std::atomic<unsigned> totalCalls{0};
+            pool.run(numTasks, [&](unsigned idx) {
+                numCalls[idx]++;
+                totalCalls++;
+            });
+            BOOST_TEST(totalCalls == numTasks);
+            BOOST_TEST(numCalls == std::vector<unsigned>(numTasks, 1u), boost::test_tools::per_element());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RethrowsExceptionOfLowestTask)
+{
+    WorkerPool pool(4);
+    std::atomic<unsigned> totalCalls{0};
+    const auto task = [&totalCalls](unsigned idx) {
+        totalCalls++;
+        if(idx % 3 == 2)
+            throw std::runtime_error(std::to_string(idx));
+    };
+    try
+    {
+        pool.run(10, task);
+        BOOST_TEST_FAIL("Exception expected");
+    } catch(const std::runtime_error& e)
+    {
+        BOOST_TEST(e.what() == std::string("2"));
+    }
+    // All tasks are run even if some fail and the pool stays usable
+    BOOST_TEST(totalCalls == 10u);
+    totalCalls = 0;
+    BOOST_CHECK_NO_THROW(pool.run(2, task));
+    BOOST_TEST(totalCalls == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -64,8 +64,3 @@ const GameEvent* TestEventManager::RescheduleEvent(const GameEvent* event, unsig
     const_cast<GameEvent*>(event)->length = targetGF - event->startGF;
     return AddEventToQueue(event);
 }
-
-std::vector<const GameEvent*> TestEventManager::GetEvents() const
-{
-    return EventManager::GetEvents();
-}
@@ -21,5 +21,4 @@ public:
     bool IsEventActive(const GameObject& obj, unsigned id) const;
     /// Remove the event and add a copy that is executed at the given GF
     const GameEvent* RescheduleEvent(const GameEvent* event, unsigned targetGF);
-    std::vector<const GameEvent*> GetEvents() const;
 };